@@ -0,0 +1,316 @@
+/*
+ * File: ADAcquire.c
+ *
+ * Continuous A/D acquisition rings, see ADAcquire.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "AD.h"
+#include "ADAcquire.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define RING_MASK (AD_RING_SIZE - 1)
+#define ALL_PINS ((1 << AD_NUM_PINS) - 1)
+
+// the slot the writer fills next may be the oldest unread one, so a
+// reader only trusts this many
+#define RING_DEPTH (AD_RING_SIZE - 1)
+
+// core timer ticks, at half the system clock, from one scan to the next
+#define SCAN_TICKS (BOARD_SYS_CLOCK / 2000 / AD_SCANS_PER_MS)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+/* Head counts the samples written and is only written by the scan, Tail
+ * counts the ones read or skipped and is only written by the reader; both
+ * free-run. A sample is copied out first and Head looked at again after, so
+ * a reader that was lapped while copying notices and tries again. */
+typedef struct {
+    uint16_t Samples[AD_RING_SIZE];
+    uint32_t Head;
+    uint32_t Tail;
+    uint32_t Reads;
+    uint32_t Lost;
+} Ring_t;
+
+typedef struct {
+    unsigned int Pins;
+    pPostFunc PostFunc;
+    uint16_t Every;
+    uint16_t Countdown;
+} Subscriber_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static Ring_t *PinRing(unsigned int Pin);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static Ring_t Rings[AD_NUM_PINS];
+static Subscriber_t Subscribers[AD_MAX_SUBSCRIBERS];
+static unsigned int SubscribedPins;
+static ADFilter_t Filters[AD_NUM_PINS];
+static unsigned int FilteredPins;
+static ADScanStats_t ScanStats;
+static uint32_t LastScanAt; // core timer
+static uint32_t ScanPeriods = 1; // the scan periods the next ScanComplete stands for
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t ADAcquire_Subscribe(unsigned int Pins, pPostFunc PostFunc, uint16_t Every,
+        uint16_t Phase)
+{
+    Subscriber_t *pSlot = NULL;
+    unsigned int OtherPins = 0, Rest;
+    uint8_t i;
+
+    if ((Pins == 0) || (Pins & ~ALL_PINS) || (PostFunc == NULL) || (Every == 0)) {
+        return FALSE;
+    }
+    for (i = 0; i < AD_MAX_SUBSCRIBERS; i++) {
+        if (Subscribers[i].PostFunc == PostFunc) {
+            pSlot = &Subscribers[i];
+        } else if (Subscribers[i].PostFunc != NULL) {
+            OtherPins |= Subscribers[i].Pins;
+        } else if (pSlot == NULL) {
+            pSlot = &Subscribers[i];
+        }
+    }
+    if ((pSlot == NULL) || (Pins & OtherPins)) {
+        return FALSE;
+    }
+
+    // start the pins' rings empty; only the reader's index moves
+    for (Rest = Pins; Rest; Rest &= Rest - 1) {
+        i = __builtin_ctz(Rest);
+        Rings[i].Tail = __atomic_load_n(&Rings[i].Head, __ATOMIC_ACQUIRE);
+    }
+    pSlot->Pins = Pins;
+    pSlot->Every = Every;
+    pSlot->Countdown = Phase ? Phase : Every;
+    pSlot->PostFunc = PostFunc;
+    SubscribedPins = OtherPins | Pins;
+
+    AD_AddPins(Pins);
+    return TRUE;
+}
+
+uint8_t ADAcquire_SetFilter(unsigned int Pin, const ADFilter_t *pFilter)
+{
+    unsigned int Subscribed = SubscribedPins;
+    uint8_t i;
+
+    if (PinRing(Pin) == NULL) {
+        return FALSE;
+    }
+    i = __builtin_ctz(Pin);
+    // the scan leaves the pin alone while its filter is half copied
+    __atomic_store_n(&SubscribedPins, Subscribed & ~Pin, __ATOMIC_SEQ_CST);
+    Filters[i] = *pFilter;
+    Filters[i].Primed = FALSE;
+    if (pFilter->Type == AD_FILTER_NONE) {
+        FilteredPins &= ~Pin;
+    } else {
+        FilteredPins |= Pin;
+    }
+    __atomic_store_n(&SubscribedPins, Subscribed, __ATOMIC_SEQ_CST);
+    return TRUE;
+}
+
+uint8_t ADAcquire_Read(unsigned int Pin, uint16_t *pSample)
+{
+    Ring_t *pRing = PinRing(Pin);
+    uint32_t Head, Tail;
+    uint16_t Sample;
+
+    if (pRing == NULL) {
+        return FALSE;
+    }
+    Tail = pRing->Tail;
+    Head = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        if (Head == Tail) {
+            return FALSE;
+        }
+        if ((Head - Tail) > RING_DEPTH) {
+            pRing->Lost += Head - Tail - RING_DEPTH;
+            Tail = Head - RING_DEPTH;
+        }
+        Sample = __atomic_load_n(&pRing->Samples[Tail & RING_MASK], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+        if ((Head - Tail) <= RING_DEPTH) {
+            break;
+        }
+    }
+    __atomic_store_n(&pRing->Tail, Tail + 1, __ATOMIC_RELEASE);
+    pRing->Reads++;
+    *pSample = Sample;
+    return TRUE;
+}
+
+uint8_t ADAcquire_Latest(unsigned int Pin, uint16_t *pSample)
+{
+    Ring_t *pRing = PinRing(Pin);
+    uint32_t Head, Newest;
+    uint16_t Sample;
+
+    if (pRing == NULL) {
+        return FALSE;
+    }
+    Head = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+    if (Head == pRing->Tail) {
+        return FALSE;
+    }
+    do {
+        Newest = Head - 1;
+        Sample = __atomic_load_n(&pRing->Samples[Newest & RING_MASK], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+    } while ((Head - Newest) > RING_DEPTH);
+    __atomic_store_n(&pRing->Tail, Newest + 1, __ATOMIC_RELEASE);
+    pRing->Reads++;
+    *pSample = Sample;
+    return TRUE;
+}
+
+uint16_t ADAcquire_Unread(unsigned int Pin)
+{
+    Ring_t *pRing = PinRing(Pin);
+    uint32_t Unread;
+
+    if (pRing == NULL) {
+        return 0;
+    }
+    Unread = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE) - pRing->Tail;
+    return (Unread > RING_DEPTH) ? RING_DEPTH : Unread;
+}
+
+uint8_t ADAcquire_CheckScan(void)
+{
+    uint16_t Values[AD_NUM_PINS];
+    unsigned int Pins, Rest;
+    uint32_t Now, Gap;
+    uint8_t i;
+
+    if (!AD_IsNewDataReady()) {
+        return FALSE;
+    }
+    Now = _CP0_GET_COUNT();
+    if (ScanStats.Taken) {
+        Gap = Now - LastScanAt;
+        if (Gap > SCAN_TICKS + SCAN_TICKS / 2) {
+            ScanPeriods = (Gap + SCAN_TICKS / 2) / SCAN_TICKS;
+            ScanStats.Missed += ScanPeriods - 1;
+        } else if (Gap < SCAN_TICKS / 2) {
+            ScanStats.Early++;
+        }
+        if (Gap > ScanStats.Longest) {
+            ScanStats.Longest = Gap;
+        }
+    }
+    LastScanAt = Now;
+    ScanStats.Taken++;
+    // a pin added since the scan started has no result in it yet
+    Pins = SubscribedPins & AD_ActivePins();
+    for (Rest = Pins; Rest; Rest &= Rest - 1) {
+        i = __builtin_ctz(Rest);
+        Values[i] = AD_ReadADPin(1 << i);
+    }
+    ADAcquire_ScanComplete(Values, Pins);
+    return TRUE;
+}
+
+void ADAcquire_ScanComplete(const uint16_t *Values, unsigned int Pins)
+{
+    Subscriber_t *pSubscriber;
+    ES_Event ThisEvent;
+    unsigned int Fresh = Pins & SubscribedPins, Rest;
+    uint32_t Head, Periods = ScanPeriods;
+    uint16_t Sample;
+    uint8_t i;
+
+    for (Rest = Fresh; Rest; Rest &= Rest - 1) {
+        i = __builtin_ctz(Rest);
+        Sample = (FilteredPins & (1 << i)) ? ADFilter_Step(&Filters[i], Values[i]) : Values[i];
+        Head = Rings[i].Head;
+        // the new sample may only land after the Head that freed its slot
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&Rings[i].Samples[Head & RING_MASK], Sample, __ATOMIC_RELAXED);
+        __atomic_store_n(&Rings[i].Head, Head + 1, __ATOMIC_RELEASE);
+    }
+
+    // the wakeups count scan periods, missed ones too, so they keep to their
+    // grid: one that comes late brings the next in as much sooner, and only
+    // those a gap of a whole Every swallows are lost
+    ScanPeriods = 1;
+    ThisEvent.EventType = NewADSamples;
+    for (i = 0; i < AD_MAX_SUBSCRIBERS; i++) {
+        pSubscriber = &Subscribers[i];
+        if (!(Fresh & pSubscriber->Pins)) {
+            continue;
+        }
+        if (pSubscriber->Countdown > Periods) {
+            pSubscriber->Countdown -= Periods;
+            continue;
+        }
+        pSubscriber->Countdown = pSubscriber->Every
+                - (Periods - pSubscriber->Countdown) % pSubscriber->Every;
+        ThisEvent.EventParam = Fresh & pSubscriber->Pins;
+        pSubscriber->PostFunc(ThisEvent);
+    }
+}
+
+void ADAcquire_GetStats(unsigned int Pin, ADAcquireStats_t *pStats)
+{
+    Ring_t *pRing = PinRing(Pin);
+
+    if (pRing == NULL) {
+        pStats->Samples = 0;
+        pStats->Reads = 0;
+        pStats->Lost = 0;
+        return;
+    }
+    pStats->Samples = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+    pStats->Reads = pRing->Reads;
+    pStats->Lost = pRing->Lost;
+}
+
+void ADAcquire_GetScanStats(ADScanStats_t *pStats)
+{
+    *pStats = ScanStats;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* the ring of a single pin, or NULL */
+static Ring_t *PinRing(unsigned int Pin)
+{
+    if ((Pin == 0) || (Pin & ~ALL_PINS) || (Pin & (Pin - 1))) {
+        return NULL;
+    }
+    return &Rings[__builtin_ctz(Pin)];
+}
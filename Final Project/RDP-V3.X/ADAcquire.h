@@ -0,0 +1,162 @@
+/*
+ * File: ADAcquire.h
+ *
+ * Continuous A/D acquisition for the sensor services. An event checker,
+ * ADAcquire_CheckScan(), takes each scan the AD library finishes
+ * (AD_IsNewDataReady) and drops every converted sample of a subscribed pin
+ * into that pin's ring, so the services never call AD_ReadADPin() and never
+ * read the same conversion twice. A service subscribes its pins once, in its
+ * init function, and is posted NewADSamples (EventParam = the pins with new
+ * samples) on every Every-th scan, starting on scan Phase; on that event it
+ * takes the samples it wants out of the rings.
+ *
+ * The AD library's own interrupt runs the conversions and gives no hook, so
+ * a scan is only taken when the checker is polled, one pass of the ES loop
+ * after it finished. Anything that looks at the time of a sample sees the
+ * time it was taken, not converted; and a pass longer than a scan loses the
+ * scans that finished in it, as the library keeps only the newest. The
+ * filters count taken scans as AD_SCANS_PER_MS to the ms, so the checker
+ * times each scan on the core timer and counts the scan periods that went by
+ * with none taken (ADAcquire_GetScanStats). The wakeups count those periods
+ * as well as the taken scans, so a late one does not push the rest back: a
+ * subscriber's wakeups stay on the grid of Every scans its Phase set.
+ *
+ * Each ring has one reader, the service subscribed to the pin. The writer
+ * never waits for it: a ring that is not read in time keeps the newest
+ * AD_RING_SIZE - 1 samples and the older ones are counted as lost.
+ *
+ * A pin can have an ADFilter in front of its ring, run on every conversion
+ * as the scan is taken, so its reader only ever sees filtered samples.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef AD_ACQUIRE_H
+#define AD_ACQUIRE_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "ADFilter.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// samples per pin ring, a power of two
+#define AD_RING_SIZE 8
+
+#define AD_MAX_SUBSCRIBERS 4
+
+// conversion scans per ms, so a service can ask for a period in ms
+#define AD_SCANS_PER_MS 1
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Samples; // converted into the ring
+    uint32_t Reads; // taken out by ADAcquire_Read or ADAcquire_Latest
+    uint32_t Lost; // overwritten before ADAcquire_Read got to them
+} ADAcquireStats_t;
+
+typedef struct {
+    uint32_t Taken; // scans ADAcquire_CheckScan() took
+    uint32_t Missed; // scan periods with no scan taken, from gaps over 1.5
+    uint32_t Early; // scans taken under half a scan period after the last
+    uint32_t Longest; // core timer ticks, longest gap between two scans
+} ADScanStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ADAcquire_Subscribe(unsigned int Pins, pPostFunc PostFunc,
+ *           uint16_t Every, uint16_t Phase)
+ * @param Pins - OR'd list of AD_PORTxx pins to acquire
+ * @param PostFunc - where NewADSamples is posted
+ * @param Every - scans between wakeups
+ * @param Phase - scans to the first wakeup, or 0 for Every
+ * @return TRUE, or FALSE if a pin belongs to another subscriber, Every is
+ *         0 or every subscriber slot is taken
+ * @brief Enables the pins on the converter and starts filling their rings.
+ *        Subscribing PostFunc again replaces its old subscription and drops
+ *        its unread samples, so a service can simply re-run its init. */
+uint8_t ADAcquire_Subscribe(unsigned int Pins, pPostFunc PostFunc, uint16_t Every,
+        uint16_t Phase);
+
+/**
+ * @Function ADAcquire_SetFilter(unsigned int Pin, const ADFilter_t *pFilter)
+ * @param Pin - a single AD_PORTxx pin
+ * @param pFilter - an initialized filter, copied, starting from the pin's
+ *        next conversion
+ * @return TRUE, or FALSE if Pin is not a single pin
+ * @brief Conversions of the pin that land while the filter is being copied
+ *        are dropped. An AD_FILTER_NONE filter takes the pin's filter off. */
+uint8_t ADAcquire_SetFilter(unsigned int Pin, const ADFilter_t *pFilter);
+
+/**
+ * @Function ADAcquire_Read(unsigned int Pin, uint16_t *pSample)
+ * @param Pin - a single subscribed AD_PORTxx pin
+ * @param pSample - set to the oldest unread sample
+ * @return TRUE, or FALSE if there is no unread sample
+ * @brief For a service that wants every conversion, in order. */
+uint8_t ADAcquire_Read(unsigned int Pin, uint16_t *pSample);
+
+/**
+ * @Function ADAcquire_Latest(unsigned int Pin, uint16_t *pSample)
+ * @param Pin - a single subscribed AD_PORTxx pin
+ * @param pSample - set to the newest sample
+ * @return TRUE, or FALSE with *pSample untouched if nothing was converted
+ *         since the last read
+ * @brief Takes the newest sample and marks the older unread ones as read. */
+uint8_t ADAcquire_Latest(unsigned int Pin, uint16_t *pSample);
+
+/**
+ * @Function ADAcquire_Unread(unsigned int Pin)
+ * @param Pin - a single AD_PORTxx pin
+ * @return samples waiting in the pin's ring, at most AD_RING_SIZE - 1 */
+uint16_t ADAcquire_Unread(unsigned int Pin);
+
+/**
+ * @Function ADAcquire_CheckScan(void)
+ * @param None
+ * @return TRUE if the AD library had a new scan, which was taken
+ * @brief The event checker; put it in EVENT_CHECK_LIST. Reads each
+ *        subscribed pin of a finished scan once with AD_ReadADPin() and
+ *        hands the results to ADAcquire_ScanComplete(). */
+uint8_t ADAcquire_CheckScan(void);
+
+/**
+ * @Function ADAcquire_ScanComplete(const uint16_t *Values, unsigned int Pins)
+ * @param Values - the scan's results, indexed by pin number (AD_PORTV3 is 0)
+ * @param Pins - OR'd list of the pins converted in this scan
+ * @return None
+ * @brief Fills the rings and posts the wakeups that fall due on this scan,
+ *        counting the scan periods ADAcquire_CheckScan() found missed
+ *        before it. ADAcquire_CheckScan() calls it; tests can feed it
+ *        directly, one scan period a call. */
+void ADAcquire_ScanComplete(const uint16_t *Values, unsigned int Pins);
+
+/**
+ * @Function ADAcquire_GetStats(unsigned int Pin, ADAcquireStats_t *pStats)
+ * @param Pin - a single AD_PORTxx pin
+ * @param pStats - filled with the pin's counters since power-up
+ * @return None */
+void ADAcquire_GetStats(unsigned int Pin, ADAcquireStats_t *pStats);
+
+/**
+ * @Function ADAcquire_GetScanStats(ADScanStats_t *pStats)
+ * @param pStats - filled with the checker's pacing since power-up
+ * @return None
+ * @brief Missed scans slow every filter and the beacon detector down by
+ *        Missed / (Taken + Missed); early ones mean the library scans faster
+ *        than AD_SCANS_PER_MS. Both are 0 while the assumed rate holds. */
+void ADAcquire_GetScanStats(ADScanStats_t *pStats);
+
+#endif /* AD_ACQUIRE_H */
@@ -0,0 +1,140 @@
+/*
+ * File: ADFilter.c
+ *
+ * Integer A/D filters, see ADFilter.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADFilter.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define HISTORY_MASK (AD_FILTER_MAX_TAPS - 1)
+
+// fraction bits of the IIR state; a 10-bit sample leaves 5 bits of headroom
+#define IIR_SHIFT 16
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void Prime(ADFilter_t *pFilter, uint16_t Sample);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void ADFilter_InitNone(ADFilter_t *pFilter)
+{
+    pFilter->Type = AD_FILTER_NONE;
+    pFilter->Length = 1;
+    pFilter->Shift = 0;
+    pFilter->Alpha = 0;
+    pFilter->Taps = NULL;
+    pFilter->Primed = FALSE;
+}
+
+int8_t ADFilter_InitIIR(ADFilter_t *pFilter, int16_t Alpha)
+{
+    if (Alpha <= 0) {
+        return ERROR;
+    }
+    ADFilter_InitNone(pFilter);
+    pFilter->Type = AD_FILTER_IIR;
+    pFilter->Alpha = Alpha;
+    return SUCCESS;
+}
+
+int8_t ADFilter_InitAverage(ADFilter_t *pFilter, uint8_t Length)
+{
+    if ((Length == 0) || (Length > AD_FILTER_MAX_TAPS) || (Length & (Length - 1))) {
+        return ERROR;
+    }
+    ADFilter_InitNone(pFilter);
+    pFilter->Type = AD_FILTER_AVERAGE;
+    pFilter->Length = Length;
+    pFilter->Shift = __builtin_ctz(Length);
+    return SUCCESS;
+}
+
+int8_t ADFilter_InitFIR(ADFilter_t *pFilter, const int16_t *Taps, uint8_t Length)
+{
+    if ((Taps == NULL) || (Length == 0) || (Length > AD_FILTER_MAX_TAPS)) {
+        return ERROR;
+    }
+    ADFilter_InitNone(pFilter);
+    pFilter->Type = AD_FILTER_FIR;
+    pFilter->Length = Length;
+    pFilter->Taps = Taps;
+    return SUCCESS;
+}
+
+uint16_t ADFilter_Step(ADFilter_t *pFilter, uint16_t Sample)
+{
+    int32_t Sum;
+    uint8_t Index, i;
+
+    if (!pFilter->Primed) {
+        Prime(pFilter, Sample);
+    }
+    switch (pFilter->Type) {
+    case AD_FILTER_IIR:
+        // one 32x16 multiply, which the PIC32 does in a single MULT
+        pFilter->State += (int32_t) (((int64_t) (((int32_t) Sample << IIR_SHIFT)
+                - pFilter->State) * pFilter->Alpha) >> 15);
+        return (pFilter->State + (1 << (IIR_SHIFT - 1))) >> IIR_SHIFT;
+
+    case AD_FILTER_AVERAGE:
+        // the sample leaving the window is the one Length slots back
+        Index = pFilter->Index;
+        pFilter->State += Sample - pFilter->History[(Index - pFilter->Length) & HISTORY_MASK];
+        pFilter->History[Index] = Sample;
+        pFilter->Index = (Index + 1) & HISTORY_MASK;
+        return (pFilter->State + (pFilter->Length >> 1)) >> pFilter->Shift;
+
+    case AD_FILTER_FIR:
+        Index = pFilter->Index;
+        pFilter->History[Index] = Sample;
+        pFilter->Index = (Index + 1) & HISTORY_MASK;
+        Sum = 1 << 14;
+        for (i = 0; i < pFilter->Length; i++) {
+            Sum += pFilter->Taps[i] * (int32_t) pFilter->History[(Index - i) & HISTORY_MASK];
+        }
+        Sum >>= 15;
+        return (Sum < 0) ? 0 : (Sum > AD_MAX_VALUE) ? AD_MAX_VALUE : Sum;
+
+    default:
+        return Sample;
+    }
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* as if the filter had seen nothing but Sample forever */
+static void Prime(ADFilter_t *pFilter, uint16_t Sample)
+{
+    uint8_t i;
+
+    for (i = 0; i < AD_FILTER_MAX_TAPS; i++) {
+        pFilter->History[i] = Sample;
+    }
+    pFilter->Index = 0;
+    if (pFilter->Type == AD_FILTER_IIR) {
+        pFilter->State = (int32_t) Sample << IIR_SHIFT;
+    } else {
+        pFilter->State = (int32_t) Sample << pFilter->Shift;
+    }
+    pFilter->Primed = TRUE;
+}
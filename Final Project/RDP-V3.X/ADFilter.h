@@ -0,0 +1,107 @@
+/*
+ * File: ADFilter.h
+ *
+ * Integer filters for A/D samples, cheap enough to run on every conversion
+ * as ADAcquire takes each scan (the PIC32 has no FPU). Coefficients are Q15, 32768
+ * being 1.0. Each filter is one of:
+ *
+ *   none     the sample as converted
+ *   IIR      first-order low pass, y += Alpha * (x - y)
+ *   average  moving average over a power-of-two window
+ *   FIR      up to AD_FILTER_MAX_TAPS taps
+ *
+ * A filter takes its first sample as its steady state, so a channel does not
+ * ramp up from zero after it is set up. ADAcquire_SetFilter() puts one in
+ * front of a pin's ring.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef AD_FILTER_H
+#define AD_FILTER_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// history kept per filter, a power of two
+#define AD_FILTER_MAX_TAPS 16
+
+#define Q15(x) ((int16_t) ((x) * 32768.0 + 0.5))
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef enum {
+    AD_FILTER_NONE,
+    AD_FILTER_IIR,
+    AD_FILTER_AVERAGE,
+    AD_FILTER_FIR,
+} ADFilterType_t;
+
+typedef struct {
+    uint8_t Type; // an ADFilterType_t
+    uint8_t Length; // FIR taps or average window
+    uint8_t Shift; // log2 of the average window
+    uint8_t Primed; // a sample has been through
+    int16_t Alpha; // IIR coefficient, Q15
+    const int16_t *Taps; // FIR taps, Q15, newest sample first
+    int32_t State; // IIR output << 16, or the average's running sum
+    uint8_t Index; // next History slot
+    uint16_t History[AD_FILTER_MAX_TAPS];
+} ADFilter_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ADFilter_InitNone(ADFilter_t *pFilter)
+ * @param pFilter - filter to set up
+ * @return None
+ * @brief Passes samples straight through. */
+void ADFilter_InitNone(ADFilter_t *pFilter);
+
+/**
+ * @Function ADFilter_InitIIR(ADFilter_t *pFilter, int16_t Alpha)
+ * @param pFilter - filter to set up
+ * @param Alpha - Q15 weight of the new sample, above 0
+ * @return SUCCESS or ERROR
+ * @brief First-order low pass; Alpha = 1 - exp(-2 pi fc / fs) puts the
+ *        corner at fc. */
+int8_t ADFilter_InitIIR(ADFilter_t *pFilter, int16_t Alpha);
+
+/**
+ * @Function ADFilter_InitAverage(ADFilter_t *pFilter, uint8_t Length)
+ * @param pFilter - filter to set up
+ * @param Length - window in samples, a power of two up to AD_FILTER_MAX_TAPS
+ * @return SUCCESS or ERROR */
+int8_t ADFilter_InitAverage(ADFilter_t *pFilter, uint8_t Length);
+
+/**
+ * @Function ADFilter_InitFIR(ADFilter_t *pFilter, const int16_t *Taps, uint8_t Length)
+ * @param pFilter - filter to set up
+ * @param Taps - Q15 taps, newest sample first; kept by reference, so they
+ *        must outlive the filter. Taps summing to more than 1.0 can overflow
+ *        the output, which is clamped to 0 and AD_MAX_VALUE.
+ * @param Length - number of taps, 1 to AD_FILTER_MAX_TAPS
+ * @return SUCCESS or ERROR */
+int8_t ADFilter_InitFIR(ADFilter_t *pFilter, const int16_t *Taps, uint8_t Length);
+
+/**
+ * @Function ADFilter_Step(ADFilter_t *pFilter, uint16_t Sample)
+ * @param pFilter - an initialized filter
+ * @param Sample - the new conversion
+ * @return the filtered value, rounded to the nearest count
+ * @brief One step per scan: a filter's corner is in scans, so it holds at
+ *        AD_SCANS_PER_MS only while no scans are missed. */
+uint16_t ADFilter_Step(ADFilter_t *pFilter, uint16_t Sample);
+
+#endif /* AD_FILTER_H */
@@ -0,0 +1,89 @@
+/*
+ * File: Actuators.c
+ *
+ * Motor output shadow, see Actuators.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "Actuators.h"
+#include "Odometry.h"
+#include "Robot.h"
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// the speeds last sent to the robot library
+static int8_t LeftSpeed;
+static int8_t RightSpeed;
+static int8_t CannonSpeed;
+
+static ActuatorStats_t Stats;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void Actuators_Init(void)
+{
+    LeftSpeed = RightSpeed = CannonSpeed = 0;
+    Robot_LeftMtrSpeed(0);
+    Robot_RightMtrSpeed(0);
+    CannonMtrSpeed(0);
+    Stats.Commands = 0;
+    Stats.Calls = 0;
+}
+
+char Actuators_Drive(int8_t Left, int8_t Right)
+{
+    char Result = SUCCESS;
+
+    Stats.Commands += 2;
+    if ((Left == LeftSpeed) && (Right == RightSpeed)) {
+        return SUCCESS;
+    }
+    if (Left != LeftSpeed) {
+        Stats.Calls++;
+        Result = Robot_LeftMtrSpeed(Left);
+    }
+    if ((Result == SUCCESS) && (Right != RightSpeed)) {
+        Stats.Calls++;
+        Result = Robot_RightMtrSpeed(Right);
+        if ((Result == ERROR) && (Left != LeftSpeed)) {
+            // put the left motor back so the shadow still holds
+            Stats.Calls++;
+            Robot_LeftMtrSpeed(LeftSpeed);
+        }
+    }
+    if (Result == SUCCESS) {
+        LeftSpeed = Left;
+        RightSpeed = Right;
+        Odometry_Drive(Left, Right);
+    }
+    return Result;
+}
+
+char Actuators_Cannon(int8_t Speed)
+{
+    Stats.Commands++;
+    if (Speed == CannonSpeed) {
+        return SUCCESS;
+    }
+    Stats.Calls++;
+    if (CannonMtrSpeed(Speed) == ERROR) {
+        return ERROR;
+    }
+    CannonSpeed = Speed;
+    return SUCCESS;
+}
+
+void Actuators_GetStats(ActuatorStats_t *pStats)
+{
+    *pStats = Stats;
+}
@@ -0,0 +1,72 @@
+/*
+ * File: Actuators.h
+ *
+ * Shadow of the robot's motor outputs. Motion sets the drive motors, and the
+ * state machines and the Sequencer the cannon, through here rather than
+ * through the robot library; the last speed given to each motor is kept and
+ * the library is only called for a motor whose speed changes, so a state
+ * entered again with the speeds it already has, or a script step that
+ * repeats the last, costs no register writes. The new drive speeds are
+ * passed on to Odometry, which dead reckons from them.
+ *
+ * The saving is small. Motion ramps the wheels to every new speed a step at
+ * a time, and nearly every step is a new speed, so nearly every drive call
+ * is a real change. bench_actuators finds 2% fewer writes on the field and
+ * 11% with RobotHSM's events coming every 20 ms.
+ *
+ * Nothing else may call the motor functions of the robot library once
+ * Actuators_Init() has run, or the shadow no longer matches the motors.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ACTUATORS_H
+#define ACTUATORS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Commands; // motor speeds asked for, one for each motor named
+    uint32_t Calls; // robot library motor calls made for them
+} ActuatorStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Actuators_Init(void)
+ * @param None
+ * @return None
+ * @brief Stops every motor through the robot library, whatever the shadow
+ *        held, and clears the counters. Called from InitRobotHSM(). */
+void Actuators_Init(void);
+
+/**
+ * @Function Actuators_Drive(int8_t Left, int8_t Right)
+ * @param Left - left drive motor speed, -100 to 100
+ * @param Right - right drive motor speed, -100 to 100
+ * @return SUCCESS or ERROR, in which case neither motor is changed */
+char Actuators_Drive(int8_t Left, int8_t Right);
+
+/**
+ * @Function Actuators_Cannon(int8_t Speed)
+ * @param Speed - cannon motor speed, 0 to 100
+ * @return SUCCESS or ERROR */
+char Actuators_Cannon(int8_t Speed);
+
+/**
+ * @Function Actuators_GetStats(ActuatorStats_t *pStats)
+ * @param pStats - filled with the counters since Actuators_Init()
+ * @return None */
+void Actuators_GetStats(ActuatorStats_t *pStats);
+
+#endif /* ACTUATORS_H */
@@ -0,0 +1,131 @@
+/*
+ * File: BumperNotify.c
+ *
+ * Change notification and INT4 interrupts on the front bumpers, see
+ * BumperNotify.h.
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include <sys/attribs.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Robot.h"
+#include "BumperNotify.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// between the ADC's 1 and the ES timer's 3, so the ms tick is never held
+// back by an edge; the handlers' IPL2AUTO has to match
+#define BUMPER_IPL 2
+
+#define FRONT_RIGHT_PIN _PORTD_RD11_MASK // INT4
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void Latch(unsigned char Port);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static BumperNotifyHook_t Hook;
+
+// written by the interrupts only, read with them held off
+static volatile unsigned char LatchedPort;
+static volatile uint32_t LatchedAt; // ms
+static volatile uint8_t Latched;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void BumperNotify_Init(BumperNotifyHook_t NewHook)
+{
+    IEC1CLR = _IEC1_CNIE_MASK;
+    IEC0CLR = _IEC0_INT4IE_MASK;
+    Hook = NewHook;
+    Latched = FALSE;
+
+    // CN14 on RD5, with the mismatch latched by reading the port
+    CNCONSET = _CNCON_ON_MASK;
+    CNENSET = _CNEN_CNEN14_MASK;
+    (void) PORTD;
+    IPC6bits.CNIP = BUMPER_IPL;
+    IPC6bits.CNIS = 0;
+    IFS1CLR = _IFS1_CNIF_MASK;
+    IEC1SET = _IEC1_CNIE_MASK;
+
+    // INT4 on RD11, waiting for the edge away from where the pin is now
+    INTCONbits.INT4EP = (PORTD & FRONT_RIGHT_PIN) ? 0 : 1;
+    IPC4bits.INT4IP = BUMPER_IPL;
+    IPC4bits.INT4IS = 0;
+    IFS0CLR = _IFS0_INT4IF_MASK;
+    IEC0SET = _IEC0_INT4IE_MASK;
+}
+
+uint8_t BumperNotify_CheckEdge(void)
+{
+    unsigned char Port;
+    uint32_t At;
+
+    if (!Latched) {
+        return FALSE;
+    }
+    // an edge while the bumper interrupts are off leaves its flag set, and
+    // is taken as soon as they are back on
+    IEC1CLR = _IEC1_CNIE_MASK;
+    IEC0CLR = _IEC0_INT4IE_MASK;
+    Port = LatchedPort;
+    At = LatchedAt;
+    Latched = FALSE;
+    IEC1SET = _IEC1_CNIE_MASK;
+    IEC0SET = _IEC0_INT4IE_MASK;
+    Hook(Port, At);
+    return TRUE;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* from either interrupt */
+static void Latch(unsigned char Port)
+{
+    LatchedPort = Port;
+    LatchedAt = ES_Timer_GetTime();
+    Latched = TRUE;
+}
+
+/*******************************************************************************
+ * INTERRUPT SERVICE ROUTINES                                                  *
+ ******************************************************************************/
+
+void __ISR(_CHANGE_NOTICE_VECTOR, IPL2AUTO) BumperCNHandler(void)
+{
+    // reading the port ends the mismatch, so the flag can be cleared after
+    unsigned char Port = Robot_ReadBumpers();
+
+    IFS1CLR = _IFS1_CNIF_MASK;
+    Latch(Port);
+}
+
+void __ISR(_EXTERNAL_4_VECTOR, IPL2AUTO) BumperINT4Handler(void)
+{
+    unsigned char Port;
+
+    IFS0CLR = _IFS0_INT4IF_MASK;
+    INTCONbits.INT4EP = !INTCONbits.INT4EP;
+    Port = Robot_ReadBumpers();
+    Latch(Port);
+}
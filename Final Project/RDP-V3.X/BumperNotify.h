@@ -0,0 +1,63 @@
+/*
+ * File: BumperNotify.h
+ *
+ * Bumper edges by interrupt. Of the three bumper inputs only two can raise
+ * one on the PIC32MX320: the front left bumper is on RD5, which is CN14 of
+ * the change notification, and the front right on RD11, which is INT4. The
+ * side bumper is on RD3, an output compare pin with neither, and is only
+ * ever polled. Either interrupt only latches the whole bumper port, as
+ * Robot_ReadBumpers() returns it, with the ms of the edge; the event
+ * checker BumperNotify_CheckEdge() hands the latch to the hook from the
+ * main loop, so the hook can post to the ES queues. Edges that come in
+ * between two checks are handed on as one, the newest.
+ *
+ * CN14 interrupts on both edges. INT4 only has one, so it is turned around
+ * at every edge to wait for the other; an edge that comes back before it is
+ * turned is not seen, and whatever polls the bumpers has to pick it up.
+ *
+ * Created on 18/Oct/2026
+ */
+
+#ifndef BUMPER_NOTIFY_H
+#define BUMPER_NOTIFY_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "Robot.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// the bumpers that interrupt; the rest have to be polled
+#define BUMPER_NOTIFY_PINS (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER)
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef void (*BumperNotifyHook_t)(unsigned char Bumpers, uint32_t Ms);
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function BumperNotify_Init(BumperNotifyHook_t Hook)
+ * @param Hook - called from BumperNotify_CheckEdge() with the bumper port
+ *        and ES_Timer_GetTime() of the newest edge of a BUMPER_NOTIFY_PINS
+ *        bumper
+ * @return None
+ * @brief Call after Robot_Init(), which makes the bumper pins inputs. */
+void BumperNotify_Init(BumperNotifyHook_t Hook);
+
+/**
+ * @Function BumperNotify_CheckEdge(void)
+ * @param None
+ * @return TRUE if an edge was latched, which was handed to the hook
+ * @brief The event checker; put it in EVENT_CHECK_LIST. */
+uint8_t BumperNotify_CheckEdge(void);
+
+#endif /* BUMPER_NOTIFY_H */
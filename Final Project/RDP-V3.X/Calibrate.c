@@ -0,0 +1,122 @@
+/*
+ * File: Calibrate.c
+ *
+ * Running input statistics for threshold calibration, see Calibrate.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "Calibrate.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define ONE (1l << CALIBRATE_FRACTION_BITS)
+#define ROUND(Value) (((Value) + ONE / 2) >> CALIBRATE_FRACTION_BITS)
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static int32_t Sigma(const Calibration_t *pCalibration);
+static uint32_t SquareRoot(uint64_t Value);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int8_t Calibrate_Init(Calibration_t *pCalibration, uint16_t Window)
+{
+    if (Window == 0) {
+        return ERROR;
+    }
+    pCalibration->Mean = 0;
+    pCalibration->M2 = 0;
+    pCalibration->Count = 0;
+    pCalibration->Window = Window;
+    return SUCCESS;
+}
+
+void Calibrate_Add(Calibration_t *pCalibration, uint16_t Sample)
+{
+    int32_t Value = (int32_t) Sample << CALIBRATE_FRACTION_BITS;
+    int32_t Delta = Value - pCalibration->Mean;
+
+    if (pCalibration->Count < pCalibration->Window) {
+        pCalibration->Count++;
+    }
+    // rounded, or a mean held at the window would stop up to a count short
+    pCalibration->Mean += (Delta + ((Delta < 0) ? -pCalibration->Count : pCalibration->Count) / 2)
+            / pCalibration->Count;
+    pCalibration->M2 += (int64_t) Delta * (Value - pCalibration->Mean);
+    // with the count held at the window the same update, scaled by
+    // 1 - 1/Window, is an exponentially weighted variance
+    if (pCalibration->Count == pCalibration->Window) {
+        pCalibration->M2 -= pCalibration->M2 / pCalibration->Window;
+    }
+}
+
+uint16_t Calibrate_Count(const Calibration_t *pCalibration)
+{
+    return pCalibration->Count;
+}
+
+uint16_t Calibrate_Mean(const Calibration_t *pCalibration)
+{
+    return ROUND(pCalibration->Mean);
+}
+
+uint16_t Calibrate_Sigma(const Calibration_t *pCalibration)
+{
+    return ROUND(Sigma(pCalibration));
+}
+
+uint16_t Calibrate_Threshold(const Calibration_t *pCalibration, uint8_t Sigmas,
+        uint16_t MinMargin, uint8_t Below)
+{
+    int64_t Margin = (int64_t) Sigmas * Sigma(pCalibration), Threshold;
+
+    if (Margin < ((int64_t) MinMargin << CALIBRATE_FRACTION_BITS)) {
+        Margin = (int64_t) MinMargin << CALIBRATE_FRACTION_BITS;
+    }
+    Threshold = ROUND(Below ? pCalibration->Mean - Margin : pCalibration->Mean + Margin);
+    return (Threshold < 0) ? 0 : (Threshold > UINT16_MAX) ? UINT16_MAX : Threshold;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* standard deviation with CALIBRATE_FRACTION_BITS fraction bits */
+static int32_t Sigma(const Calibration_t *pCalibration)
+{
+    if ((pCalibration->Count == 0) || (pCalibration->M2 <= 0)) {
+        return 0;
+    }
+    return SquareRoot(pCalibration->M2 / pCalibration->Count);
+}
+
+static uint32_t SquareRoot(uint64_t Value)
+{
+    uint64_t Root = 0, Bit = 1ull << 62;
+
+    while (Bit > Value) {
+        Bit >>= 2;
+    }
+    while (Bit) {
+        if (Value >= Root + Bit) {
+            Value -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        } else {
+            Root >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return (uint32_t) Root;
+}
@@ -0,0 +1,93 @@
+/*
+ * File: Calibrate.h
+ *
+ * Running mean and standard deviation of one input, for learning a sensor
+ * threshold from what the sensor reads instead of fixing it in a #define.
+ * Samples go in one at a time (Welford's method, in integers), and the
+ * threshold comes out a number of standard deviations from the mean.
+ *
+ * Until the calibration has seen Window samples every sample counts the
+ * same, so a startup run gives the mean and deviation of all of it. After
+ * that each sample counts 1/Window and the older ones fade out, so the
+ * statistics follow a baseline that drifts.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef CALIBRATE_H
+#define CALIBRATE_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define CALIBRATE_FRACTION_BITS 12
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    int32_t Mean; // input counts, CALIBRATE_FRACTION_BITS fraction bits
+    int64_t M2; // sum of squared differences from the mean, twice the fraction bits
+    uint16_t Count; // samples in the statistics, up to Window
+    uint16_t Window;
+} Calibration_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Calibrate_Init(Calibration_t *pCalibration, uint16_t Window)
+ * @param pCalibration - calibration to set up
+ * @param Window - samples before older samples start to fade out
+ * @return SUCCESS, or ERROR if Window is 0
+ * @brief Starts the calibration with no samples. */
+int8_t Calibrate_Init(Calibration_t *pCalibration, uint16_t Window);
+
+/**
+ * @Function Calibrate_Add(Calibration_t *pCalibration, uint16_t Sample)
+ * @param pCalibration - an initialized calibration
+ * @param Sample - one reading of the input
+ * @return None. */
+void Calibrate_Add(Calibration_t *pCalibration, uint16_t Sample);
+
+/**
+ * @Function Calibrate_Count(const Calibration_t *pCalibration)
+ * @param pCalibration - an initialized calibration
+ * @return samples in the statistics, which stops at the Window */
+uint16_t Calibrate_Count(const Calibration_t *pCalibration);
+
+/**
+ * @Function Calibrate_Mean(const Calibration_t *pCalibration)
+ * @param pCalibration - an initialized calibration
+ * @return mean of the samples, rounded to input counts */
+uint16_t Calibrate_Mean(const Calibration_t *pCalibration);
+
+/**
+ * @Function Calibrate_Sigma(const Calibration_t *pCalibration)
+ * @param pCalibration - an initialized calibration
+ * @return standard deviation of the samples, rounded to input counts */
+uint16_t Calibrate_Sigma(const Calibration_t *pCalibration);
+
+/**
+ * @Function Calibrate_Threshold(const Calibration_t *pCalibration, uint8_t Sigmas,
+ *           uint16_t MinMargin, uint8_t Below)
+ * @param pCalibration - an initialized calibration
+ * @param Sigmas - standard deviations between the mean and the threshold
+ * @param MinMargin - the threshold is at least this many counts from the mean
+ * @param Below - TRUE for a threshold under the mean, FALSE for one over it
+ * @return the threshold in input counts, held to 0 to UINT16_MAX
+ * @brief For a channel whose samples are its inactive readings, Below is the
+ *        channel's ActiveLow. */
+uint16_t Calibrate_Threshold(const Calibration_t *pCalibration, uint8_t Sigmas,
+        uint16_t MinMargin, uint8_t Below);
+
+#endif /* CALIBRATE_H */
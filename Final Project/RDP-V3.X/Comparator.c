@@ -0,0 +1,83 @@
+/*
+ * File: Comparator.c
+ *
+ * Bank of hysteresis comparators, see Comparator.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "Comparator.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define MID_SCALE 512
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int8_t Comparator_Init(ComparatorBank_t *pBank, uint8_t NumChannels)
+{
+    uint8_t i;
+
+    if (NumChannels > COMPARATOR_MAX_CHANNELS) {
+        return ERROR;
+    }
+    for (i = 0; i < COMPARATOR_MAX_CHANNELS; i++) {
+        pBank->Rise[i] = MID_SCALE;
+        pBank->Fall[i] = MID_SCALE;
+    }
+    pBank->ActiveLow = 0;
+    pBank->High = 0;
+    pBank->NumChannels = NumChannels;
+    return SUCCESS;
+}
+
+int8_t Comparator_SetChannel(ComparatorBank_t *pBank, uint8_t Channel, uint16_t Threshold,
+        uint16_t Hysteresis, uint8_t ActiveLow)
+{
+    uint8_t Bit = 1 << Channel;
+
+    if (Channel >= pBank->NumChannels) {
+        return ERROR;
+    }
+    pBank->Rise[Channel] = (Threshold > UINT16_MAX - Hysteresis) ? UINT16_MAX
+            : Threshold + Hysteresis;
+    pBank->Fall[Channel] = (Threshold < Hysteresis) ? 0 : Threshold - Hysteresis;
+    // inactive: an active-low channel starts on the high side
+    if (ActiveLow) {
+        pBank->ActiveLow |= Bit;
+        pBank->High |= Bit;
+    } else {
+        pBank->ActiveLow &= ~Bit;
+        pBank->High &= ~Bit;
+    }
+    return SUCCESS;
+}
+
+uint8_t Comparator_Update(ComparatorBank_t *pBank, const uint16_t *Inputs)
+{
+    uint8_t Above = 0, Below = 0, Last = pBank->High;
+    uint8_t i;
+
+    // the compares come out as 0 or 1 (sltu on the PIC32), not as branches
+    for (i = 0; i < pBank->NumChannels; i++) {
+        Above |= (uint8_t) (Inputs[i] > pBank->Rise[i]) << i;
+        Below |= (uint8_t) (Inputs[i] < pBank->Fall[i]) << i;
+    }
+    // inside the band a channel keeps its side
+    pBank->High = Above | (Last & ~Below);
+    return pBank->High ^ Last;
+}
+
+uint8_t Comparator_Active(const ComparatorBank_t *pBank)
+{
+    return pBank->High ^ pBank->ActiveLow;
+}
@@ -0,0 +1,84 @@
+/*
+ * File: Comparator.h
+ *
+ * Bank of hysteresis comparators for the analog sensors. Each channel has a
+ * band around its threshold: the input has to rise above the top of the band
+ * to switch the channel's high side on and fall below the bottom to switch it
+ * off, so a reading wandering about the threshold gives one edge instead of a
+ * burst of them. A channel can be active-high or active-low.
+ *
+ * The bank is kept as parallel arrays with the channel states packed into
+ * one byte, and Comparator_Update() runs every channel in one pass with no
+ * branches on the inputs, handing back the channels that changed as a mask.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef COMPARATOR_H
+#define COMPARATOR_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define COMPARATOR_MAX_CHANNELS 8
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint16_t Rise[COMPARATOR_MAX_CHANNELS]; // an input above this is high
+    uint16_t Fall[COMPARATOR_MAX_CHANNELS]; // an input below this is low
+    uint8_t ActiveLow; // channels that are active while their input is low
+    uint8_t High; // channels whose input last left the band upwards
+    uint8_t NumChannels;
+} ComparatorBank_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Comparator_Init(ComparatorBank_t *pBank, uint8_t NumChannels)
+ * @param pBank - bank to set up
+ * @param NumChannels - channels 0 to NumChannels - 1 will be used
+ * @return SUCCESS, or ERROR if NumChannels is over COMPARATOR_MAX_CHANNELS
+ * @brief Every channel starts active-high with an empty band at mid-scale
+ *        and inactive; set each one up with Comparator_SetChannel(). */
+int8_t Comparator_Init(ComparatorBank_t *pBank, uint8_t NumChannels);
+
+/**
+ * @Function Comparator_SetChannel(ComparatorBank_t *pBank, uint8_t Channel,
+ *           uint16_t Threshold, uint16_t Hysteresis, uint8_t ActiveLow)
+ * @param pBank - an initialized bank
+ * @param Channel - channel number, below the bank's NumChannels
+ * @param Threshold - middle of the band, in input counts
+ * @param Hysteresis - half the width of the band, in input counts
+ * @param ActiveLow - TRUE if the channel is active below the band
+ * @return SUCCESS or ERROR
+ * @brief Sets the channel's band and polarity and makes it inactive. */
+int8_t Comparator_SetChannel(ComparatorBank_t *pBank, uint8_t Channel, uint16_t Threshold,
+        uint16_t Hysteresis, uint8_t ActiveLow);
+
+/**
+ * @Function Comparator_Update(ComparatorBank_t *pBank, const uint16_t *Inputs)
+ * @param pBank - an initialized bank
+ * @param Inputs - one reading per channel, indexed by channel number
+ * @return mask of the channels that switched, bit n for channel n
+ * @brief Runs every channel of the bank against its reading. */
+uint8_t Comparator_Update(ComparatorBank_t *pBank, const uint16_t *Inputs);
+
+/**
+ * @Function Comparator_Active(const ComparatorBank_t *pBank)
+ * @param pBank - an initialized bank
+ * @return mask of the channels that are active, bit n for channel n */
+uint8_t Comparator_Active(const ComparatorBank_t *pBank);
+
+#endif /* COMPARATOR_H */
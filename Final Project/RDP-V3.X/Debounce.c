@@ -0,0 +1,47 @@
+/*
+ * File: Debounce.c
+ *
+ * Vertical-counter debouncer, see Debounce.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "Debounce.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void Debounce_Init(Debouncer_t *pDebouncer, uint8_t Initial)
+{
+    pDebouncer->State = Initial;
+    pDebouncer->Count0 = 0xFF;
+    pDebouncer->Count1 = 0xFF;
+}
+
+DebounceEdges_t Debounce_Update(Debouncer_t *pDebouncer, uint8_t Sample)
+{
+    DebounceEdges_t Edges;
+    uint8_t Differ = Sample ^ pDebouncer->State;
+
+    // the counters count down from 3 while a bit differs and go back to 3
+    // when it agrees; a bit whose counter wraps past 0 toggles
+    pDebouncer->Count0 = ~(pDebouncer->Count0 & Differ);
+    pDebouncer->Count1 = pDebouncer->Count0 ^ (pDebouncer->Count1 & Differ);
+    Differ &= pDebouncer->Count0 & pDebouncer->Count1;
+    pDebouncer->State ^= Differ;
+
+    Edges.Pressed = Differ & pDebouncer->State;
+    Edges.Released = Differ & ~pDebouncer->State;
+    return Edges;
+}
+
+uint8_t Debounce_State(const Debouncer_t *pDebouncer)
+{
+    return pDebouncer->State;
+}
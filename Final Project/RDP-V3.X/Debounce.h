@@ -0,0 +1,73 @@
+/*
+ * File: Debounce.h
+ *
+ * Debouncer for up to eight digital inputs read together off one port, such
+ * as the bumpers. Every bit has its own two-bit counter of samples that
+ * disagree with its debounced state; the counters are stored "vertically",
+ * bit 0 of every counter in one byte and bit 1 in another, so one update
+ * steps all eight with a handful of bitwise operations and no branches. A bit
+ * changes state after DEBOUNCE_SAMPLES samples in a row on the other side,
+ * and any sample that agrees starts its count again.
+ *
+ * Each update hands back the bits that were pressed and released as masks,
+ * so inputs that change on the same sample are all reported.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEBOUNCE_SAMPLES 4
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint8_t State; // debounced inputs, 1 = pressed
+    uint8_t Count0; // low bit of each input's counter
+    uint8_t Count1; // high bit of each input's counter
+} Debouncer_t;
+
+typedef struct {
+    uint8_t Pressed; // inputs that went to 1 on this sample
+    uint8_t Released; // inputs that went to 0 on this sample
+} DebounceEdges_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Debounce_Init(Debouncer_t *pDebouncer, uint8_t Initial)
+ * @param pDebouncer - debouncer to set up
+ * @param Initial - debounced state to start from
+ * @return None. */
+void Debounce_Init(Debouncer_t *pDebouncer, uint8_t Initial);
+
+/**
+ * @Function Debounce_Update(Debouncer_t *pDebouncer, uint8_t Sample)
+ * @param pDebouncer - an initialized debouncer
+ * @param Sample - one read of the inputs, 1 = pressed
+ * @return the inputs that changed state on this sample
+ * @brief Call once per sample period with one port read. */
+DebounceEdges_t Debounce_Update(Debouncer_t *pDebouncer, uint8_t Sample);
+
+/**
+ * @Function Debounce_State(const Debouncer_t *pDebouncer)
+ * @param pDebouncer - an initialized debouncer
+ * @return debounced inputs, 1 = pressed */
+uint8_t Debounce_State(const Debouncer_t *pDebouncer);
+
+#endif /* DEBOUNCE_H */
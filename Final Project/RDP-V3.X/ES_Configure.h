@@ -67,6 +67,12 @@ typedef enum {
     CannonTape,
     NoSeeking,
     GoSeeking,
+    SensorDelta,
+    NewADSamples,
+    BumperEdge,
+    MotionDone,
+    TurnComplete,
+    DistanceReached,
 } ES_EventTyp_t;
 
 static const char *EventNames[] = {
@@ -103,6 +109,12 @@ static const char *EventNames[] = {
 	"CannonTape",
 	"NoSeeking",
 	"GoSeeking",
+	"SensorDelta",
+	"NewADSamples",
+	"BumperEdge",
+	"MotionDone",
+	"TurnComplete",
+	"DistanceReached",
 };
 
 
@@ -110,31 +122,31 @@ static const char *EventNames[] = {
 
 /****************************************************************************/
 // This are the name of the Event checking function header file.
-#define EVENT_CHECK_HEADER "ES_Configure.h"
+#define EVENT_CHECK_HEADER "EventCheckers.h"
 
 /****************************************************************************/
 // This is the list of event checking functions
-#define EVENT_CHECK_LIST  
+#define EVENT_CHECK_LIST BumperNotify_CheckEdge, ADAcquire_CheckScan
 
 /****************************************************************************/
 // These are the definitions for the post functions to be executed when the
 // corresponding timer expires. All 16 must be defined. If you are not using
 // a timers, then you can use TIMER_UNUSED
 #define TIMER_UNUSED ((pPostFunc)0)
-#define TIMER0_RESP_FUNC PostRobotBumper 
-#define TIMER1_RESP_FUNC PostTapeSensor 
-#define TIMER2_RESP_FUNC PostTrackWire 
-#define TIMER3_RESP_FUNC PostBeacon
+#define TIMER0_RESP_FUNC TIMER_UNUSED
+#define TIMER1_RESP_FUNC TIMER_UNUSED
+#define TIMER2_RESP_FUNC TIMER_UNUSED
+#define TIMER3_RESP_FUNC TIMER_UNUSED
 #define TIMER4_RESP_FUNC PostRobotHSM
 #define TIMER5_RESP_FUNC PostRobotHSM
 #define TIMER6_RESP_FUNC PostRobotHSM
 #define TIMER7_RESP_FUNC PostRobotHSM
 #define TIMER8_RESP_FUNC PostRobotHSM
 #define TIMER9_RESP_FUNC PostRobotHSM
-#define TIMER10_RESP_FUNC TIMER_UNUSED
-#define TIMER11_RESP_FUNC TIMER_UNUSED
-#define TIMER12_RESP_FUNC TIMER_UNUSED
-#define TIMER13_RESP_FUNC TIMER_UNUSED
+#define TIMER10_RESP_FUNC PostRobotSensors
+#define TIMER11_RESP_FUNC PostSequencer
+#define TIMER12_RESP_FUNC PostMotion
+#define TIMER13_RESP_FUNC PostOdometry
 #define TIMER14_RESP_FUNC TIMER_UNUSED
 #define TIMER15_RESP_FUNC TIMER_UNUSED
 
@@ -147,21 +159,24 @@ static const char *EventNames[] = {
 
 //#define GENERIC_NAMED_TIMER 0 /*make sure this is enabled above and posting to the correct state machine*/
 //#define TURN_TIMER 1
-#define BUMPER_SERVICE_TIMER 0
-#define TAPE_SENSOR_SERVICE_TIMER 1
-#define TRACK_WIRE_SERVICE_TIMER 2
-#define BEACON_TIMER 3
 #define HSM_TIMER 4
 #define SEARCH_TIMER 5
 #define PURSUE_TIMER 6
 #define DESTROY_TIMER 7
 #define ESCAPE_TIMER 8
 #define PURSUE2_TIMER 9
+#define BUMPER_TIMER 10
+#define SEQUENCER_TIMER 11
+#define MOTION_TIMER 12
+#define ODOMETRY_TIMER 13
 
 /****************************************************************************/
 // The maximum number of services sets an upper bound on the number of 
 // services that the framework will handle. Reasonable values are 8 and 16
-// HOWEVER: at this time only a value of 8 is supported.
+// HOWEVER: at this time only a value of 8 is supported by the CMPE118
+// framework the robot links. The host run loop (host/ES_Framework.c) picks
+// from a 32-bit ready word and takes up to 32; bench_sched is built at 32
+// against host/sched_bench/ES_Configure.h.
 #define MAX_NUM_SERVICES 8
 
 /****************************************************************************/
@@ -169,6 +184,13 @@ static const char *EventNames[] = {
 // a particular application. It will vary in value from 1 to MAX_NUM_SERVICES
 #define NUM_SERVICES 6
 
+/****************************************************************************/
+// Depth of the per-service ring that interrupt-context posts (the timer ISR)
+// land in. Must be a power of two; the ring is drained by the run loop
+// ahead of the normal service queue, so a short burst of timeouts while a
+// service is busy no longer overflows the 3-deep queue.
+#define ES_ISR_RING_SIZE 16
+
 /****************************************************************************/
 // These are the definitions for Service 0, the lowest priority service
 // every Events and Services application must have a Service 0. Further 
@@ -187,38 +209,37 @@ static const char *EventNames[] = {
 // These are the definitions for Service 1
 #if NUM_SERVICES > 1
 // the header file with the public fuction prototypes
-#define SERV_1_HEADER "RobotBumper.h"//"RobotHSM.h"
+#define SERV_1_HEADER "RobotSensors.h"
 // the name of the Init function
-#define SERV_1_INIT InitRobotBumper//InitRobotHSM
+#define SERV_1_INIT InitRobotSensors
 // the name of the run function
-#define SERV_1_RUN RunRobotBumper//RunRobotHSM
+#define SERV_1_RUN RunRobotSensors
 // How big should this services Queue be?
 #define SERV_1_QUEUE_SIZE 3
 #endif
 
+/****************************************************************************/
 // These are the definitions for Service 2
 #if NUM_SERVICES > 2
 // the header file with the public fuction prototypes
-#define SERV_2_HEADER "TapeSensor.h"
+#define SERV_2_HEADER "RobotHSM.h"
 // the name of the Init function
-#define SERV_2_INIT InitTapeSensor
+#define SERV_2_INIT InitRobotHSM
 // the name of the run function
-#define SERV_2_RUN RunTapeSensor
+#define SERV_2_RUN RunRobotHSM
 // How big should this services Queue be?
 #define SERV_2_QUEUE_SIZE 3
 #endif
 
-
-
 /****************************************************************************/
 // These are the definitions for Service 3
 #if NUM_SERVICES > 3
 // the header file with the public fuction prototypes
-#define SERV_3_HEADER "TrackWire.h"
+#define SERV_3_HEADER "Sequencer.h"
 // the name of the Init function
-#define SERV_3_INIT InitTrackWire
+#define SERV_3_INIT InitSequencer
 // the name of the run function
-#define SERV_3_RUN RunTrackWire
+#define SERV_3_RUN RunSequencer
 // How big should this services Queue be?
 #define SERV_3_QUEUE_SIZE 3
 #endif
@@ -227,11 +248,11 @@ static const char *EventNames[] = {
 // These are the definitions for Service 4
 #if NUM_SERVICES > 4
 // the header file with the public fuction prototypes
-#define SERV_4_HEADER "Beacon.h"
+#define SERV_4_HEADER "Motion.h"
 // the name of the Init function
-#define SERV_4_INIT InitBeacon
+#define SERV_4_INIT InitMotion
 // the name of the run function
-#define SERV_4_RUN RunBeacon
+#define SERV_4_RUN RunMotion
 // How big should this services Queue be?
 #define SERV_4_QUEUE_SIZE 3
 #endif
@@ -240,40 +261,17 @@ static const char *EventNames[] = {
 // These are the definitions for Service 5
 #if NUM_SERVICES > 5
 // the header file with the public fuction prototypes
-#define SERV_5_HEADER "RobotHSM.h"
+#define SERV_5_HEADER "Odometry.h"
 // the name of the Init function
-#define SERV_5_INIT InitRobotHSM
+#define SERV_5_INIT InitOdometry
 // the name of the run function
-#define SERV_5_RUN RunRobotHSM
+#define SERV_5_RUN RunOdometry
 // How big should this services Queue be?
 #define SERV_5_QUEUE_SIZE 3
 #endif
 
-/****************************************************************************/
-// These are the definitions for Service 6
-#if NUM_SERVICES > 6
-// the header file with the public fuction prototypes
-#define SERV_6_HEADER "RobotHSM.h"
-// the name of the Init function
-#define SERV_6_INIT InitRobotHSM
-// the name of the run function
-#define SERV_6_RUN RunRobotHSM
-// How big should this services Queue be?
-#define SERV_6_QUEUE_SIZE 3
-#endif
-
-/****************************************************************************/
-// These are the definitions for Service 7
-#if NUM_SERVICES > 7
-// the header file with the public fuction prototypes
-#define SERV_7_HEADER "TestService.h"
-// the name of the Init function
-#define SERV_7_INIT TestServiceInit
-// the name of the run function
-#define SERV_7_RUN TestServiceRun
-// How big should this services Queue be?
-#define SERV_7_QUEUE_SIZE 3
-#endif
+// Services 6 through 31 are added the same way, with SERV_n_HEADER,
+// SERV_n_INIT, SERV_n_RUN and SERV_n_QUEUE_SIZE under #if NUM_SERVICES > n
 
 /****************************************************************************/
 // the name of the posting function that you want executed when a new 
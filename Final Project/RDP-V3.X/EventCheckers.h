@@ -0,0 +1,20 @@
+/*
+ * File: EventCheckers.h
+ *
+ * Every event checker in EVENT_CHECK_LIST, for ES_CheckEvents.c, which is
+ * given one header to find them in (EVENT_CHECK_HEADER).
+ *
+ * Created on 18/Oct/2026
+ */
+
+#ifndef EVENT_CHECKERS_H
+#define EVENT_CHECKERS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ADAcquire.h" // ADAcquire_CheckScan()
+#include "BumperNotify.h" // BumperNotify_CheckEdge()
+
+#endif /* EVENT_CHECKERS_H */
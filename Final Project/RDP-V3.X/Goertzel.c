@@ -0,0 +1,151 @@
+/*
+ * File: Goertzel.c
+ *
+ * Goertzel tone detector, see Goertzel.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Goertzel.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define COEFF_SHIFT 14
+#define MID_SCALE ((AD_MAX_VALUE + 1) / 2)
+
+// the bins of Coeff, S1, S2 and Magnitude
+#define TONE 0
+#define BELOW 1
+#define ABOVE 2
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint32_t SquareRoot(uint64_t Value);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int8_t Goertzel_Init(Goertzel_t *pDetector, uint16_t ToneHz, uint16_t SampleHz,
+        uint16_t Length, uint16_t MinMagnitude)
+{
+    int16_t Bins[GOERTZEL_BINS];
+    uint8_t i;
+
+    if ((SampleHz == 0) || (Length == 0)) {
+        return ERROR;
+    }
+    Bins[TONE] = ((uint32_t) ToneHz * Length + SampleHz / 2) / SampleHz;
+    Bins[BELOW] = Bins[TONE] - GOERTZEL_GUARD_BINS;
+    Bins[ABOVE] = Bins[TONE] + GOERTZEL_GUARD_BINS;
+    // every bin strictly between DC and half the sample rate
+    if ((Bins[BELOW] < 1) || (2 * Bins[ABOVE] >= Length)) {
+        return ERROR;
+    }
+    for (i = 0; i < GOERTZEL_BINS; i++) {
+        pDetector->Coeff[i] = (int32_t) lround(2.0 * cos(2.0 * M_PI * Bins[i] / Length)
+                * (1 << COEFF_SHIFT));
+        pDetector->S1[i] = 0;
+        pDetector->S2[i] = 0;
+        pDetector->Magnitude[i] = 0;
+    }
+    pDetector->Length = Length;
+    pDetector->Count = 0;
+    pDetector->MinMagnitude = MinMagnitude;
+    pDetector->Confidence = 0;
+    pDetector->Found = FALSE;
+    return SUCCESS;
+}
+
+uint8_t Goertzel_Step(Goertzel_t *pDetector, uint16_t Sample)
+{
+    int32_t In = (int32_t) Sample - MID_SCALE, S;
+    int64_t Power;
+    uint16_t Noise;
+    uint8_t i;
+
+    for (i = 0; i < GOERTZEL_BINS; i++) {
+        S = In + (int32_t) (((int64_t) pDetector->Coeff[i] * pDetector->S1[i]) >> COEFF_SHIFT)
+                - pDetector->S2[i];
+        pDetector->S2[i] = pDetector->S1[i];
+        pDetector->S1[i] = S;
+    }
+    if (++pDetector->Count < pDetector->Length) {
+        return FALSE;
+    }
+
+    // |X|^2 = S1^2 + S2^2 - coeff S1 S2, and a tone of amplitude A gives
+    // |X| = A N / 2
+    for (i = 0; i < GOERTZEL_BINS; i++) {
+        Power = (int64_t) pDetector->S1[i] * pDetector->S1[i]
+                + (int64_t) pDetector->S2[i] * pDetector->S2[i]
+                - (((int64_t) pDetector->Coeff[i] * pDetector->S1[i] * pDetector->S2[i])
+                >> COEFF_SHIFT);
+        pDetector->Magnitude[i] = (2 * SquareRoot((Power > 0) ? Power : 0)) / pDetector->Length;
+        pDetector->S1[i] = 0;
+        pDetector->S2[i] = 0;
+    }
+    pDetector->Count = 0;
+
+    Noise = (pDetector->Magnitude[BELOW] > pDetector->Magnitude[ABOVE]) ?
+            pDetector->Magnitude[BELOW] : pDetector->Magnitude[ABOVE];
+    if ((pDetector->Magnitude[TONE] >= pDetector->MinMagnitude)
+            && (pDetector->Magnitude[TONE] >= (uint32_t) GOERTZEL_RATIO * Noise)) {
+        if (pDetector->Confidence < GOERTZEL_CONFIDENCE) {
+            pDetector->Confidence++;
+        }
+    } else if (pDetector->Confidence > 0) {
+        pDetector->Confidence--;
+    }
+    if (pDetector->Confidence == GOERTZEL_CONFIDENCE) {
+        pDetector->Found = TRUE;
+    } else if (pDetector->Confidence == 0) {
+        pDetector->Found = FALSE;
+    }
+    return TRUE;
+}
+
+uint16_t Goertzel_Magnitude(const Goertzel_t *pDetector)
+{
+    return pDetector->Magnitude[TONE];
+}
+
+uint8_t Goertzel_Found(const Goertzel_t *pDetector)
+{
+    return pDetector->Found;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* integer square root, rounded down, one result bit per pass */
+static uint32_t SquareRoot(uint64_t Value)
+{
+    uint64_t Root = 0, Bit = 1ull << 62;
+
+    while (Bit > Value) {
+        Bit >>= 2;
+    }
+    while (Bit) {
+        if (Value >= Root + Bit) {
+            Value -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        } else {
+            Root >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return (uint32_t) Root;
+}
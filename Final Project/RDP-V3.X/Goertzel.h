@@ -0,0 +1,92 @@
+/*
+ * File: Goertzel.h
+ *
+ * Tone detector for a sampled A/D channel, for the beacon. Each block of
+ * samples is run through a small bank of Goertzel filters: one on the tone
+ * and one either side of it, GOERTZEL_GUARD_BINS bins away, which measure
+ * the noise floor around the tone. A block passes when the tone is at least
+ * the detector's minimum amplitude and GOERTZEL_RATIO times the louder of the
+ * two neighbours, so a wideband burst or a change in the DC level of the
+ * channel does not pass however large it is.
+ *
+ * The found/lost decision counts passing and failing blocks: a confidence
+ * count goes up on a pass and down on a fail, and the tone is found when it
+ * reaches GOERTZEL_CONFIDENCE and lost when it gets back to 0.
+ *
+ * Everything is integer; the coefficients are worked out once in
+ * Goertzel_Init().
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define GOERTZEL_BINS 3 // the tone, then the bins below and above it
+#define GOERTZEL_GUARD_BINS 3
+#define GOERTZEL_RATIO 2
+#define GOERTZEL_CONFIDENCE 3 // blocks
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    int32_t Coeff[GOERTZEL_BINS]; // 2 cos(2 pi k / N), Q14
+    int32_t S1[GOERTZEL_BINS];
+    int32_t S2[GOERTZEL_BINS];
+    uint16_t Magnitude[GOERTZEL_BINS]; // amplitude in AD counts, last block
+    uint16_t Length; // samples per block
+    uint16_t Count; // samples into the current block
+    uint16_t MinMagnitude;
+    uint8_t Confidence;
+    uint8_t Found;
+} Goertzel_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Goertzel_Init(Goertzel_t *pDetector, uint16_t ToneHz,
+ *           uint16_t SampleHz, uint16_t Length, uint16_t MinMagnitude)
+ * @param pDetector - detector to set up
+ * @param ToneHz - tone to listen for, below SampleHz / 2
+ * @param SampleHz - rate the samples come at
+ * @param Length - samples per block; the bins are SampleHz / Length apart
+ * @param MinMagnitude - smallest tone amplitude, in AD counts, that passes
+ * @return SUCCESS, or ERROR if the tone does not fit the block
+ * @brief The tone is rounded to the nearest bin. Starts with no tone found. */
+int8_t Goertzel_Init(Goertzel_t *pDetector, uint16_t ToneHz, uint16_t SampleHz,
+        uint16_t Length, uint16_t MinMagnitude);
+
+/**
+ * @Function Goertzel_Step(Goertzel_t *pDetector, uint16_t Sample)
+ * @param pDetector - an initialized detector
+ * @param Sample - the next conversion of the channel
+ * @return TRUE if the sample finished a block and the decision was updated */
+uint8_t Goertzel_Step(Goertzel_t *pDetector, uint16_t Sample);
+
+/**
+ * @Function Goertzel_Magnitude(const Goertzel_t *pDetector)
+ * @param pDetector - an initialized detector
+ * @return tone amplitude in AD counts over the last block */
+uint16_t Goertzel_Magnitude(const Goertzel_t *pDetector);
+
+/**
+ * @Function Goertzel_Found(const Goertzel_t *pDetector)
+ * @param pDetector - an initialized detector
+ * @return TRUE while the tone is found */
+uint8_t Goertzel_Found(const Goertzel_t *pDetector);
+
+#endif /* GOERTZEL_H */
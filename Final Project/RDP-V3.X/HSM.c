@@ -0,0 +1,240 @@
+/*
+ * File: HSM.c
+ *
+ * Table-driven hierarchical state machine engine, see HSM.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "HSM.h"
+#include "HSMStats.h"
+#include "Recorder.h"
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint8_t CheckTables(const HSM_Machine_t *pMachine);
+static uint8_t CountBits(uint64_t Mask);
+static void EnterState(const HSM_Machine_t *pMachine, uint8_t NewState, uint8_t Active);
+static void ExitState(const HSM_Machine_t *pMachine);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// EventParam the HSM_CURRENT_PARAM rows of each event answer to
+static uint16_t CurrentParam[64];
+
+// HSM_Init() and HSM_Run() calls under way; an HSM_Init() inside one is an
+// action of a parent starting a child whose parent state may not be active
+static uint8_t Nesting;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t HSM_Init(const HSM_Machine_t *pMachine)
+{
+    uint8_t Active;
+
+    // tables are const, so a machine that started once doesn't need checking
+    // again when its parent restarts it
+    if ((*pMachine->pCurrentState == HSM_NOT_STARTED) && (CheckTables(pMachine) == FALSE)) {
+        return FALSE;
+    }
+    Active = (Nesting == 0);
+    Nesting++;
+    if (pMachine->InitAction) {
+        pMachine->InitAction();
+    }
+    EnterState(pMachine, pMachine->InitialState, Active);
+    Nesting--;
+    return TRUE;
+}
+
+ES_Event HSM_Run(const HSM_Machine_t *pMachine, ES_Event ThisEvent)
+{
+    const HSM_Machine_t *Path[HSM_MAX_DEPTH];
+    const HSM_State_t *pState;
+    const HSM_Transition_t *pRow;
+    uint64_t EventBit;
+    uint8_t Depth = 0, Row;
+
+    // walk down to the innermost active machine; lower levels see the event
+    // first, so it is offered from the bottom of the path up
+    while (pMachine && (*pMachine->pCurrentState != HSM_NOT_STARTED)
+            && (Depth < HSM_MAX_DEPTH)) {
+        Path[Depth++] = pMachine;
+        pMachine = pMachine->States[*pMachine->pCurrentState].Child;
+    }
+
+    EventBit = (ThisEvent.EventType < 64) ? HSM_EV(ThisEvent.EventType) : 0;
+    Nesting++;
+    while (Depth > 0) {
+        pMachine = Path[--Depth];
+        pState = &pMachine->States[*pMachine->pCurrentState];
+        if (pState->EventMask & EventBit) {
+            Row = CountBits(pState->EventMask & (EventBit - 1));
+            pRow = &pState->Rows[Row];
+            if ((pRow->ParamMask == HSM_ANY_PARAM)
+                    || ((pRow->ParamMask == HSM_CURRENT_PARAM)
+                    && (ThisEvent.EventParam == CurrentParam[ThisEvent.EventType]))
+                    || ((ThisEvent.EventParam < 16)
+                    && (pRow->ParamMask & HSM_PARAM(ThisEvent.EventParam)))) {
+                HSMStats_Row(pMachine, Row);
+                if (pRow->Action) {
+                    pRow->Action();
+                }
+                if (pRow->Target != HSM_INTERNAL) {
+                    ExitState(pMachine);
+                    EnterState(pMachine, pRow->Target, TRUE);
+                }
+                if (pRow->Consume) {
+                    ThisEvent.EventType = ES_NO_EVENT;
+                    break;
+                }
+                // a passed event goes on up, the during actions don't run
+                continue;
+            }
+        }
+        if (pState->During) {
+            pState->During();
+        }
+    }
+    Nesting--;
+    return ThisEvent;
+}
+
+void HSM_SetCurrent(uint8_t Event, uint16_t Param)
+{
+    if (Event < 64) {
+        CurrentParam[Event] = Param;
+    }
+}
+
+uint8_t HSM_GetState(const HSM_Machine_t *pMachine)
+{
+    return *pMachine->pCurrentState;
+}
+
+const char *HSM_GetStateName(const HSM_Machine_t *pMachine)
+{
+    uint8_t CurrentState = *pMachine->pCurrentState;
+
+    if (CurrentState >= pMachine->NumStates) {
+        return "NotStarted";
+    }
+    return pMachine->States[CurrentState].Name;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function CheckTables(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine to check
+ * @return TRUE if every state's rows are in ascending event order, one per
+ *         event, exactly covering its EventMask, with valid targets */
+static uint8_t CheckTables(const HSM_Machine_t *pMachine)
+{
+    const HSM_State_t *pState;
+    uint64_t Mask;
+    uint8_t i, j;
+
+    if ((pMachine->NumStates > HSM_INTERNAL)
+            || (pMachine->InitialState >= pMachine->NumStates)) {
+        return FALSE;
+    }
+    for (i = 0; i < pMachine->NumStates; i++) {
+        pState = &pMachine->States[i];
+        Mask = 0;
+        for (j = 0; j < pState->NumRows; j++) {
+            if ((pState->Rows[j].Event >= 64)
+                    || ((j > 0) && (pState->Rows[j].Event <= pState->Rows[j - 1].Event))) {
+                return FALSE;
+            }
+            if ((pState->Rows[j].Target != HSM_INTERNAL)
+                    && (pState->Rows[j].Target >= pMachine->NumStates)) {
+                return FALSE;
+            }
+            Mask |= HSM_EV(pState->Rows[j].Event);
+        }
+        if (Mask != pState->EventMask) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * @Function CountBits(uint64_t Mask)
+ * @param Mask - bits to count
+ * @return number of bits set
+ * @brief Branch-free count, neither the PIC32 nor a baseline x86-64 has a
+ *        popcount instruction and the libgcc fallback is a function call. */
+static uint8_t CountBits(uint64_t Mask)
+{
+    uint32_t Lo = (uint32_t) Mask, Hi = (uint32_t) (Mask >> 32);
+
+    Lo = Lo - ((Lo >> 1) & 0x55555555);
+    Hi = Hi - ((Hi >> 1) & 0x55555555);
+    Lo = (Lo & 0x33333333) + ((Lo >> 2) & 0x33333333);
+    Hi = (Hi & 0x33333333) + ((Hi >> 2) & 0x33333333);
+    Lo = (Lo + (Lo >> 4)) & 0x0F0F0F0F;
+    Hi = (Hi + (Hi >> 4)) & 0x0F0F0F0F;
+    return (uint8_t) (((Lo + Hi) * 0x01010101) >> 24);
+}
+
+/**
+ * @Function EnterState(const HSM_Machine_t *pMachine, uint8_t NewState,
+ *           uint8_t Active)
+ * @param pMachine - machine changing state
+ * @param NewState - state to enter
+ * @param Active - TRUE if every parent of the machine is in the state that
+ *        holds it, so the stay counts for HSMStats
+ * @brief Runs the entry action, then re-enters the child's current state so
+ *        a started child picks up where it left off. */
+static void EnterState(const HSM_Machine_t *pMachine, uint8_t NewState, uint8_t Active)
+{
+    const HSM_State_t *pState = &pMachine->States[NewState];
+    const HSM_Machine_t *pChild = pState->Child;
+
+    *pMachine->pCurrentState = NewState;
+    Recorder_State(pMachine, NewState);
+    if (Active) {
+        HSMStats_Entry(pMachine);
+    }
+    if (pState->Entry) {
+        pState->Entry();
+    }
+    if (pChild && (*pChild->pCurrentState != HSM_NOT_STARTED)) {
+        EnterState(pChild, *pChild->pCurrentState, Active);
+    }
+}
+
+/**
+ * @Function ExitState(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine leaving its current state
+ * @brief Runs exit actions innermost first. The child's state is kept. */
+static void ExitState(const HSM_Machine_t *pMachine)
+{
+    const HSM_State_t *pState = &pMachine->States[*pMachine->pCurrentState];
+    const HSM_Machine_t *pChild = pState->Child;
+
+    if (pChild && (*pChild->pCurrentState != HSM_NOT_STARTED)) {
+        ExitState(pChild);
+    }
+    if (pState->Exit) {
+        pState->Exit();
+    }
+    HSMStats_Exit(pMachine);
+}
@@ -0,0 +1,166 @@
+/*
+ * File: HSM.h
+ *
+ * Table-driven hierarchical state machine engine for RobotHSM and the
+ * SubHSM_* machines. A machine is a const array of states, each with its
+ * own transition rows and entry/exit/during actions, so the whole thing
+ * lives in flash; the only RAM a machine needs is its current state byte.
+ *
+ * Dispatch on (state, event) is O(1): each state carries a 64-bit mask of
+ * the events it has a row for, and the row for an event is found by
+ * counting the mask bits below it. Rows therefore have to be listed in
+ * the order the events appear in ES_Configure.h, one row per event;
+ * HSM_Init() checks this and fails the framework init if a table is
+ * malformed.
+ *
+ * Semantics follow the hand-written switch machines they replace:
+ *  - the child machine of the current state sees every event first and
+ *    consumes it by returning ES_NO_EVENT
+ *  - on a matching row the row's action runs, then (unless the row is
+ *    internal) exit of the old state, entry of the new one; an HSM_PASS row
+ *    then hands the event on up to the parent as the old code did when it
+ *    forgot to clear ThisEvent
+ *  - entering a state whose child has already been started re-runs the
+ *    entry action of the child's current state (shallow history); the
+ *    child keeps its state across the parent leaving and coming back
+ *  - events no row matches run the state's during action and are passed
+ *    back up unchanged
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef HSM_H
+#define HSM_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include "ES_Configure.h"
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// Target of a row that runs its action without leaving the state; also the
+// most states a machine can have
+#define HSM_INTERNAL 0x7F
+
+// *pCurrentState of a machine that has not been through HSM_Init()
+#define HSM_NOT_STARTED 0xFF
+
+// ParamMask matching any EventParam; otherwise bit n matches EventParam n,
+// which is how ES_TIMEOUT rows pick out their timer
+#define HSM_ANY_PARAM 0xFFFF
+#define HSM_PARAM(n) ((uint16_t) 1 << (n))
+
+// ParamMask matching only the EventParam last given to HSM_SetCurrent() for
+// the row's event, so a MotionDone left over from a move that was cut short
+// doesn't end the one started after it
+#define HSM_CURRENT_PARAM 0x0000
+
+// Consume field of a row
+#define HSM_CONSUME TRUE
+#define HSM_PASS FALSE
+
+// EventMask bit for one event
+#define HSM_EV(e) ((uint64_t) 1 << (e))
+
+// Rows and row count of a state, for the HSM_State_t initializer
+#define HSM_ROWS(r) (r), (sizeof (r) / sizeof ((r)[0]))
+#define HSM_NO_ROWS ((const HSM_Transition_t *) 0), 0
+
+// States and state count of a machine, for the HSM_Machine_t initializer
+#define HSM_STATES(s) (s), (sizeof (s) / sizeof ((s)[0]))
+
+// Deepest parent/child nesting HSM_Run() follows; RobotHSM uses two levels
+#define HSM_MAX_DEPTH 4
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef void (*HSM_Action_t)(void);
+
+// 8 bytes on the PIC32: {event, target, consume, param mask, action}
+typedef struct {
+    uint8_t Event; // ES_EventTyp_t
+    uint8_t Target : 7; // next state, or HSM_INTERNAL
+    uint8_t Consume : 1; // HSM_CONSUME or HSM_PASS
+    uint16_t ParamMask;
+    HSM_Action_t Action; // runs before exit/entry, may be NULL
+} HSM_Transition_t;
+
+typedef struct HSM_Machine HSM_Machine_t;
+
+typedef struct {
+    const char *Name;
+    uint64_t EventMask;
+    const HSM_Transition_t *Rows;
+    uint8_t NumRows;
+    HSM_Action_t Entry;
+    HSM_Action_t Exit;
+    HSM_Action_t During;
+    const HSM_Machine_t *Child;
+} HSM_State_t;
+
+struct HSM_Machine {
+    const char *Name;
+    const HSM_State_t *States;
+    uint8_t NumStates;
+    uint8_t InitialState;
+    HSM_Action_t InitAction; // runs once in HSM_Init, before the first entry
+    uint8_t *pCurrentState; // the machine's only RAM
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HSM_Init(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine to start
+ * @return TRUE, or FALSE if the machine's tables are malformed
+ * @brief Checks every state's rows against its EventMask the first time the
+ *        machine is started, then runs the init action and enters the initial
+ *        state. Child machines are not started here; the init action of the
+ *        parent does that, as before. Called from another machine's action,
+ *        the initial state is entered without an HSMStats stay, which waits
+ *        for the parent to enter the state that holds the machine. */
+uint8_t HSM_Init(const HSM_Machine_t *pMachine);
+
+/**
+ * @Function HSM_Run(const HSM_Machine_t *pMachine, ES_Event ThisEvent)
+ * @param pMachine - machine to run
+ * @param ThisEvent - the event to respond to
+ * @return ES_NO_EVENT if the event was consumed, otherwise ThisEvent
+ * @brief Runs the child machine of the current state, then this machine's
+ *        row for the event, if any. A machine that was never started passes
+ *        every event straight back. */
+ES_Event HSM_Run(const HSM_Machine_t *pMachine, ES_Event ThisEvent);
+
+/**
+ * @Function HSM_SetCurrent(uint8_t Event, uint16_t Param)
+ * @param Event - ES_EventTyp_t, below 64
+ * @param Param - the EventParam the Event now awaited will carry
+ * @return None
+ * @brief Called by the service that posts Event as it starts whatever ends
+ *        in one; from then on HSM_CURRENT_PARAM rows only take an Event with
+ *        this Param. */
+void HSM_SetCurrent(uint8_t Event, uint16_t Param);
+
+/**
+ * @Function HSM_GetState(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine to query
+ * @return index of the current state, or HSM_NOT_STARTED */
+uint8_t HSM_GetState(const HSM_Machine_t *pMachine);
+
+/**
+ * @Function HSM_GetStateName(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine to query
+ * @return name of the current state, for tracing */
+const char *HSM_GetStateName(const HSM_Machine_t *pMachine);
+
+#endif /* HSM_H */
@@ -0,0 +1,301 @@
+/*
+ * File: HSMStats.c
+ *
+ * HSM timing statistics, see HSMStats.h.
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <xc.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "HSMStats.h"
+#include "serial.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// event types that can be stamped, as many as HSM has EventMask bits for
+#define NUM_STAMPS 64
+
+// a stay this long has all but FOLD_KEEP of it folded into its state's
+// total, well before the core timer's 2^32 ticks could wrap under it; what
+// is kept is past the start of the last dwell bin, so the stay ends there
+#define FOLD_TICKS (1UL << 30) // 26.8 s
+#define FOLD_KEEP (1UL << 29)
+
+// the bin of a time in core ticks, 0 to 17, without a branch: the 1 shifted
+// in keeps clz off 0, and times under 2^Shift in bin 0
+#define LOG_BIN(Ticks, Shift) (31 - __builtin_clz((((Ticks) >> (Shift)) << 1) | 1))
+
+// macros rather than functions, so they cost no call on the PIC32 at -O1
+#define TOP_BIN(Bin) (((Bin) < HSMSTATS_BINS) ? (Bin) : HSMSTATS_BINS - 1)
+#define TALLY(Count) do { if ((Count) != 0xFFFF) { (Count)++; } } while (0)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+// what a machine's slot needs that is not sent, 12 bytes on the PIC32
+typedef struct {
+    const HSM_Machine_t *pMachine;
+    uint32_t EnteredAt; // core timer at the entry of its current state
+    uint8_t FirstState; // as in its HSMStatsMachine_t
+    uint8_t In; // in a state: entered, and not exited since
+} Live_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static Live_t *Find(const HSM_Machine_t *pMachine);
+static Live_t *Register(const HSM_Machine_t *pMachine);
+static void Fold(Live_t *pLive);
+static void Snapshot(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static HSMStats_t Stats;
+static Live_t Live[HSMSTATS_MAX_MACHINES];
+static Live_t *pLast = Live; // the machine the last call was for
+static uint8_t Dumping;
+static uint16_t Sent; // bytes of the dump
+
+// set from interrupts, so a flag a byte rather than bits of a word
+static uint32_t PostedAt[NUM_STAMPS]; // core timer
+static volatile uint8_t Stamped[NUM_STAMPS];
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void HSMStats_Init(void)
+{
+    uint8_t i;
+
+    Stats = (HSMStats_t) {
+        {0}
+    };
+    for (i = 0; i < sizeof (Stats.Magic); i++) {
+        Stats.Magic[i] = HSMSTATS_MAGIC[i];
+    }
+    Stats.Version = HSMSTATS_VERSION;
+    for (i = 0; i < HSMSTATS_MAX_MACHINES; i++) {
+        Live[i].pMachine = NULL;
+    }
+    pLast = Live;
+    Dumping = FALSE;
+    for (i = 0; i < NUM_STAMPS; i++) {
+        Stamped[i] = FALSE;
+    }
+}
+
+void HSMStats_Entry(const HSM_Machine_t *pMachine)
+{
+    Live_t *pLive = (pLast->pMachine == pMachine) ? pLast : Find(pMachine);
+
+    if ((pLive == NULL) && ((pLive = Register(pMachine)) == NULL)) {
+        if (Stats.Lost != 0xFF) {
+            Stats.Lost++;
+        }
+        return;
+    }
+    pLive->EnteredAt = _CP0_GET_COUNT();
+    pLive->In = TRUE;
+}
+
+void HSMStats_Exit(const HSM_Machine_t *pMachine)
+{
+    Live_t *pLive = (pLast->pMachine == pMachine) ? pLast : Find(pMachine);
+    uint32_t Ticks, Bin;
+    uint8_t Slot;
+
+    if ((pLive == NULL) || !pLive->In) {
+        return;
+    }
+    pLive->In = FALSE;
+    Slot = pLive->FirstState + *pMachine->pCurrentState;
+    Ticks = _CP0_GET_COUNT() - pLive->EnteredAt;
+    Stats.Total[Slot] += Ticks >> HSMSTATS_TOTAL_SHIFT;
+    Bin = LOG_BIN(Ticks, HSMSTATS_DWELL_SHIFT);
+    TALLY(Stats.Dwell[Slot][TOP_BIN(Bin)]);
+}
+
+void HSMStats_Row(const HSM_Machine_t *pMachine, uint8_t Row)
+{
+    Live_t *pLive = (pLast->pMachine == pMachine) ? pLast : Find(pMachine);
+
+    if (pLive == NULL) {
+        return;
+    }
+    TALLY(Stats.Taken[Stats.FirstRow[pLive->FirstState + *pMachine->pCurrentState] + Row]);
+}
+
+void HSMStats_Posted(ES_Event ThisEvent)
+{
+    if ((ThisEvent.EventType < NUM_STAMPS) && !Stamped[ThisEvent.EventType]) {
+        PostedAt[ThisEvent.EventType] = _CP0_GET_COUNT();
+        Stamped[ThisEvent.EventType] = TRUE;
+    }
+}
+
+void HSMStats_Handled(ES_Event ThisEvent)
+{
+    uint32_t Ticks, Bin;
+
+    if ((ThisEvent.EventType >= NUM_STAMPS) || !Stamped[ThisEvent.EventType]) {
+        return;
+    }
+    Ticks = _CP0_GET_COUNT() - PostedAt[ThisEvent.EventType];
+    Stamped[ThisEvent.EventType] = FALSE;
+    Bin = LOG_BIN(Ticks, HSMSTATS_LATENCY_SHIFT);
+    TALLY(Stats.Latency[TOP_BIN(Bin)]);
+    Stats.Handled++;
+    if (Ticks > Stats.WorstLatency) {
+        Stats.WorstLatency = Ticks;
+    }
+}
+
+uint8_t HSMStats_Dump(void)
+{
+    if (Dumping) {
+        return FALSE;
+    }
+    Snapshot();
+    Sent = 0;
+    Dumping = TRUE;
+    return TRUE;
+}
+
+uint16_t HSMStats_Tick(void)
+{
+    const uint8_t *pBytes = (const uint8_t *) &Stats;
+    uint16_t Count = 0;
+    uint8_t i;
+
+    for (i = 0; i < Stats.NumMachines; i++) {
+        Fold(&Live[i]);
+    }
+    if (!Dumping || !IsTransmitEmpty()) {
+        return 0;
+    }
+    while ((Count < HSMSTATS_DRAIN_BYTES) && (Sent < sizeof (Stats))) {
+        PutChar(pBytes[Sent++]);
+        Count++;
+    }
+    if (Sent == sizeof (Stats)) {
+        Dumping = FALSE;
+    }
+    return Count;
+}
+
+void HSMStats_Get(HSMStats_t *pStats)
+{
+    Snapshot();
+    *pStats = Stats;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function Find(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine to look up
+ * @return its slot, or NULL if it has none yet
+ * @brief The callers try the slot of the last call first, since the row,
+ *        exit and entry of a transition are all for the one machine; this
+ *        is the search when that misses. */
+static Live_t *Find(const HSM_Machine_t *pMachine)
+{
+    uint8_t i;
+
+    for (i = 0; (i < Stats.NumMachines) && (Live[i].pMachine != pMachine); i++) {
+    }
+    if (i == Stats.NumMachines) {
+        return NULL;
+    }
+    pLast = &Live[i];
+    return pLast;
+}
+
+/**
+ * @Function Register(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine not seen before
+ * @return its new slot, or NULL if there is no room for it, its states or
+ *         its rows, when it is looked for again on its next entry */
+static Live_t *Register(const HSM_Machine_t *pMachine)
+{
+    HSMStatsMachine_t *pStats;
+    uint16_t Rows = 0;
+    uint8_t i;
+
+    for (i = 0; i < pMachine->NumStates; i++) {
+        Rows += pMachine->States[i].NumRows;
+    }
+    if ((Stats.NumMachines == HSMSTATS_MAX_MACHINES)
+            || (Stats.NumStates + pMachine->NumStates > HSMSTATS_MAX_STATES)
+            || (Stats.NumRows + Rows > HSMSTATS_MAX_ROWS)) {
+        return NULL;
+    }
+    pStats = &Stats.Machines[Stats.NumMachines];
+    pLast = &Live[Stats.NumMachines++];
+    for (i = 0; (i < HSMSTATS_NAME_SIZE - 1) && pMachine->Name[i]; i++) {
+        pStats->Name[i] = pMachine->Name[i];
+    }
+    pStats->NumStates = pMachine->NumStates;
+    pStats->FirstState = Stats.NumStates;
+    pLast->pMachine = pMachine;
+    pLast->FirstState = Stats.NumStates;
+    for (i = 0; i < pMachine->NumStates; i++) {
+        Stats.FirstRow[Stats.NumStates++] = Stats.NumRows;
+        Stats.NumRows += pMachine->States[i].NumRows;
+    }
+    return pLast;
+}
+
+/**
+ * @Function Fold(Live_t *pLive)
+ * @param pLive - a machine's slot
+ * @return None
+ * @brief Moves all but FOLD_KEEP of a stay of FOLD_TICKS or more into its
+ *        state's total, and its entry stamp on by as much. */
+static void Fold(Live_t *pLive)
+{
+    uint32_t Units;
+
+    if (!pLive->In || (_CP0_GET_COUNT() - pLive->EnteredAt < FOLD_TICKS)) {
+        return;
+    }
+    Units = (_CP0_GET_COUNT() - pLive->EnteredAt - FOLD_KEEP) >> HSMSTATS_TOTAL_SHIFT;
+    Stats.Total[pLive->FirstState + *pLive->pMachine->pCurrentState] += Units;
+    pLive->EnteredAt += Units << HSMSTATS_TOTAL_SHIFT;
+}
+
+/* puts the state each machine is in, and how long it has been there that is
+ * not in its total yet, into the tables for a dump */
+static void Snapshot(void)
+{
+    uint8_t i;
+
+    Stats.DumpedMs = ES_Timer_GetTime();
+    for (i = 0; i < Stats.NumMachines; i++) {
+        if (Live[i].In) {
+            Stats.Machines[i].State = *Live[i].pMachine->pCurrentState;
+            Stats.Machines[i].Stayed = (_CP0_GET_COUNT() - Live[i].EnteredAt)
+                    >> HSMSTATS_TOTAL_SHIFT;
+        } else {
+            Stats.Machines[i].State = HSM_NOT_STARTED;
+            Stats.Machines[i].Stayed = 0;
+        }
+    }
+}
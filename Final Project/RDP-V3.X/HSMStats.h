@@ -0,0 +1,189 @@
+/*
+ * File: HSMStats.h
+ *
+ * Timing statistics for the HSM machines, cheap enough to leave on in a
+ * competition build. HSM stamps every state entry and exit, and every row it
+ * takes, with the PIC32 core timer (_CP0_GET_COUNT(), half the 80 MHz system
+ * clock, 40 ticks a us), and RobotHSM stamps each event when it is posted to
+ * it and when it has been run. Out of these the module keeps, in fixed RAM
+ * tables:
+ *
+ *   dwell     for every state of every machine, how many stays in it were
+ *             how long, in HSMSTATS_BINS bins a power of two apart, and the
+ *             time spent in it over all its stays
+ *   rows      how many times each row of each state was taken
+ *   latency   how many events RobotHSM ran how long after they were posted,
+ *             binned the same way, and the longest
+ *
+ * A transition reads the core timer and nothing else, no ES_Timer_GetTime()
+ * call; a stay long enough that the core timer could wrap under it is
+ * folded into its state's total from the sensor tick instead.
+ *
+ * Nothing is formatted on the robot. HSMStats_Dump() sends the tables out of
+ * the UART as they lie in RAM, HSMStats_t below, a block at a time from the
+ * sensor tick (HSMStats_Tick()) as Recorder.h does; host/hsmstats decodes
+ * them with the machines' state and row names. The robot runs on while a dump goes out,
+ * so a block is a tick or so newer than the one before it, but each block
+ * is sent whole from the main loop and no counter in it is torn. The dump
+ * shares the UART with the flight recorder, so do not dump with
+ * RECORD_FIELD_RUN on.
+ *
+ * Machines are given their slots in the tables the first time they enter a
+ * state; a machine there is no room for is not counted. A counter sticks at
+ * its top rather than wrapping.
+ *
+ * Created on 18/Oct/2026
+ */
+
+#ifndef HSMSTATS_H
+#define HSMSTATS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "HSM.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// table sizes; RobotHSM and its sub-state machines take 7 machines, 38
+// states and 66 rows
+#define HSMSTATS_MAX_MACHINES 8
+#define HSMSTATS_MAX_STATES 40
+#define HSMSTATS_MAX_ROWS 128
+
+#define HSMSTATS_TICKS_PER_US 40 // core timer
+
+// bin 0 holds times under 2^SHIFT core ticks, bin n from 2^(SHIFT+n-1) up
+// to twice that, and the last bin everything longer
+#define HSMSTATS_BINS 16
+#define HSMSTATS_DWELL_SHIFT 15 // 819 us to 13.4 s
+#define HSMSTATS_LATENCY_SHIFT 8 // 6.4 us to 105 ms
+
+// times in the totals are in 2^SHIFT core ticks
+#define HSMSTATS_TOTAL_SHIFT 8 // 6.4 us
+
+#define HSMSTATS_NAME_SIZE 12 // characters of a machine name kept, with its 0
+
+#define HSMSTATS_MAGIC "HSS"
+#define HSMSTATS_VERSION 1
+
+// bytes handed to the UART on each HSMStats_Tick(), as RECORDER_DRAIN_BYTES
+#define HSMSTATS_DRAIN_BYTES 128
+
+// keyboard key RobotHSM starts a dump on
+#define HSMSTATS_DUMP_KEY 'h'
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    char Name[HSMSTATS_NAME_SIZE];
+    uint8_t NumStates;
+    uint8_t FirstState; // its first state's slot in Dwell and Total
+    uint8_t State; // it was in at the dump, or HSM_NOT_STARTED if none
+    uint8_t Spare;
+    uint32_t Stayed; // in State at the dump, not yet in its Total
+} HSMStatsMachine_t;
+
+// sent as it lies in RAM, so laid out to need no padding; it comes out the
+// same on the PIC32 and on the host
+typedef struct {
+    char Magic[sizeof (HSMSTATS_MAGIC) - 1];
+    uint8_t Version;
+    uint8_t NumMachines;
+    uint8_t NumStates; // state slots taken
+    uint8_t NumRows; // row slots taken
+    uint8_t Lost; // entries of machines there was no room for
+    uint32_t DumpedMs; // ES_Timer_GetTime() at the dump
+    HSMStatsMachine_t Machines[HSMSTATS_MAX_MACHINES];
+    uint8_t FirstRow[HSMSTATS_MAX_STATES]; // each state's first row slot
+    uint32_t Total[HSMSTATS_MAX_STATES]; // over all stays
+    uint16_t Dwell[HSMSTATS_MAX_STATES][HSMSTATS_BINS];
+    uint16_t Taken[HSMSTATS_MAX_ROWS];
+    uint16_t Latency[HSMSTATS_BINS];
+    uint32_t Handled; // events whose latency was binned
+    uint32_t WorstLatency; // core ticks
+} HSMStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function HSMStats_Init(void)
+ * @param None
+ * @return None
+ * @brief Clears the tables and forgets the machines; called from
+ *        InitRobotHSM(), before any machine starts. */
+void HSMStats_Init(void);
+
+/**
+ * @Function HSMStats_Entry(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine that has just entered its current state
+ * @return None
+ * @brief Called by HSM on every state entry whose parents are all active,
+ *        which starts a stay. A child started from its parent's action
+ *        (HSM_Init() under another HSM call) starts its first stay when
+ *        its parent enters the state that holds it. */
+void HSMStats_Entry(const HSM_Machine_t *pMachine);
+
+/**
+ * @Function HSMStats_Exit(const HSM_Machine_t *pMachine)
+ * @param pMachine - machine leaving its current state
+ * @return None
+ * @brief Called by HSM on every state exit; bins the stay, if one was
+ *        started. */
+void HSMStats_Exit(const HSM_Machine_t *pMachine);
+
+/**
+ * @Function HSMStats_Row(const HSM_Machine_t *pMachine, uint8_t Row)
+ * @param pMachine - machine taking a row of its current state
+ * @param Row - index of the row in the state's Rows
+ * @return None
+ * @brief Called by HSM for every row taken, internal ones too. */
+void HSMStats_Row(const HSM_Machine_t *pMachine, uint8_t Row);
+
+/**
+ * @Function HSMStats_Posted(ES_Event ThisEvent)
+ * @param ThisEvent - event just posted to RobotHSM
+ * @return None
+ * @brief Stamps the event; of several of a type posted before the first is
+ *        run, only the first is stamped. Can be called from an interrupt. */
+void HSMStats_Posted(ES_Event ThisEvent);
+
+/**
+ * @Function HSMStats_Handled(ES_Event ThisEvent)
+ * @param ThisEvent - event RobotHSM has just run
+ * @return None
+ * @brief Bins the time since it was stamped, if it was. */
+void HSMStats_Handled(ES_Event ThisEvent);
+
+/**
+ * @Function HSMStats_Dump(void)
+ * @param None
+ * @return TRUE, or FALSE if a dump is already going out
+ * @brief Starts sending the tables. */
+uint8_t HSMStats_Dump(void);
+
+/**
+ * @Function HSMStats_Tick(void)
+ * @param None
+ * @return bytes of a dump sent
+ * @brief Called by RobotSensors every sensor tick. Folds long stays into
+ *        their totals, and sends up to HSMSTATS_DRAIN_BYTES more of a dump if
+ *        the UART's transmit queue is empty. */
+uint16_t HSMStats_Tick(void);
+
+/**
+ * @Function HSMStats_Get(HSMStats_t *pStats)
+ * @param pStats - filled with the tables as a dump begun now would send them
+ * @return None */
+void HSMStats_Get(HSMStats_t *pStats);
+
+#endif /* HSMSTATS_H */
@@ -0,0 +1,271 @@
+/*
+ * File: Motion.c
+ *
+ * Drive motion primitive service, see Motion.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "BOARD.h"
+#include "Actuators.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "Recorder.h"
+#include "RobotHSM.h"
+#include "Motion.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// speeds are kept Q8, 256 to one motor speed unit, and travel as Q8 speed
+// times ms
+#define Q8(x) ((int32_t) (x) << 8)
+#define FULL_SPEED Q8(100)
+#define ACCEL (FULL_SPEED * MOTION_TICK_MS / MOTION_RAMP_MS) // per tick
+
+#define LEFT 0
+#define RIGHT 1
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef enum {
+    MOTION_IDLE, // at the speeds of the last move, or stopped
+    MOTION_RAMP, // ramping to a held move's speeds
+    MOTION_RUN, // up to and at a set-length move's speeds
+    MOTION_STOP, // ramping a set-length move down to its end
+} MotionPhase_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint8_t Approach(const int32_t *pTarget, int32_t *pNext);
+static int32_t StopTravel(int32_t Speed);
+static void Step(void);
+static void NextTick(void);
+static void SetSpeeds(const int32_t *pNext);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint8_t MyPriority;
+static MotionPhase_t Phase;
+static int32_t Speed[2]; // Q8, as last given to Actuators_Drive()
+static int32_t Goal[2]; // Q8, the speeds of the move
+static uint8_t Ref; // the wheel with the faster goal, whose travel is counted
+static int32_t Remaining; // travel left to the wheel Ref, set-length moves
+static uint8_t TimerRunning;
+static uint32_t LastStep; // ms of the last ramp step
+static uint32_t Due; // ms the timer is armed to
+static uint16_t MoveNumber; // EventParam of the MotionDone of the move
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitMotion(uint8_t Priority)
+{
+    ES_Event ThisEvent;
+
+    MyPriority = Priority;
+    Phase = MOTION_IDLE;
+    Speed[LEFT] = Speed[RIGHT] = 0;
+    Goal[LEFT] = Goal[RIGHT] = 0;
+    TimerRunning = FALSE;
+    ThisEvent.EventType = ES_INIT;
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+void Motion_Arc(int8_t Left, int8_t Right, uint16_t Ms)
+{
+    // a MotionDone still queued from the move this one cuts short is stale
+    HSM_SetCurrent(MotionDone, ++MoveNumber);
+    Goal[LEFT] = Q8(Left);
+    Goal[RIGHT] = Q8(Right);
+    Ref = (abs(Left) >= abs(Right)) ? LEFT : RIGHT;
+    Remaining = abs(Goal[Ref]) * Ms;
+    if (Ms == 0) {
+        Phase = MOTION_RAMP;
+    } else {
+        Phase = Remaining ? MOTION_RUN : MOTION_STOP;
+    }
+    Step();
+    if (Phase == MOTION_IDLE) {
+        return;
+    }
+    // restarted for every move, so the first ramp step after this one is a
+    // whole tick away
+    Due = LastStep + MOTION_TICK_MS;
+    ES_Timer_InitTimer(MOTION_TIMER, MOTION_TICK_MS);
+    TimerRunning = TRUE;
+}
+
+uint8_t Motion_IsMoving(void)
+{
+    return Phase != MOTION_IDLE;
+}
+
+uint8_t PostMotion(ES_Event ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunMotion(ES_Event ThisEvent)
+{
+    ES_Event ReturnEvent;
+
+    ReturnEvent.EventType = ES_NO_EVENT;
+    Recorder_Event(MyPriority, ThisEvent);
+    // a tick already queued when a new move restarted the timer is early
+    if ((ThisEvent.EventType == ES_TIMEOUT) && (ThisEvent.EventParam == MOTION_TIMER)
+            && (Phase != MOTION_IDLE)
+            && ((ES_Timer_GetTime() - LastStep) >= MOTION_TICK_MS)) {
+        Step();
+        if (TimerRunning) {
+            NextTick();
+        }
+    }
+    return ReturnEvent;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function Approach(const int32_t *pTarget, int32_t *pNext)
+ * @param pTarget - Q8 wheel speeds to ramp to
+ * @param pNext - set to the Q8 wheel speeds one tick nearer them
+ * @return TRUE if pNext is pTarget
+ * @brief The wheel with further to go moves by ACCEL and the other by its
+ *        share of that, so both wheels get there on the same tick. */
+static uint8_t Approach(const int32_t *pTarget, int32_t *pNext)
+{
+    int32_t Delta[2], Most;
+    uint8_t i;
+
+    Delta[LEFT] = pTarget[LEFT] - Speed[LEFT];
+    Delta[RIGHT] = pTarget[RIGHT] - Speed[RIGHT];
+    Most = abs(Delta[LEFT]) > abs(Delta[RIGHT]) ? abs(Delta[LEFT]) : abs(Delta[RIGHT]);
+    for (i = 0; i < 2; i++) {
+        pNext[i] = (Most <= ACCEL) ? pTarget[i] : Speed[i] + Delta[i] * ACCEL / Most;
+    }
+    return Most <= ACCEL;
+}
+
+/**
+ * @Function StopTravel(int32_t Speed)
+ * @param Speed - Q8 speed, not negative
+ * @return the Q8 travel of a wheel ramped down from Speed to a stop, each
+ *         speed on the way held a tick */
+static int32_t StopTravel(int32_t Speed)
+{
+    int32_t Steps = (Speed + ACCEL - 1) / ACCEL; // ticks to a stop
+
+    return ((Steps - 1) * Speed - ACCEL * (Steps - 1) * Steps / 2) * MOTION_TICK_MS;
+}
+
+/**
+ * @Function Step(void)
+ * @param None
+ * @return None
+ * @brief Takes one ramp step of the move and, at its end, stops the timer
+ *        and posts MotionDone for a set-length move. */
+static void Step(void)
+{
+    static const int32_t Stopped[2] = {0, 0};
+    int32_t Next[2], Ahead;
+    ES_Event ThisEvent;
+    uint8_t Reached;
+
+    LastStep = ES_Timer_GetTime();
+    switch (Phase) {
+    case MOTION_RAMP:
+        Reached = Approach(Goal, Next);
+        SetSpeeds(Next);
+        if (Reached) {
+            Phase = MOTION_IDLE;
+        }
+        break;
+
+    case MOTION_RUN:
+        Approach(Goal, Next);
+        // speed the way the move goes; a wheel still turning the other way
+        // from the last move adds to the travel left
+        Ahead = (Goal[Ref] < 0) ? -Next[Ref] : Next[Ref];
+        // start down now if after this tick there would not be room to stop
+        if ((Ahead <= 0) || (Remaining - Ahead * MOTION_TICK_MS >= StopTravel(Ahead))) {
+            SetSpeeds(Next);
+            Remaining -= Ahead * MOTION_TICK_MS;
+            break;
+        }
+        Phase = MOTION_STOP;
+        // fall through
+
+    case MOTION_STOP:
+        if (Approach(Stopped, Next)) {
+            Phase = MOTION_IDLE;
+        }
+        SetSpeeds(Next);
+        if (Phase == MOTION_IDLE) {
+            ThisEvent.EventType = MotionDone;
+            ThisEvent.EventParam = MoveNumber;
+            PostRobotHSM(ThisEvent);
+        }
+        break;
+
+    default: // MOTION_IDLE
+        break;
+    }
+    if ((Phase == MOTION_IDLE) && TimerRunning) {
+        TimerRunning = FALSE;
+        ES_Timer_StopTimer(MOTION_TIMER);
+    }
+}
+
+/**
+ * @Function NextTick(void)
+ * @param None
+ * @return None
+ * @brief Re-arms the one-shot MOTION_TIMER for the next ramp step. The steps
+ *        are due a whole number of ticks after the move's first, not a tick
+ *        after this one was handled, so a late step doesn't put the rest
+ *        off; a step more than a tick late is skipped rather than run
+ *        twice. */
+static void NextTick(void)
+{
+    uint32_t Now = ES_Timer_GetTime();
+
+    do {
+        Due += MOTION_TICK_MS;
+    } while ((int32_t) (Due - Now) <= 0);
+    ES_Timer_InitTimer(MOTION_TIMER, Due - Now);
+}
+
+/**
+ * @Function SetSpeeds(const int32_t *pNext)
+ * @param pNext - Q8 wheel speeds
+ * @return None
+ * @brief Keeps them as the wheel speeds and drives the motors at them,
+ *        rounded to whole motor speeds. */
+static void SetSpeeds(const int32_t *pNext)
+{
+    int32_t Out[2];
+    uint8_t i;
+
+    for (i = 0; i < 2; i++) {
+        Speed[i] = pNext[i];
+        Out[i] = (pNext[i] >= 0) ? (pNext[i] + 128) >> 8 : -((128 - pNext[i]) >> 8);
+    }
+    Actuators_Drive((int8_t) Out[LEFT], (int8_t) Out[RIGHT]);
+}
@@ -0,0 +1,97 @@
+/*
+ * File: Motion.h
+ *
+ * Motion primitives for the drive wheels. A state asks for a move (drive
+ * straight, arc, pivot about one wheel, tank turn) and this service takes
+ * the wheels to its speeds on a ramp, MOTION_RAMP_MS from stopped to full
+ * speed, rather than in one step, so the tyres don't spin and how far the
+ * robot gets no longer depends on how well they grip.
+ *
+ * A move has the length the states always gave it: Ms, how long it would
+ * take at its speeds with no ramps. The faster wheel ramps up, covers the
+ * travel it would have covered in that time and ramps down to a stop, and
+ * then MotionDone is posted to RobotHSM, with the move's number as its
+ * param for HSM_CURRENT_PARAM rows to match; the ramps add about
+ * MOTION_RAMP_MS times the speed to the time the move takes. A move with an
+ * Ms of 0 ramps to its speeds and holds them until the next move.
+ *
+ * Starting a move drops the one running, without its MotionDone (one already
+ * queued no longer matches), and the wheels ramp from whatever speeds they
+ * had to the new ones. Both wheels change together, so an arc keeps its
+ * radius as it speeds up and slows.
+ *
+ * The ramps step every MOTION_TICK_MS, on a one-shot timer re-armed at each
+ * step for the next tick of the move, run only while a move is under way.
+ * This service is the only one to set the drive motors (Actuators_Drive()).
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef MOTION_H
+#define MOTION_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define MOTION_TICK_MS 5
+#define MOTION_RAMP_MS 200 // stopped to full speed
+
+// both wheels at Speed
+#define Motion_Drive(Speed, Ms) Motion_Arc((Speed), (Speed), (Ms))
+
+// on the spot, clockwise for a positive Speed
+#define Motion_Tank(Speed, Ms) Motion_Arc((Speed), -(Speed), (Ms))
+
+// about the stopped left or right wheel, the other one at Speed
+#define Motion_PivotLeft(Speed, Ms) Motion_Arc(0, (Speed), (Ms))
+#define Motion_PivotRight(Speed, Ms) Motion_Arc((Speed), 0, (Ms))
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitMotion(uint8_t Priority)
+ * @param Priority - internal variable to track which event queue to use
+ * @return TRUE or FALSE
+ * @brief Takes the wheels as stopped, with no move, and posts ES_INIT. */
+uint8_t InitMotion(uint8_t Priority);
+
+/**
+ * @Function Motion_Arc(int8_t Left, int8_t Right, uint16_t Ms)
+ * @param Left - left wheel speed, -100 to 100
+ * @param Right - right wheel speed, -100 to 100
+ * @param Ms - length of the move as the time at those speeds, or 0 to hold
+ *        them
+ * @return None
+ * @brief Starts the move; the first ramp step is taken straight away. */
+void Motion_Arc(int8_t Left, int8_t Right, uint16_t Ms);
+
+/**
+ * @Function Motion_IsMoving(void)
+ * @param None
+ * @return TRUE until the wheels have reached a held move's speeds or a move
+ *         of set length has stopped */
+uint8_t Motion_IsMoving(void);
+
+/**
+ * @Function PostMotion(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be posted to queue
+ * @return TRUE or FALSE */
+uint8_t PostMotion(ES_Event ThisEvent);
+
+/**
+ * @Function RunMotion(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be responded.
+ * @return ES_NO_EVENT
+ * @brief Takes a ramp step every MOTION_TIMER timeout. */
+ES_Event RunMotion(ES_Event ThisEvent);
+
+#endif /* MOTION_H */
@@ -0,0 +1,307 @@
+/*
+ * File: Odometry.c
+ *
+ * Dead reckoning service, see Odometry.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "Recorder.h"
+#include "Odometry.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// the pose is moved on at most this many ms at a time, so an arc is taken as
+// short chords
+#define STEP_MS 10
+
+#define TURN (1L << 24) // heading units in a turn
+#define HEADING_MASK (TURN - 1)
+
+// heading units per um the left wheel gets ahead of the right, Q8:
+// TURN / (2 pi ODOMETRY_WHEELBASE_UM)
+#define HEADING_PER_UM 2734
+
+#define FULL_SCALE 256 // Q8 battery scale of a charged battery
+#define MAX_SCALE (2 * FULL_SCALE)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Left; // what is to go, 0 with no target
+    pPostFunc PostFunc;
+    ES_EventTyp_t EventType;
+    uint16_t Number; // EventParam of the event, one more for each target set
+} Target_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void Update(void);
+static void Advance(uint32_t Ms);
+static void Check(Target_t *pTarget, uint32_t Moved);
+static void Arm(void);
+static uint32_t DueIn(const Target_t *pTarget, uint32_t PerMs);
+static int32_t Sine(uint8_t Angle);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// sin of 0 to a quarter turn in 64ths, Q15
+static const int16_t SineTable[65] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+    6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+static uint8_t MyPriority;
+static int8_t LeftSpeed;
+static int8_t RightSpeed;
+static int32_t Scale; // Q8, FULL_SCALE on a charged battery
+static int32_t X; // um
+static int32_t Y;
+static uint32_t Heading; // TURN a turn, clockwise
+static uint32_t LastUpdate; // ms the pose is as of
+static Target_t Turn; // heading units
+static Target_t Distance; // um
+static uint8_t TimerRunning;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitOdometry(uint8_t Priority)
+{
+    ES_Event ThisEvent;
+
+    MyPriority = Priority;
+    LeftSpeed = RightSpeed = 0;
+    Scale = FULL_SCALE;
+    X = Y = 0;
+    Heading = 0;
+    LastUpdate = ES_Timer_GetTime();
+    Turn.Left = 0;
+    Turn.EventType = TurnComplete;
+    Distance.Left = 0;
+    Distance.EventType = DistanceReached;
+    TimerRunning = FALSE;
+    ThisEvent.EventType = ES_INIT;
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+void Odometry_Drive(int8_t Left, int8_t Right)
+{
+    Update();
+    LeftSpeed = Left;
+    RightSpeed = Right;
+    Arm();
+}
+
+void Odometry_SetBattery(uint16_t Counts)
+{
+    Update();
+    Scale = (int32_t) Counts * FULL_SCALE / ODOMETRY_FULL_BATTERY;
+    if (Scale > MAX_SCALE) {
+        Scale = MAX_SCALE;
+    }
+    Arm();
+}
+
+void Odometry_Turn(uint16_t Degrees, pPostFunc PostFunc)
+{
+    Update();
+    Turn.Left = (uint32_t) ((uint64_t) Degrees * TURN / 360);
+    Turn.PostFunc = PostFunc;
+    HSM_SetCurrent(TurnComplete, ++Turn.Number);
+    Arm();
+}
+
+void Odometry_Distance(uint16_t Mm, pPostFunc PostFunc)
+{
+    Update();
+    Distance.Left = (uint32_t) Mm * 1000;
+    Distance.PostFunc = PostFunc;
+    HSM_SetCurrent(DistanceReached, ++Distance.Number);
+    Arm();
+}
+
+void Odometry_GetPose(OdometryPose_t *pPose)
+{
+    Update();
+    pPose->X = X / 1000;
+    pPose->Y = Y / 1000;
+    pPose->Heading = (uint16_t) (Heading >> 8);
+}
+
+uint8_t PostOdometry(ES_Event ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunOdometry(ES_Event ThisEvent)
+{
+    ES_Event ReturnEvent;
+
+    ReturnEvent.EventType = ES_NO_EVENT;
+    Recorder_Event(MyPriority, ThisEvent);
+    if ((ThisEvent.EventType == ES_TIMEOUT) && (ThisEvent.EventParam == ODOMETRY_TIMER)) {
+        TimerRunning = FALSE;
+        Update();
+        Arm();
+    }
+    return ReturnEvent;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function Update(void)
+ * @param None
+ * @return None
+ * @brief Moves the pose on to now at the speeds and battery since the last
+ *        update, posting the events of the targets that come due. */
+static void Update(void)
+{
+    uint32_t Now = ES_Timer_GetTime();
+    uint32_t Ms;
+
+    while (Now != LastUpdate) {
+        Ms = Now - LastUpdate;
+        if (Ms > STEP_MS) {
+            Ms = STEP_MS;
+        }
+        Advance(Ms);
+        LastUpdate += Ms;
+    }
+}
+
+/**
+ * @Function Advance(uint32_t Ms)
+ * @param Ms - 1 to STEP_MS
+ * @return None
+ * @brief Moves the pose on by one chord of the arc the wheels are on. */
+static void Advance(uint32_t Ms)
+{
+    int32_t LeftUm, RightUm, Turned, Middle;
+    uint8_t Angle;
+
+    LeftUm = (int32_t) LeftSpeed * Scale * ODOMETRY_UM_PER_UNIT_MS * (int32_t) Ms / 65536;
+    RightUm = (int32_t) RightSpeed * Scale * ODOMETRY_UM_PER_UNIT_MS * (int32_t) Ms / 65536;
+    if ((LeftUm == 0) && (RightUm == 0)) {
+        return;
+    }
+    Turned = (LeftUm - RightUm) * HEADING_PER_UM / 256;
+    Middle = (LeftUm + RightUm) / 2;
+    // along the heading half way through the chord
+    Angle = (uint8_t) (((Heading + Turned / 2 + (1 << 15)) & HEADING_MASK) >> 16);
+    X += Middle * Sine(Angle + 64) / 32768;
+    Y += Middle * Sine(Angle) / 32768;
+    Heading = (Heading + Turned) & HEADING_MASK;
+    Check(&Turn, abs(Turned));
+    Check(&Distance, abs(Middle));
+}
+
+/**
+ * @Function Check(Target_t *pTarget, uint32_t Moved)
+ * @param pTarget - the turn or distance target
+ * @param Moved - towards it, in its units
+ * @return None */
+static void Check(Target_t *pTarget, uint32_t Moved)
+{
+    ES_Event ThisEvent;
+
+    if (pTarget->Left == 0) {
+        return;
+    }
+    if (Moved < pTarget->Left) {
+        pTarget->Left -= Moved;
+        return;
+    }
+    pTarget->Left = 0;
+    ThisEvent.EventType = pTarget->EventType;
+    ThisEvent.EventParam = pTarget->Number;
+    pTarget->PostFunc(ThisEvent);
+}
+
+/**
+ * @Function Arm(void)
+ * @param None
+ * @return None
+ * @brief Sets the timer for the ms the nearer target is due at the present
+ *        speeds, or stops it if neither is ever due at them. */
+static void Arm(void)
+{
+    int32_t LeftUm, RightUm;
+    uint32_t TurnDue, DistanceDue;
+
+    LeftUm = (int32_t) LeftSpeed * Scale * ODOMETRY_UM_PER_UNIT_MS / 65536;
+    RightUm = (int32_t) RightSpeed * Scale * ODOMETRY_UM_PER_UNIT_MS / 65536;
+    TurnDue = DueIn(&Turn, abs(LeftUm - RightUm) * HEADING_PER_UM / 256);
+    DistanceDue = DueIn(&Distance, abs(LeftUm + RightUm) / 2);
+    if (DistanceDue && (!TurnDue || (DistanceDue < TurnDue))) {
+        TurnDue = DistanceDue;
+    }
+    if (TurnDue) {
+        ES_Timer_InitTimer(ODOMETRY_TIMER, TurnDue);
+        TimerRunning = TRUE;
+    } else if (TimerRunning) {
+        TimerRunning = FALSE;
+        ES_Timer_StopTimer(ODOMETRY_TIMER);
+    }
+}
+
+/**
+ * @Function DueIn(const Target_t *pTarget, uint32_t PerMs)
+ * @param pTarget - the turn or distance target
+ * @param PerMs - how fast it is being moved towards, in its units
+ * @return ms until it is due, at least 1, or 0 if it never is */
+static uint32_t DueIn(const Target_t *pTarget, uint32_t PerMs)
+{
+    if ((pTarget->Left == 0) || (PerMs == 0)) {
+        return 0;
+    }
+    return (pTarget->Left + PerMs - 1) / PerMs;
+}
+
+/**
+ * @Function Sine(uint8_t Angle)
+ * @param Angle - 256 a turn
+ * @return sin, Q15 */
+static int32_t Sine(uint8_t Angle)
+{
+    uint8_t Step = Angle & 63;
+
+    switch (Angle >> 6) {
+    case 0:
+        return SineTable[Step];
+    case 1:
+        return SineTable[64 - Step];
+    case 2:
+        return -SineTable[Step];
+    default:
+        return -SineTable[64 - Step];
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * File: Odometry.h
+ *
+ * Dead reckoning of the robot's pose (x, y, heading) from the speeds the
+ * drive motors are given, so a state can turn through an angle or drive a
+ * distance instead of running its motors for a time. There are no wheel
+ * encoders: a wheel is taken to cover ODOMETRY_UM_PER_UNIT_MS a ms for each
+ * unit of its motor's speed, scaled by the battery voltage, since the
+ * motors slow as the battery runs down and a time tuned on a charged
+ * battery turns the robot short on a flat one. The speeds come from
+ * Actuators_Drive() and the battery from RobotSensors.
+ *
+ * Odometry_Turn() and Odometry_Distance() set a target and name where its
+ * event goes: TurnComplete once the robot has turned through the angle, or
+ * DistanceReached once the middle of its axle has covered the distance,
+ * counting movement either way. There is one target of each kind; setting
+ * one drops the last without its event, and one of 0 just drops it. Each
+ * target set is numbered and its event carries the number as its param,
+ * for HSM_CURRENT_PARAM rows to match, so one already queued for a dropped
+ * target no longer matches. A target is checked when the speeds change and
+ * when this service's timer, set for the ms the target is due at the
+ * present speeds, runs out, not on a fixed tick.
+ *
+ * The pose is kept in fixed point, position in um and heading in 2^24ths
+ * of a turn, clockwise, from where InitOdometry() left it.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// floor speed of a wheel per unit of motor speed on a charged battery, Q8
+// um a ms, and the track between the wheels; set from the Lookout spin,
+// 360 degrees in 8.5 s at 90
+#define ODOMETRY_UM_PER_UNIT_MS 263 // 1.027
+#define ODOMETRY_WHEELBASE_UM 250000
+
+// BAT_VOLTAGE AD counts of a charged battery, at which the speed is set
+#define ODOMETRY_FULL_BATTERY 279
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    int32_t X; // mm, forward from the start
+    int32_t Y; // mm, right of the start
+    uint16_t Heading; // 65536 a turn, clockwise from the start
+} OdometryPose_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitOdometry(uint8_t Priority)
+ * @param Priority - internal variable to track which event queue to use
+ * @return TRUE or FALSE
+ * @brief Puts the robot at the origin, stopped, on a charged battery, with
+ *        no targets, and posts ES_INIT. */
+uint8_t InitOdometry(uint8_t Priority);
+
+/**
+ * @Function Odometry_Drive(int8_t Left, int8_t Right)
+ * @param Left - the left motor's new speed, -100 to 100
+ * @param Right - the right motor's new speed, -100 to 100
+ * @return None
+ * @brief Called by Actuators_Drive() when the speeds change. */
+void Odometry_Drive(int8_t Left, int8_t Right);
+
+/**
+ * @Function Odometry_SetBattery(uint16_t Counts)
+ * @param Counts - BAT_VOLTAGE reading
+ * @return None
+ * @brief Called by RobotSensors every few hundred ms. */
+void Odometry_SetBattery(uint16_t Counts);
+
+/**
+ * @Function Odometry_Turn(uint16_t Degrees, pPostFunc PostFunc)
+ * @param Degrees - angle to turn through
+ * @param PostFunc - where TurnComplete is posted
+ * @return None */
+void Odometry_Turn(uint16_t Degrees, pPostFunc PostFunc);
+
+/**
+ * @Function Odometry_Distance(uint16_t Mm, pPostFunc PostFunc)
+ * @param Mm - distance to cover
+ * @param PostFunc - where DistanceReached is posted
+ * @return None */
+void Odometry_Distance(uint16_t Mm, pPostFunc PostFunc);
+
+/**
+ * @Function Odometry_GetPose(OdometryPose_t *pPose)
+ * @param pPose - filled with the pose as of now
+ * @return None */
+void Odometry_GetPose(OdometryPose_t *pPose);
+
+/**
+ * @Function PostOdometry(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be posted to queue
+ * @return TRUE or FALSE */
+uint8_t PostOdometry(ES_Event ThisEvent);
+
+/**
+ * @Function RunOdometry(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be responded.
+ * @return ES_NO_EVENT
+ * @brief Checks the targets on an ODOMETRY_TIMER timeout. */
+ES_Event RunOdometry(ES_Event ThisEvent);
+
+#endif /* ODOMETRY_H */
@@ -0,0 +1,262 @@
+/*
+ * File: Recorder.c
+ *
+ * Flight recorder, see Recorder.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "AD.h"
+#include "HSM.h"
+#include "Recorder.h"
+#include "serial.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define RING_MASK (RECORDER_SIZE - 1)
+
+#define MAX_VARINT 5 // bytes in a 32-bit varint
+#define MAX_NAME 23 // characters of a machine name that are recorded
+
+// bytes the records ahead of a record can take: a REC_GAP and a REC_TIME
+#define MAX_PREFIX (2 * (1 + MAX_VARINT))
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint8_t Begin(uint8_t Size);
+static void Put(uint8_t Byte);
+static void PutVarint(uint32_t Value);
+static uint8_t MachineNumber(const HSM_Machine_t *pMachine);
+static void NoteHighWater(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint8_t Ring[RECORDER_SIZE];
+static uint32_t Head; // free running, the ring's bytes are Tail to Head
+static uint32_t Tail;
+static uint8_t Recording;
+static RecorderStats_t Stats;
+static uint32_t Gap; // records dropped since the last one recorded
+
+// what the next record is a difference from
+static uint32_t LastTime;
+static uint16_t LastAD[AD_NUM_PINS];
+static uint8_t LastBumpers;
+static const HSM_Machine_t *Machines[RECORDER_MAX_MACHINES];
+static uint8_t NumMachines;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void Recorder_Start(void)
+{
+    const char *pMagic;
+    uint8_t i;
+
+    Head = Tail = 0;
+    Stats = (RecorderStats_t) {0};
+    Gap = 0;
+    LastTime = 0;
+    for (i = 0; i < AD_NUM_PINS; i++) {
+        LastAD[i] = 0;
+    }
+    LastBumpers = 0;
+    NumMachines = 0;
+    for (pMagic = RECORDER_MAGIC; *pMagic; pMagic++) {
+        Put(*pMagic);
+    }
+    Put(RECORDER_VERSION);
+    Recording = TRUE;
+}
+
+void Recorder_Stop(void)
+{
+    Recording = FALSE;
+}
+
+void Recorder_AD(unsigned int Pin, uint16_t Sample)
+{
+    uint8_t i = __builtin_ctz(Pin);
+    int32_t Difference = (int32_t) Sample - LastAD[i];
+
+    if (!Recording || !Begin(1 + MAX_VARINT)) {
+        return;
+    }
+    Put(REC_TAG(REC_AD, i));
+    // zigzag, so a small step either way is a small number
+    PutVarint((uint32_t) ((Difference << 1) ^ (Difference >> 31)));
+    LastAD[i] = Sample;
+    Stats.Records++;
+}
+
+void Recorder_Bumpers(uint8_t Bumpers)
+{
+    if (!Recording || (Bumpers == LastBumpers) || !Begin(1)) {
+        return;
+    }
+    Put(REC_TAG(REC_BUMPERS, Bumpers));
+    LastBumpers = Bumpers;
+    Stats.Records++;
+}
+
+void Recorder_Event(uint8_t Service, ES_Event ThisEvent)
+{
+    if (!Recording || !Begin(1 + 2 * MAX_VARINT)) {
+        return;
+    }
+    Put(REC_TAG(REC_EVENT, Service));
+    PutVarint(ThisEvent.EventType);
+    PutVarint(ThisEvent.EventParam);
+    Stats.Records++;
+}
+
+void Recorder_State(const HSM_Machine_t *pMachine, uint8_t State)
+{
+    uint8_t Number;
+    const char *pName;
+    uint8_t i;
+
+    if (!Recording) {
+        return;
+    }
+    Number = MachineNumber(pMachine);
+    if (Number == NumMachines) {
+        // not seen before: name it first
+        if ((NumMachines == RECORDER_MAX_MACHINES) || !Begin(1 + MAX_NAME + 1)) {
+            return;
+        }
+        Put(REC_TAG(REC_MACHINE, Number));
+        for (pName = pMachine->Name, i = 0; *pName && (i < MAX_NAME); pName++, i++) {
+            Put(*pName);
+        }
+        Put(0);
+        Machines[NumMachines++] = pMachine;
+        Stats.Records++;
+    }
+    if (!Begin(1 + MAX_VARINT)) {
+        return;
+    }
+    Put(REC_TAG(REC_STATE, Number));
+    PutVarint(State);
+    Stats.Records++;
+}
+
+uint16_t Recorder_Read(uint8_t *pBuffer, uint16_t Size)
+{
+    uint16_t Count = 0;
+
+    NoteHighWater();
+    while ((Count < Size) && (Tail != Head)) {
+        pBuffer[Count++] = Ring[Tail++ & RING_MASK];
+    }
+    return Count;
+}
+
+uint16_t Recorder_Drain(void)
+{
+    uint16_t Count = 0;
+
+    if (!IsTransmitEmpty()) {
+        return 0;
+    }
+    NoteHighWater();
+    while ((Count < RECORDER_DRAIN_BYTES) && (Tail != Head)) {
+        PutChar(Ring[Tail++ & RING_MASK]);
+        Count++;
+    }
+    return Count;
+}
+
+void Recorder_GetStats(RecorderStats_t *pStats)
+{
+    NoteHighWater();
+    Stats.Bytes = Head;
+    *pStats = Stats;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function Begin(uint8_t Size)
+ * @param Size - most bytes the record can take
+ * @return TRUE if the record fits, else FALSE and it is counted as dropped
+ * @brief Puts in the REC_GAP and REC_TIME the record needs ahead of it. Room
+ *        for them is made sure of first, so a record is either recorded
+ *        whole or not at all. */
+static uint8_t Begin(uint8_t Size)
+{
+    uint32_t Now;
+
+    if ((RECORDER_SIZE - (Head - Tail)) < (uint32_t) (Size + MAX_PREFIX)) {
+        Gap++;
+        Stats.Dropped++;
+        return FALSE;
+    }
+    if (Gap) {
+        Put(REC_TAG(REC_GAP, 0));
+        PutVarint(Gap);
+        Gap = 0;
+    }
+    Now = ES_Timer_GetTime();
+    if (Now != LastTime) {
+        if ((Now - LastTime) < REC_LONG_TIME) {
+            Put(REC_TAG(REC_TIME, Now - LastTime));
+        } else {
+            Put(REC_TAG(REC_TIME, REC_LONG_TIME));
+            PutVarint(Now - LastTime - REC_LONG_TIME);
+        }
+        LastTime = Now;
+    }
+    return TRUE;
+}
+
+static void Put(uint8_t Byte)
+{
+    Ring[Head++ & RING_MASK] = Byte;
+}
+
+static void PutVarint(uint32_t Value)
+{
+    while (Value >= 0x80) {
+        Put((uint8_t) (Value | 0x80));
+        Value >>= 7;
+    }
+    Put((uint8_t) Value);
+}
+
+/* the machine's number, or NumMachines if it has none yet */
+static uint8_t MachineNumber(const HSM_Machine_t *pMachine)
+{
+    uint8_t i;
+
+    for (i = 0; (i < NumMachines) && (Machines[i] != pMachine); i++) {
+    }
+    return i;
+}
+
+/* the ring is fullest just before it is emptied, so this is done there
+ * rather than on every record */
+static void NoteHighWater(void)
+{
+    uint16_t Held = Head - Tail;
+
+    if (Held > Stats.HighWater) {
+        Stats.HighWater = Held;
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * File: Recorder.h
+ *
+ * Flight recorder for field runs. The services note what they read and do
+ * as they go (the A/D samples and bumper masks RobotSensors takes, the
+ * events the services run and the HSM transitions that follow) and the
+ * recorder packs each one into a few bytes in a RAM ring, which is sent out
+ * of the UART a block at a time from the sensor tick. Nothing waits on the
+ * UART, so recording leaves the timing of the run alone, unlike printf.
+ *
+ * The stream starts with RECORDER_MAGIC and a version byte. Every record is
+ * a tag byte, the record type in its top three bits and a small argument in
+ * the low five, followed by varints (seven bits a byte, low first, top bit
+ * set on every byte but the last):
+ *
+ *   REC_TIME     ms since the record before; in the argument up to 30, else
+ *                the argument is 31 and a varint of the rest follows
+ *   REC_AD       argument = pin number, varint of the zigzagged difference
+ *                from the pin's last recorded sample
+ *   REC_BUMPERS  argument = the bumper mask, when it changes
+ *   REC_EVENT    argument = the service's priority, varints of EventType and
+ *                EventParam
+ *   REC_STATE    argument = machine number, varint of the new state
+ *   REC_MACHINE  argument = machine number, then its name and a 0, before
+ *                the machine's first REC_STATE
+ *   REC_GAP      varint of the records dropped on a full ring
+ *
+ * A REC_TIME goes in ahead of any record that is the first in a new ms.
+ * Record only from the main loop, never from an interrupt.
+ *
+ * host/replay plays a stream back through RobotSensors and RobotHSM on the
+ * host build and checks that it records the same stream again.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "HSM.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// bytes in the ring, a power of two
+#define RECORDER_SIZE 2048
+
+// bytes handed to the UART on each Recorder_Drain(), no more than the
+// serial library's transmit queue holds
+#define RECORDER_DRAIN_BYTES 128
+
+#define RECORDER_MAGIC "RDP"
+#define RECORDER_VERSION 1
+
+#define RECORDER_MAX_MACHINES 8
+
+// record types, the top three bits of the tag
+#define REC_TIME 0
+#define REC_AD 1
+#define REC_BUMPERS 2
+#define REC_EVENT 3
+#define REC_STATE 4
+#define REC_MACHINE 5
+#define REC_GAP 6
+
+#define REC_TAG(Type, Arg) ((uint8_t) (((Type) << 5) | (Arg)))
+#define REC_TYPE(Tag) ((Tag) >> 5)
+#define REC_ARG(Tag) ((Tag) & 0x1F)
+#define REC_LONG_TIME 0x1F // REC_TIME argument with a varint after it
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Records; // written to the ring
+    uint32_t Bytes; // written to the ring
+    uint32_t Dropped; // records the ring had no room for
+    uint16_t HighWater; // most bytes the ring has held
+} RecorderStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Recorder_Start(void)
+ * @param None
+ * @return None
+ * @brief Empties the ring, clears the counters and starts a new stream with
+ *        its header. Recording is off until this is called. */
+void Recorder_Start(void);
+
+/**
+ * @Function Recorder_Stop(void)
+ * @param None
+ * @return None
+ * @brief Stops recording; what is in the ring can still be drained. */
+void Recorder_Stop(void);
+
+/**
+ * @Function Recorder_AD(unsigned int Pin, uint16_t Sample)
+ * @param Pin - a single AD_PORTxx pin
+ * @param Sample - what the service read from the pin
+ * @return None */
+void Recorder_AD(unsigned int Pin, uint16_t Sample);
+
+/**
+ * @Function Recorder_Bumpers(uint8_t Bumpers)
+ * @param Bumpers - the mask Robot_ReadBumpers() returned
+ * @return None
+ * @brief Only a mask that differs from the last one is recorded. */
+void Recorder_Bumpers(uint8_t Bumpers);
+
+/**
+ * @Function Recorder_Event(uint8_t Service, ES_Event ThisEvent)
+ * @param Service - priority of the service running the event
+ * @param ThisEvent - the event
+ * @return None */
+void Recorder_Event(uint8_t Service, ES_Event ThisEvent);
+
+/**
+ * @Function Recorder_State(const HSM_Machine_t *pMachine, uint8_t State)
+ * @param pMachine - the machine entering State
+ * @param State - the state it enters
+ * @return None
+ * @brief Called by HSM on every state entry. */
+void Recorder_State(const HSM_Machine_t *pMachine, uint8_t State);
+
+/**
+ * @Function Recorder_Read(uint8_t *pBuffer, uint16_t Size)
+ * @param pBuffer - where the bytes go
+ * @param Size - most bytes to take
+ * @return bytes taken out of the ring, oldest first */
+uint16_t Recorder_Read(uint8_t *pBuffer, uint16_t Size);
+
+/**
+ * @Function Recorder_Drain(void)
+ * @param None
+ * @return bytes sent
+ * @brief Sends up to RECORDER_DRAIN_BYTES of the ring to the UART if its
+ *        transmit queue is empty, and returns straight away if not. */
+uint16_t Recorder_Drain(void);
+
+/**
+ * @Function Recorder_GetStats(RecorderStats_t *pStats)
+ * @param pStats - filled with the counters since Recorder_Start()
+ * @return None */
+void Recorder_GetStats(RecorderStats_t *pStats);
+
+#endif /* RECORDER_H */
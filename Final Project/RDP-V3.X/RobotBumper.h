@@ -1,80 +0,0 @@
-/*
- * File: BumperService.h
- * Author: J. Edward Carryer
- * Modified: Gabriel H Elkaim
- *
- * Template file to set up a simple service to work with the Events and Services
- * Framework (ES_Framework) on the Uno32 for the CMPE-118/L class. Note that this file
- * will need to be modified to fit your exact needs, and most of the names will have
- * to be changed to match your code.
- *
- * This is provided as an example and a good place to start.
- *
- * Created on 23/Oct/2011
- * Updated on 13/Nov/2013
- */
-
-#ifndef Robot_Bumper_H  // <- This should be changed to your own guard on both
-#define Robot_Bumper_H  //    of these lines
-
-
-/*******************************************************************************
- * PUBLIC #INCLUDES                                                            *
- ******************************************************************************/
-
-#include "ES_Configure.h"   // defines ES_Event, INIT_EVENT, ENTRY_EVENT, and EXIT_EVENT
-
-/*******************************************************************************
- * PUBLIC #DEFINES                                                             *
- ******************************************************************************/
-
-
-/*******************************************************************************
- * PUBLIC TYPEDEFS                                                             *
- ******************************************************************************/
-
-
-/*******************************************************************************
- * PUBLIC FUNCTION PROTOTYPES                                                  *
- ******************************************************************************/
-
- 
-/**
- * @Function InitBumperService(uint8_t Priority)
- * @param Priority - internal variable to track which event queue to use
- * @return TRUE or FALSE
- * @brief This will get called by the framework at the beginning of the code
- *        execution. It will post an ES_INIT event to the appropriate event
- *        queue, which will be handled inside RunTemplateService function. Remember
- *        to rename this to something appropriate.
- *        Returns TRUE if successful, FALSE otherwise
- * @author J. Edward Carryer, 2011.10.23 19:25 */
-uint8_t InitRobotBumper(uint8_t Priority);
-
-//uint8_t InitBumperService(uint8_t Priority);
-/**
- * @Function PostTemplateService(ES_Event ThisEvent)
- * @param ThisEvent - the event (type and param) to be posted to queue
- * @return TRUE or FALSE
- * @brief This function is a wrapper to the queue posting function, and its name
- *        will be used inside ES_Configure to point to which queue events should
- *        be posted to. Remember to rename to something appropriate.
- *        Returns TRUE if successful, FALSE otherwise
- * @author J. Edward Carryer, 2011.10.23 19:25 */
-//uint8_t PostTemplateService(ES_Event ThisEvent);
-
-uint8_t PostRobotBumper(ES_Event ThisEvent);
-/**
- * @Function RunTemplateService(ES_Event ThisEvent)
- * @param ThisEvent - the event (type and param) to be responded.
- * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the service,
- *        as this is called any time a new event is passed to the event queue. 
- * @note Remember to rename to something appropriate.
- *       Returns ES_NO_EVENT if the event have been "consumed." 
- * @author J. Edward Carryer, 2011.10.23 19:25 */
-//ES_Event RunTemplateService(ES_Event ThisEvent);
-// add services 
-ES_Event RunRobotBumper(ES_Event ThisEvent);
-
-#endif /* Robot_Bumper_H */
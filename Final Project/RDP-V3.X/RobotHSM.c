@@ -31,66 +31,142 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "Robot.h"
+#include "Actuators.h"
+#include "Odometry.h"
 #include "SubHSM_Lookout.h" //#include all sub state machines called
 #include "SubHSM_Search.h"
 #include "SubHSM_Pursue.h"
 #include "SubHSM_Destroy.h"
 #include "SubHSM_Escape.h"
+#include "SensorDelta.h"
+#include "RobotSensors.h"
+#include "Recorder.h"
+#include "HSMStats.h"
 #include <stdio.h>
-
 /*******************************************************************************
  * PRIVATE #DEFINES                                                            *
  ******************************************************************************/
 //Include any defines you need to do
 
+// ParamMask of the ES_TIMEOUT rows, which only answer to this machine's timer
+#define HSM_TIMEOUT HSM_PARAM(HSM_TIMER)
+
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 
 
 typedef enum {
-    InitPState,
     Lookout,
     Search,
     Pursue,
-    Flank,
     Destroy,
     Escape,
 } TemplateHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPState",
-	"Lookout",
-	"Search",
-	"Pursue",
-	"Flank",
-	"Destroy",
-	"Escape",
-};
 
-#define Lookout_Timer 8500 //Timer for robot to make a full 360 turn
+#define LOOKOUT_TURN 360 //Degrees the robot turns through looking for the beacon
 #define Escape_Timer 2500 //A timer to allow robot to move away from beacon
 #define CANNON_TIMER 1350
-#define CHECK_TIMER 600
+#define DESTROY_BACK_TIMER 600 //Destroy backs along the tower this long before looking for its tape
 #define SPIN_TIMER 5000
 
+// sensor channels each state's rows, and its sub-state machine's, listen to
+// (RobotSensors_Attend); the rest are not run
+typedef struct {
+    uint8_t Watch;
+    uint8_t Fast; // wanted every sensor tick
+} Attention_t;
+
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
 /* Prototypes for private functions for this machine. They should be functions
    relevant to the behavior of this state machine
    Example: char RunAway(uint_8 seconds);*/
+
+static void InitAll(void);
+static void StartLookout(void);
+static void StartSpin(void);
+static void StartDestroy(void);
+static void StartEscape(void);
+static void RestartAttack(void);
+static void CannonOff(void);
+static void RunSensorDelta(void);
+static void FollowState(void);
+
 /*******************************************************************************
  * PRIVATE MODULE VARIABLES                                                            *
  ******************************************************************************/
 /* You will need MyPriority and the state variable; you may need others as well.
  * The type of state variable should match that of enum in header file. */
 
-static TemplateHSMState_t CurrentState = InitPState; // <- change enum name to match ENUM
 static uint8_t MyPriority;
 
+static const HSM_Transition_t LookoutRows[] = {
+    {Beacon_found, Pursue, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {TurnComplete, Search, HSM_CONSUME, HSM_CURRENT_PARAM, StartSpin},
+};
+
+static const HSM_Transition_t SearchRows[] = {
+    {ES_TIMEOUT, Lookout, HSM_CONSUME, HSM_TIMEOUT, StartLookout},
+    {Beacon_found, Pursue, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t PursueRows[] = {
+    {Wall_found, Destroy, HSM_CONSUME, HSM_ANY_PARAM, StartDestroy},
+    {GoSeeking, Lookout, HSM_CONSUME, HSM_ANY_PARAM, StartLookout},
+};
+
+static const HSM_Transition_t DestroyRows[] = {
+    {Ball_deposit, Escape, HSM_CONSUME, HSM_ANY_PARAM, StartEscape},
+};
+
+static const HSM_Transition_t EscapeRows[] = {
+    {ES_TIMEOUT, Lookout, HSM_CONSUME, HSM_TIMEOUT, RestartAttack},
+};
+
+static const HSM_State_t States[] = {
+    [Lookout] =
+    {"Lookout", HSM_EV(Beacon_found) | HSM_EV(TurnComplete),
+        HSM_ROWS(LookoutRows), NULL, NULL, NULL, &SubHSM_LookoutMachine},
+    [Search] =
+    {"Search", HSM_EV(ES_TIMEOUT) | HSM_EV(Beacon_found),
+        HSM_ROWS(SearchRows), NULL, NULL, NULL, &SubHSM_SearchMachine},
+    [Pursue] =
+    {"Pursue", HSM_EV(Wall_found) | HSM_EV(GoSeeking),
+        HSM_ROWS(PursueRows), NULL, NULL, NULL, &SubHSM_PursueMachine},
+    [Destroy] =
+    {"Destroy", HSM_EV(Ball_deposit),
+        HSM_ROWS(DestroyRows), NULL, NULL, NULL, &SubHSM_DestroyMachine},
+    [Escape] =
+    {"Escape", HSM_EV(ES_TIMEOUT),
+        HSM_ROWS(EscapeRows), CannonOff, CannonOff, CannonOff, &SubHSM_EscapeMachine},
+};
+
+static const Attention_t Attention[] = {
+    [Lookout] =
+    {SENSOR_BEACON | SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP, 0},
+    [Search] =
+    {SENSOR_BEACON | SENSOR_RIGHT_TAPE | SENSOR_LEFT_TAPE, 0},
+    [Pursue] =
+    {SENSOR_BEACON | SENSOR_RIGHT_TAPE | SENSOR_LEFT_TAPE,
+        SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP | SENSOR_SIDE_BUMP | SENSOR_TRACK_WIRE},
+    [Destroy] =
+    {0, SENSOR_CANNON_TAPE},
+    [Escape] =
+    {0, 0},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
+static uint8_t AttendedState; // whose Attention RobotSensors has
+
+const HSM_Machine_t RobotHSMMachine = {
+    "RobotHSM", HSM_STATES(States), Lookout, InitAll, &CurrentState
+};
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -108,8 +184,15 @@ static uint8_t MyPriority;
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitRobotHSM(uint8_t Priority) {
     MyPriority = Priority;
-    // put us into the Initial PseudoState
-    CurrentState = InitPState;
+    // not started until the ES_INIT below is run
+    CurrentState = HSM_NOT_STARTED;
+    AttendedState = HSM_NOT_STARTED;
+    // the framework has just emptied our queue, drop any deltas it held
+    SensorDelta_Init();
+    // every motor stopped, and from here on set through the shadow
+    Actuators_Init();
+    // before the machines start, so they take their slots in it from scratch
+    HSMStats_Init();
     // post the initial transition event
     if (ES_PostToService(MyPriority, INIT_EVENT) == TRUE) {
         return TRUE;
@@ -128,142 +211,45 @@ uint8_t InitRobotHSM(uint8_t Priority) {
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t PostRobotHSM(ES_Event ThisEvent) {
-    return ES_PostToService(MyPriority, ThisEvent);
+    if (ES_PostToService(MyPriority, ThisEvent) == FALSE) {
+        return FALSE;
+    }
+    HSMStats_Posted(ThisEvent);
+    return TRUE;
 }
 
 /**
  * @Function RunTemplateHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Starts the robot's state table on ES_INIT, then runs it for every
+ *        other event; see HSM.h for the dispatch rules. The sub-state machine
+ *        of the current state sees each event before this level does. A
+ *        SensorDelta is run as the per-channel events it stands for.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunRobotHSM(ES_Event ThisEvent) {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateHSMState_t nextState; // <- change type to correct enum
+    ES_Event Posted = ThisEvent; // as it came, ThisEvent is cleared if consumed
 
     ES_Tattle(); // trace call stack
+    Recorder_Event(MyPriority, ThisEvent);
 
-    switch (CurrentState) {
-        case InitPState: // If current state is initial Pseudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-            {
-                // this is where you would put any actions associated with the
-                // transition from the initial pseudo-state into the actual
-                // initial state
-                // Initialize all sub-state machines
-                InitSubHSM_Lookout();
-                InitSubHSM_Search();
-                InitSubHSM_Pursue();
-                InitSubHSM_Destroy();
-                //            InitSubHSM_Escape();
-                // now put the machine into the actual initial state
-                nextState = Lookout;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-                ES_Timer_InitTimer(HSM_TIMER, Lookout_Timer);
-            }
-            break;
-        case Lookout:
-            //        ES_Timer_InitTimer(HSM_TIMER, Lookout_Timer);
-            ThisEvent = RunSubHSM_Lookout(ThisEvent);
-            if (ThisEvent.EventType == Beacon_found) {
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == HSM_TIMER) {
-                    nextState = Search;
-                    ES_Timer_InitTimer(HSM_TIMER, SPIN_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-            break;
-        case Search: // in the first state, replace this with correct names
-            // run sub-state machine for this state
-            //NOTE: the SubState Machine runs and responds to events before anything in the this
-            //state machine does
-            ThisEvent = RunSubHSM_Search(ThisEvent);
-            if (ThisEvent.EventType == Beacon_found) {
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == HSM_TIMER) {
-                    nextState = Lookout;
-                    ES_Timer_InitTimer(HSM_TIMER, Lookout_Timer);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-            break;
-        case Pursue:
-            ThisEvent = RunSubHSM_Pursue(ThisEvent);
-            if (ThisEvent.EventType == Wall_found) {
-                nextState = Destroy;
-                ES_Timer_InitTimer(HSM_TIMER, CHECK_TIMER);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-
-            }
-            else if (ThisEvent.EventType == GoSeeking) {
-                nextState = Lookout;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-        case Destroy:
-            ThisEvent = RunSubHSM_Destroy(ThisEvent);
-            if (ThisEvent.EventType == Ball_deposit) {
-                int j;
-                for (j = 0; j < 30000; j++) {
-                    asm("nop");
-                }
-                nextState = Escape;
-                ES_Timer_InitTimer(HSM_TIMER, Escape_Timer);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-        case Escape:
-            ThisEvent = RunSubHSM_Escape(ThisEvent);
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == HSM_TIMER) {
-                    //                    InitSubHSM_Search();
-                    InitSubHSM_Pursue();
-                    InitSubHSM_Destroy();
-                    nextState = Lookout;
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-            //            else {
-            ////                printf("Escape \n");
-            //                Robot_RightMtrSpeed(-85);
-            //                Robot_LeftMtrSpeed(85);
-            CannonMtrSpeed(0);
-            //            }
-            break;
-        default: // all unhandled states fall into here
-            break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunRobotHSM(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunRobotHSM(ENTRY_EVENT); // <- rename to your own Run function
+    if (ThisEvent.EventType == ES_INIT) {
+        if (HSM_Init(&RobotHSMMachine) == TRUE) {
+            ThisEvent.EventType = ES_NO_EVENT;
+        }
+    } else if (ThisEvent.EventType == SensorDelta) {
+        RunSensorDelta();
+        ThisEvent.EventType = ES_NO_EVENT;
+    } else if ((ThisEvent.EventType == ES_KEYINPUT)
+            && (ThisEvent.EventParam == HSMSTATS_DUMP_KEY)) {
+        HSMStats_Dump();
+        ThisEvent.EventType = ES_NO_EVENT;
+    } else {
+        ThisEvent = HSM_Run(&RobotHSMMachine, ThisEvent);
     }
+    FollowState();
+    HSMStats_Handled(Posted);
 
     ES_Tail(); // trace call stack end
     return ThisEvent;
@@ -273,3 +259,76 @@ ES_Event RunRobotHSM(ES_Event ThisEvent) {
 /*******************************************************************************
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
+
+static void InitAll(void) { // Initialize all sub-state machines
+    InitSubHSM_Lookout();
+    InitSubHSM_Search();
+    InitSubHSM_Pursue();
+    InitSubHSM_Destroy();
+    //            InitSubHSM_Escape();
+    // the first Lookout spin is the sensors' look at the field
+    RobotSensors_Calibrate(TRUE);
+    Odometry_Turn(LOOKOUT_TURN, PostRobotHSM);
+}
+
+static void StartLookout(void) {
+    Odometry_Turn(LOOKOUT_TURN, PostRobotHSM);
+}
+
+static void StartSpin(void) {
+    ES_Timer_InitTimer(HSM_TIMER, SPIN_TIMER);
+}
+
+static void StartDestroy(void) {
+    ES_Timer_InitTimer(HSM_TIMER, DESTROY_BACK_TIMER);
+}
+
+static void StartEscape(void) {
+    ES_Timer_InitTimer(HSM_TIMER, Escape_Timer);
+}
+
+static void RestartAttack(void) { // next beacon starts Pursue and Destroy from the top
+    //                    InitSubHSM_Search();
+    InitSubHSM_Pursue();
+    InitSubHSM_Destroy();
+    StartLookout();
+}
+
+static void CannonOff(void) {
+    Actuators_Cannon(0);
+}
+
+/**
+ * @Function RunSensorDelta(void)
+ * @param None
+ * @return None
+ * @brief Runs each edge of the oldest waiting delta through the state table,
+ *        in channel order, which is the order the sensor services used to
+ *        post them in. */
+static void RunSensorDelta(void) {
+    SensorDelta_t Delta;
+    uint8_t Channel;
+
+    if (SensorDelta_Take(&Delta) == FALSE) {
+        return;
+    }
+    for (Channel = 0; Channel < SENSOR_CHANNELS; Channel++) {
+        if (Delta.Changed & (1 << Channel)) {
+            HSM_Run(&RobotHSMMachine, SensorDelta_ChannelEvent(&Delta, Channel));
+        }
+    }
+}
+
+/**
+ * @Function FollowState(void)
+ * @param None
+ * @return None
+ * @brief Tells RobotSensors which channels the state just entered listens to,
+ *        once per change of state. */
+static void FollowState(void) {
+    if ((CurrentState == AttendedState) || (CurrentState == HSM_NOT_STARTED)) {
+        return;
+    }
+    RobotSensors_Attend(Attention[CurrentState].Watch, Attention[CurrentState].Fast);
+    AttendedState = CurrentState;
+}
@@ -26,6 +26,7 @@
  ******************************************************************************/
 
 #include "ES_Configure.h"   // defines ES_Event, INIT_EVENT, ENTRY_EVENT, and EXIT_EVENT
+#include "HSM.h"
 
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
@@ -36,6 +37,9 @@
  * PUBLIC TYPEDEFS                                                             *
  ******************************************************************************/
 
+// state table, for HSM_GetState() and HSM_GetStateName()
+extern const HSM_Machine_t RobotHSMMachine;
+
 
 /*******************************************************************************
  * PUBLIC FUNCTION PROTOTYPES                                                  *
@@ -0,0 +1,596 @@
+/*
+ * File: RobotSensors.c
+ *
+ * The robot's sensor service, see RobotSensors.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "AD.h"
+#include "ADAcquire.h"
+#include "BumperNotify.h"
+#include "Calibrate.h"
+#include "Comparator.h"
+#include "Debounce.h"
+#include "Goertzel.h"
+#include "HSMStats.h"
+#include "Odometry.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "pwm.h"
+#include "Recorder.h"
+#include "Robot.h"
+#include "RobotSensors.h"
+#include "SensorDelta.h"
+#include "SensorSnapshot.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define SENSOR_TICK_MS 5
+
+// TRUE to record the run (Recorder.h) from startup and send it out of the
+// UART, which then carries nothing else: leave every printf off
+#define RECORD_FIELD_RUN FALSE
+
+// TRUE to find the beacon by its tone, with a Goertzel detector on every
+// conversion of BEACON_PIN, for a detector that passes the tone through;
+// the beacon board on the robot puts out a DC level instead, low while it
+// hears the beacon, which is read against BEACON_THRESHOLD
+#define BEACON_GOERTZEL FALSE
+
+// analog channels, in comparator bank order, which is the snapshot's
+#define CANNON_TAPE SNAPSHOT_CANNON_TAPE
+#define RIGHT_TAPE SNAPSHOT_RIGHT_TAPE
+#define LEFT_TAPE SNAPSHOT_LEFT_TAPE
+#define FRONT_TRACK SNAPSHOT_FRONT_TRACK
+#define REAR_TRACK SNAPSHOT_REAR_TRACK
+#define NUM_ANALOG SNAPSHOT_ANALOG
+
+#define TAPE_PINS (AD_PORTV6 | AD_PORTV4 | AD_PORTV3)
+#define BEACON_PIN AD_PORTW6
+#define TRACK_WIRE_PINS (AD_PORTW7 | AD_PORTW8)
+
+#define SENSOR_AD_PINS (TAPE_PINS | BEACON_PIN | TRACK_WIRE_PINS | BAT_VOLTAGE)
+
+// sensor ticks between the battery readings passed to Odometry
+#define BATTERY_TICKS 100
+
+// AD counts either side of a threshold before a channel switches
+#define AD_HYSTERESIS 25
+
+// learned thresholds (RobotSensors_Calibrate): each channel keeps the
+// statistics of its baseline readings, over about the last CALIBRATE_WINDOW
+// ticks, and its threshold goes CALIBRATE_SIGMAS deviations from their mean
+// on the active side, or the channel's MinMargin if that is further. The
+// first CALIBRATE_SETTLE_TICKS are left out while the filters fill; the
+// thresholds are first set once CALIBRATE_MIN_SAMPLES are in, about 5 s into
+// the startup spin, then every CALIBRATE_UPDATE_TICKS.
+#define CALIBRATE_WINDOW 4096
+#define CALIBRATE_MIN_SAMPLES 1024
+#define CALIBRATE_SIGMAS 3
+#define CALIBRATE_SETTLE_TICKS 20
+#define CALIBRATE_UPDATE_TICKS 200
+
+// filtering as each scan is taken, at AD_SCANS_PER_MS scans per ms: the tape
+// sensors are averaged over 8 scans, the track wire coils low passed at about
+// 45 Hz; the beacon is left as converted
+#define TAPE_AVERAGE 8
+#define TRACK_WIRE_ALPHA Q15(0.25)
+
+// the tape emitters run off one PWM output at half duty, as TapeSensor
+// drove them
+#define TAPE_EMITTER PWM_PORTZ06
+#define TAPE_EMITTER_DUTY 500
+
+// the beacon board's level, active low, as Beacon read it
+#define BEACON_THRESHOLD 300
+
+// beacon tone (BEACON_GOERTZEL), listened for on every conversion of BEACON_PIN in 40 ms
+// blocks (25 Hz bins); the tone has to fit under half the scan rate
+#define BEACON_TONE_HZ 250
+#define BEACON_SAMPLE_HZ (AD_SCANS_PER_MS * 1000)
+#define BEACON_BLOCK 40
+#define BEACON_MIN_MAGNITUDE 20 // AD counts of tone amplitude
+#define BEACON_CHANNEL __builtin_ctz(SENSOR_BEACON)
+
+// bumper edges from the front bumpers' interrupts (BumperNotify): the first
+// opens a window that is held until the bumpers have been still for
+// BUMPER_SETTLE_MS, and they are read when it closes; the window is the
+// port's, so one bumper's bounce holds back another's change. A change the
+// polled debouncer finds with no edge heard for BUMPER_FALLBACK_MS, as long
+// as it takes the debouncer, is taken as one the interrupts missed; the side
+// bumper has no interrupt and is only ever found this way.
+#define BUMPER_SETTLE_MS 5
+#define BUMPER_FALLBACK_MS (DEBOUNCE_SAMPLES * SENSOR_TICK_MS)
+
+// a BumperEdge carries the port in its low bits and the low bits of the ms
+// of the edge above them
+#define BUMPER_PORT_BITS 3
+#define BUMPER_TIME_MASK (0xFFFF >> BUMPER_PORT_BITS)
+
+// Groups[] indexes of the bumpers, whose settled changes are posted as they
+// come, and of the beacon, whose detector is only run while watched
+#define BUMPER_GROUP 0
+#define BEACON_GROUP 3
+
+#define CHANNEL(Channel) (1 << (Channel))
+#define NUM_GROUPS (sizeof (Groups) / sizeof (Groups[0]))
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    unsigned int Pin;
+    uint16_t Threshold; // AD counts, until one is learned
+    uint16_t MinMargin; // AD counts between a learned threshold and the mean
+    uint8_t ActiveLow;
+} AnalogChannel_t;
+
+typedef struct {
+    uint8_t (*Levels)(void); // active SENSOR_* bits of the group
+    uint8_t Channels; // SENSOR_* bits the group owns
+    uint8_t Period; // sensor ticks while watched, 1 when watched fast
+} Group_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint8_t SetFilters(void);
+static void SetThreshold(uint8_t Channel, uint16_t Threshold);
+static void LearnThresholds(void);
+static void TakeSnapshot(void);
+static void ReadBattery(void);
+static void BumperChanged(unsigned char Port, uint32_t Ms);
+static void OpenBumperWindow(uint16_t Param);
+static void SettleBumpers(void);
+static void PollBumpers(void);
+static uint8_t BumperLevels(void);
+static uint8_t TapeLevels(void);
+static uint8_t TrackWireLevels(void);
+static uint8_t BeaconLevels(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// indexed by analog channel; the right tape sensor and the track wire read
+// high when active
+static const AnalogChannel_t AnalogChannels[NUM_ANALOG] = {
+    {AD_PORTV6, 300, 100, TRUE},
+    {AD_PORTV4, 700, 100, FALSE},
+    {AD_PORTV3, 300, 100, TRUE},
+    {AD_PORTW7, 850, 200, FALSE},
+    {AD_PORTW8, 850, 200, FALSE},
+};
+
+static const Group_t Groups[] = {
+    {BumperLevels, SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP | SENSOR_SIDE_BUMP, 2},
+    {TapeLevels, SENSOR_CANNON_TAPE | SENSOR_RIGHT_TAPE | SENSOR_LEFT_TAPE, 9},
+    {TrackWireLevels, SENSOR_TRACK_WIRE, 3},
+    {BeaconLevels, SENSOR_BEACON, 4},
+};
+
+static uint8_t MyPriority;
+static SensorSnapshot_t Snapshot; // every input as it was at the start of the tick
+static ComparatorBank_t Analog;
+static Debouncer_t Bumpers;
+static uint8_t Polled; // debounced bumpers as last seen
+static uint8_t Confirmed; // bumpers as last settled, by either path
+static uint8_t BumperWindow; // TRUE from an edge until the bumpers are still
+static uint32_t LastBumperEdge; // ms
+static Goertzel_t Beacon;
+static ComparatorBank_t BeaconLevel; // one channel, unless BEACON_GOERTZEL
+static Calibration_t Calibrations[NUM_ANALOG];
+static uint8_t Calibrating;
+static uint16_t CalibrateCountdown; // ticks until the next learned thresholds
+static uint8_t CalibrateSettle; // ticks before the first readings are learned
+static uint8_t Period[NUM_GROUPS]; // sensor ticks, 0 while not watched
+static uint8_t Countdown[NUM_GROUPS]; // ticks until each group is due
+static uint8_t Skipped; // groups that have let a tick go by unwatched
+static uint8_t Resync; // groups whose next levels are taken without edges
+static uint8_t Levels; // as last posted to SensorDelta
+static uint16_t Battery; // AD counts, as last read
+static uint8_t BatteryCountdown; // ticks until it is next passed on
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitRobotSensors(uint8_t Priority)
+{
+    ES_Event ThisEvent;
+    uint8_t i;
+
+    MyPriority = Priority;
+    if (RECORD_FIELD_RUN) {
+        Recorder_Start();
+    }
+    Debounce_Init(&Bumpers, 0);
+    Polled = Confirmed = 0;
+    BumperWindow = FALSE;
+    LastBumperEdge = ES_Timer_GetTime() - BUMPER_FALLBACK_MS;
+    if (Goertzel_Init(&Beacon, BEACON_TONE_HZ, BEACON_SAMPLE_HZ, BEACON_BLOCK,
+            BEACON_MIN_MAGNITUDE) == ERROR) {
+        return FALSE;
+    }
+    Comparator_Init(&BeaconLevel, 1);
+    Comparator_SetChannel(&BeaconLevel, 0, BEACON_THRESHOLD, AD_HYSTERESIS, TRUE);
+    Comparator_Init(&Analog, NUM_ANALOG);
+    RobotSensors_Calibrate(FALSE);
+    for (i = 0; i < NUM_GROUPS; i++) {
+        Period[i] = Groups[i].Period;
+        Countdown[i] = 1;
+    }
+    Skipped = Resync = 0;
+    Levels = 0;
+    Battery = ODOMETRY_FULL_BATTERY;
+    BatteryCountdown = 0;
+    SensorSnapshot_Init();
+    if (SetFilters() == FALSE) {
+        return FALSE;
+    }
+    // the emitters are started once, here, and left running
+    PWM_AddPins(TAPE_EMITTER);
+    PWM_SetDutyCycle(TAPE_EMITTER, TAPE_EMITTER_DUTY);
+    BumperNotify_Init(BumperChanged);
+    if (ADAcquire_Subscribe(SENSOR_AD_PINS, PostRobotSensors, SENSOR_TICK_MS * AD_SCANS_PER_MS,
+            0) == FALSE) {
+        return FALSE;
+    }
+    ThisEvent.EventType = ES_INIT;
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+void RobotSensors_Calibrate(uint8_t On)
+{
+    uint8_t i;
+
+    for (i = 0; i < NUM_ANALOG; i++) {
+        Calibrate_Init(&Calibrations[i], CALIBRATE_WINDOW);
+        SetThreshold(i, AnalogChannels[i].Threshold);
+    }
+    CalibrateCountdown = CALIBRATE_UPDATE_TICKS;
+    CalibrateSettle = CALIBRATE_SETTLE_TICKS;
+    Calibrating = On;
+}
+
+void RobotSensors_Attend(uint8_t Watch, uint8_t Fast)
+{
+    uint8_t NewPeriod;
+    uint8_t i;
+
+    for (i = 0; i < NUM_GROUPS; i++) {
+        NewPeriod = (Fast & Groups[i].Channels) ? 1
+                : (Watch & Groups[i].Channels) ? Groups[i].Period : 0;
+        if (NewPeriod == Period[i]) {
+            continue;
+        }
+        if ((Period[i] == 0) && (Skipped & CHANNEL(i))) {
+            // back on the next tick, from the levels it has then
+            Resync |= CHANNEL(i);
+            Skipped &= ~CHANNEL(i);
+            Countdown[i] = 1;
+        } else if (NewPeriod && (Countdown[i] > NewPeriod)) {
+            Countdown[i] = NewPeriod;
+        }
+        Period[i] = NewPeriod;
+    }
+}
+
+uint8_t RobotSensors_GetWatched(void)
+{
+    uint8_t Watched = 0;
+    uint8_t i;
+
+    for (i = 0; i < NUM_GROUPS; i++) {
+        if (Period[i]) {
+            Watched |= Groups[i].Channels;
+        }
+    }
+    return Watched;
+}
+
+uint8_t PostRobotSensors(ES_Event ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunRobotSensors(ES_Event ThisEvent)
+{
+    ES_Event ReturnEvent;
+    uint8_t Due = 0, NewLevels = 0, Quiet = 0;
+    uint8_t i;
+
+    ReturnEvent.EventType = ES_NO_EVENT;
+    Recorder_Event(MyPriority, ThisEvent);
+    switch (ThisEvent.EventType) {
+    case NewADSamples:
+        TakeSnapshot();
+        ReadBattery();
+        // every input follows every tick, whichever groups are due
+        Debounce_Update(&Bumpers, Snapshot.Bumpers);
+        PollBumpers();
+        // a moved threshold resets its channel, which the update puts back
+        if (Calibrating) {
+            LearnThresholds();
+        }
+        Comparator_Update(&Analog, Snapshot.Analog);
+        // a group nobody is watching keeps its last levels
+        for (i = 0; i < NUM_GROUPS; i++) {
+            if (Period[i] == 0) {
+                Skipped |= CHANNEL(i);
+            } else if (--Countdown[i] == 0) {
+                Countdown[i] = Period[i];
+                Due |= Groups[i].Channels;
+                NewLevels |= Groups[i].Levels() & Groups[i].Channels;
+                if (Resync & CHANNEL(i)) {
+                    Quiet |= Groups[i].Channels;
+                }
+            }
+        }
+        Resync = 0;
+        NewLevels |= Levels & ~Due;
+        // every edge of the tick goes to RobotHSM as one event, less the
+        // ones a group that was not watched missed
+        SensorDelta_Post((NewLevels ^ Levels) & ~Quiet, NewLevels);
+        Levels = NewLevels;
+        Snapshot.Levels = Levels;
+        if (BEACON_GOERTZEL) {
+            Snapshot.Beacon = Goertzel_Magnitude(&Beacon);
+        }
+        SensorSnapshot_Publish(&Snapshot);
+        Recorder_Drain();
+        HSMStats_Tick();
+        break;
+
+    case BumperEdge:
+        OpenBumperWindow(ThisEvent.EventParam);
+        break;
+
+    case ES_TIMEOUT:
+        if (ThisEvent.EventParam == BUMPER_TIMER) {
+            SettleBumpers();
+        }
+        break;
+
+    default:
+        break;
+    }
+    return ReturnEvent;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint8_t SetFilters(void)
+{
+    ADFilter_t Filter;
+    uint8_t Set = TRUE, i;
+
+    ADFilter_InitAverage(&Filter, TAPE_AVERAGE);
+    for (i = CANNON_TAPE; i <= LEFT_TAPE; i++) {
+        Set &= ADAcquire_SetFilter(AnalogChannels[i].Pin, &Filter);
+    }
+    ADFilter_InitIIR(&Filter, TRACK_WIRE_ALPHA);
+    Set &= ADAcquire_SetFilter(AnalogChannels[FRONT_TRACK].Pin, &Filter);
+    Set &= ADAcquire_SetFilter(AnalogChannels[REAR_TRACK].Pin, &Filter);
+    return Set;
+}
+
+/* also makes the channel inactive until the next Comparator_Update() */
+static void SetThreshold(uint8_t Channel, uint16_t Threshold)
+{
+    Comparator_SetChannel(&Analog, Channel, Threshold, AD_HYSTERESIS,
+            AnalogChannels[Channel].ActiveLow);
+}
+
+/*
+ * Adds this tick's readings to the statistics and, when it is time, moves the
+ * thresholds. A reading more than the channel's MinMargin from the mean on the
+ * active side is not taken as baseline, so the tape and the wire stay out of
+ * the statistics; the mean, not the threshold, decides, so a floor that is
+ * all on the active side of the fixed threshold is still learned.
+ */
+static void LearnThresholds(void)
+{
+    const AnalogChannel_t *pChannel;
+    Calibration_t *pCalibration;
+    uint16_t Input, Mean, Threshold;
+    uint8_t Update = FALSE;
+    uint8_t i;
+
+    if (CalibrateSettle) {
+        CalibrateSettle--;
+        return;
+    }
+    if (--CalibrateCountdown == 0) {
+        CalibrateCountdown = CALIBRATE_UPDATE_TICKS;
+        Update = TRUE;
+    }
+    for (i = 0; i < NUM_ANALOG; i++) {
+        pChannel = &AnalogChannels[i];
+        pCalibration = &Calibrations[i];
+        Input = Snapshot.Analog[i];
+        Mean = Calibrate_Mean(pCalibration);
+        if ((Calibrate_Count(pCalibration) == 0) || (pChannel->ActiveLow
+                ? (Input + pChannel->MinMargin > Mean) : (Input < Mean + pChannel->MinMargin))) {
+            Calibrate_Add(pCalibration, Input);
+        }
+        if (Update && (Calibrate_Count(pCalibration) >= CALIBRATE_MIN_SAMPLES)) {
+            Threshold = Calibrate_Threshold(pCalibration, CALIBRATE_SIGMAS, pChannel->MinMargin,
+                    pChannel->ActiveLow);
+            SetThreshold(i, (Threshold > AD_MAX_VALUE) ? AD_MAX_VALUE : Threshold);
+        }
+    }
+}
+
+static void TakeSnapshot(void)
+{
+    uint16_t Sample;
+    uint8_t i;
+
+    Snapshot.Time = ES_Timer_GetTime();
+    // a pin with nothing new since the last tick keeps its last value;
+    // whatever is read is recorded, for host/replay to feed back
+    for (i = 0; i < NUM_ANALOG; i++) {
+        if (ADAcquire_Latest(AnalogChannels[i].Pin, &Snapshot.Analog[i])) {
+            Recorder_AD(AnalogChannels[i].Pin, Snapshot.Analog[i]);
+        }
+    }
+    // the beacon tone detector wants every conversion, while it is watched;
+    // otherwise they are thrown away, and the first block after it is
+    // watched again is part old, which its confidence count rides out
+    if (!BEACON_GOERTZEL) {
+        if (ADAcquire_Latest(BEACON_PIN, &Snapshot.Beacon)) {
+            Recorder_AD(BEACON_PIN, Snapshot.Beacon);
+        }
+    } else if (Period[BEACON_GROUP]) {
+        while (ADAcquire_Read(BEACON_PIN, &Sample)) {
+            Recorder_AD(BEACON_PIN, Sample);
+            Goertzel_Step(&Beacon, Sample);
+        }
+    } else {
+        ADAcquire_Latest(BEACON_PIN, &Sample);
+    }
+    Snapshot.Bumpers = Robot_ReadBumpers();
+    Recorder_Bumpers(Snapshot.Bumpers);
+}
+
+/* the battery is read every tick, so its ring never backs up, but only
+ * passed to Odometry, and recorded, every BATTERY_TICKS */
+static void ReadBattery(void)
+{
+    ADAcquire_Latest(BAT_VOLTAGE, &Battery);
+    if (BatteryCountdown) {
+        BatteryCountdown--;
+        return;
+    }
+    BatteryCountdown = BATTERY_TICKS - 1;
+    Recorder_AD(BAT_VOLTAGE, Battery);
+    Odometry_SetBattery(Battery);
+}
+
+/* the bumper hook, run from the BumperNotify_CheckEdge() event checker with
+ * the edge the CN or INT4 interrupt latched: it is posted with its ms, and
+ * the service does the rest */
+static void BumperChanged(unsigned char Port, uint32_t Ms)
+{
+    ES_Event ThisEvent;
+
+    ThisEvent.EventType = BumperEdge;
+    ThisEvent.EventParam = (uint16_t) (Ms << BUMPER_PORT_BITS) | Port;
+    PostRobotSensors(ThisEvent);
+}
+
+static void OpenBumperWindow(uint16_t Param)
+{
+    uint32_t Now = ES_Timer_GetTime();
+
+    // the edge was at most a few ms ago, so its low bits are enough
+    LastBumperEdge = Now - ((Now - (Param >> BUMPER_PORT_BITS)) & BUMPER_TIME_MASK);
+    if (!BumperWindow) {
+        BumperWindow = TRUE;
+        ES_Timer_InitTimer(BUMPER_TIMER, BUMPER_SETTLE_MS);
+    }
+}
+
+/*
+ * Closes the window once the last edge is BUMPER_SETTLE_MS old, or holds it
+ * open for the rest of that. A settled change is posted now if RobotHSM is
+ * watching the bumpers; if not, or the group is about to be taken up again
+ * without edges, it waits for the group.
+ */
+static void SettleBumpers(void)
+{
+    uint32_t Still = ES_Timer_GetTime() - LastBumperEdge;
+    uint8_t Port, NewLevels;
+
+    if (Still < BUMPER_SETTLE_MS) {
+        ES_Timer_InitTimer(BUMPER_TIMER, BUMPER_SETTLE_MS - Still);
+        return;
+    }
+    BumperWindow = FALSE;
+    // an edge latched since the last event check is not still yet; its
+    // BumperEdge, posted now, opens the window again
+    if (BumperNotify_CheckEdge()) {
+        return;
+    }
+    Port = Robot_ReadBumpers();
+    Recorder_Bumpers(Port);
+    // a bumper without an interrupt may be bouncing; only its debouncer has it
+    Port = (Port & BUMPER_NOTIFY_PINS) | (Confirmed & ~BUMPER_NOTIFY_PINS);
+    // the same as before is a glitch, or the fallback got there first
+    if (Port == Confirmed) {
+        return;
+    }
+    Confirmed = Port;
+    if ((Period[BUMPER_GROUP] == 0) || (Resync & CHANNEL(BUMPER_GROUP))) {
+        return;
+    }
+    NewLevels = (Levels & ~Groups[BUMPER_GROUP].Channels) | BumperLevels();
+    SensorDelta_Post(NewLevels ^ Levels, NewLevels);
+    Levels = NewLevels;
+}
+
+/* the fallback, for edges the interrupts lost, and the
+ * only way in for the bumpers that have no interrupt */
+static void PollBumpers(void)
+{
+    uint8_t Pressed = Debounce_State(&Bumpers);
+
+    if (Pressed == Polled) {
+        return;
+    }
+    Polled = Pressed;
+    if (!BumperWindow && ((ES_Timer_GetTime() - LastBumperEdge) >= BUMPER_FALLBACK_MS)) {
+        Confirmed = Pressed;
+    } else {
+        Confirmed = (Confirmed & BUMPER_NOTIFY_PINS) | (Pressed & ~BUMPER_NOTIFY_PINS);
+    }
+}
+
+static uint8_t BumperLevels(void)
+{
+    return ((Confirmed & FRONT_RIGHT_BUMPER) ? SENSOR_RIGHT_BUMP : 0)
+            | ((Confirmed & FRONT_LEFT_BUMPER) ? SENSOR_LEFT_BUMP : 0)
+            | ((Confirmed & SIDE_BUMPER) ? SENSOR_SIDE_BUMP : 0);
+}
+
+static uint8_t TapeLevels(void)
+{
+    uint8_t Active = Comparator_Active(&Analog);
+
+    return ((Active & CHANNEL(CANNON_TAPE)) ? SENSOR_CANNON_TAPE : 0)
+            | ((Active & CHANNEL(RIGHT_TAPE)) ? SENSOR_RIGHT_TAPE : 0)
+            | ((Active & CHANNEL(LEFT_TAPE)) ? SENSOR_LEFT_TAPE : 0);
+}
+
+/* both coils over the threshold */
+static uint8_t TrackWireLevels(void)
+{
+    uint8_t Coils = CHANNEL(FRONT_TRACK) | CHANNEL(REAR_TRACK);
+
+    return ((Comparator_Active(&Analog) & Coils) == Coils) ? SENSOR_TRACK_WIRE : 0;
+}
+
+/* the reading, or the tone magnitude, goes with the edge as its EventParam */
+static uint8_t BeaconLevels(void)
+{
+    if (BEACON_GOERTZEL) {
+        SensorDelta_SetParam(BEACON_CHANNEL, Goertzel_Magnitude(&Beacon));
+        return Goertzel_Found(&Beacon) ? SENSOR_BEACON : 0;
+    }
+    Comparator_Update(&BeaconLevel, &Snapshot.Beacon);
+    SensorDelta_SetParam(BEACON_CHANNEL, Snapshot.Beacon);
+    return Comparator_Active(&BeaconLevel) ? SENSOR_BEACON : 0;
+}
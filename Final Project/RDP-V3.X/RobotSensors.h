@@ -0,0 +1,110 @@
+/*
+ * File: RobotSensors.h
+ *
+ * One ES service for every sensor on the robot: the three bumpers, the three
+ * tape sensors, the track wire pair and the beacon detector. It runs on a
+ * 5 ms tick taken from the ADAcquire scan wakeup, reads all of its inputs
+ * once at the start of the tick, runs whichever channel groups are due on it
+ * (bumpers every 10 ms, tape every 45 ms, track wire every 15 ms, beacon
+ * every 20 ms) and posts every edge found to RobotHSM as one SensorDelta.
+ * The inputs of the tick, with its time and the levels posted, are then
+ * published as a SensorSnapshot for any service to read whole.
+ * RobotHSM says which channels its current state listens to
+ * (RobotSensors_Attend): a group with none of them is not run, and one it
+ * wants fast is run every tick.
+ *
+ * The tape and track wire pins are filtered as each scan is taken (ADFilter).
+ * The analog inputs then go through one Comparator bank, updated every tick,
+ * so each threshold has a band of AD_HYSTERESIS counts either side of it and
+ * a reading hovering about the threshold no longer chatters. The beacon
+ * board's output level gets a band of its own, and Beacon_found carries the
+ * reading. Built with BEACON_GOERTZEL, for a detector that passes the tone
+ * through, the beacon is found by listening for its tone with a Goertzel
+ * detector on every conversion of its pin instead, and Beacon_found carries
+ * the tone magnitude.
+ * The tape and track wire thresholds can be learned on the field instead
+ * (RobotSensors_Calibrate): each analog channel keeps the running mean and
+ * deviation of its baseline readings (Calibrate) and its threshold is put a
+ * few deviations from the mean, first after 5 s of the startup spin and then
+ * every second, so they follow a floor or a wire that reads differently.
+ * A front bumper edge comes in on an interrupt (BumperNotify), which latches
+ * it with its time for an event checker to post; once the bumpers have been still for BUMPER_SETTLE_MS
+ * they are read and a change goes to RobotHSM straight away, not at the next
+ * group tick, so a contact is heard a few ms after it bounces to rest. The
+ * bumpers are still polled and debounced together with a Debounce vertical
+ * counter as the fallback: a press that shows up there, DEBOUNCE_SAMPLES
+ * ticks after it settles, with no edge heard in that time is taken as one
+ * whose edges were lost, and that is how the side bumper, which has no
+ * interrupt pin, is always found.
+ *
+ * It replaces RobotBumper, TapeSensor, TrackWire and Beacon, which did the
+ * same thresholds and edge detection as four services on four timers.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ROBOT_SENSORS_H
+#define ROBOT_SENSORS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitRobotSensors(uint8_t Priority)
+ * @param Priority - internal variable to track which event queue to use
+ * @return TRUE or FALSE
+ * @brief Subscribes the analog sensor pins with ADAcquire and posts ES_INIT.
+ *        The first tick evaluates every group, so RobotHSM hears about any
+ *        input that is already active at power-up. */
+uint8_t InitRobotSensors(uint8_t Priority);
+
+/**
+ * @Function RobotSensors_Calibrate(uint8_t On)
+ * @param On - TRUE to learn the analog thresholds, FALSE for the fixed ones
+ * @return None.
+ * @brief Either way every analog channel goes back to its fixed threshold and
+ *        its statistics start again. Call with TRUE as the robot starts a
+ *        spin on the field; the learning then carries on until turned off. */
+void RobotSensors_Calibrate(uint8_t On);
+
+/**
+ * @Function RobotSensors_Attend(uint8_t Watch, uint8_t Fast)
+ * @param Watch - SENSOR_* channels to report edges of at their group's rate
+ * @param Fast - SENSOR_* channels to report every tick
+ * @return None.
+ * @brief A group with no channel in either is left out of the tick and its
+ *        edges are not reported; the beacon tone detector stops listening,
+ *        the other inputs are still followed. When a group that has missed a
+ *        tick is watched again its levels are taken as they are on its next
+ *        run, without edges, as if its edges had come in all along and been
+ *        ignored; one watched again before its tick goes on as it was. Until
+ *        this is first called every group is watched. */
+void RobotSensors_Attend(uint8_t Watch, uint8_t Fast);
+
+/**
+ * @Function RobotSensors_GetWatched(void)
+ * @param None
+ * @return SENSOR_* channels whose groups are being run */
+uint8_t RobotSensors_GetWatched(void);
+
+/**
+ * @Function PostRobotSensors(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be posted to queue
+ * @return TRUE or FALSE */
+uint8_t PostRobotSensors(ES_Event ThisEvent);
+
+/**
+ * @Function RunRobotSensors(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be responded.
+ * @return ES_NO_EVENT
+ * @brief Runs one sensor tick on every NewADSamples. */
+ES_Event RunRobotSensors(ES_Event ThisEvent);
+
+#endif /* ROBOT_SENSORS_H */
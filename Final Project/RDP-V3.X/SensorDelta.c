@@ -0,0 +1,167 @@
+/*
+ * File: SensorDelta.c
+ *
+ * Coalesced sensor edges for RobotHSM, see SensorDelta.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "BOARD.h"
+#include "RobotHSM.h"
+#include "SensorDelta.h"
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    ES_EventTyp_t Inactive;
+    ES_EventTyp_t Active;
+} ChannelEvents_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// indexed by channel number, in SENSOR_* bit order
+static const ChannelEvents_t ChannelEvents[SENSOR_CHANNELS] = {
+    {NoCannonTape, CannonTape},
+    {NoFrontRightTape, FrontRightTape},
+    {NoFrontLeftTape, FrontLeftTape},
+    {NoFrontRightBump, FrontRightBump},
+    {NoFrontLeftBump, FrontLeftBump},
+    {NoSideBump, SideBump},
+    {No_Beacon_found, Beacon_found},
+    {No_Wall_found, Wall_found},
+};
+
+static SensorDelta_t Waiting[SENSOR_DELTA_DEPTH];
+static uint8_t Head;
+static uint8_t Count;
+static uint8_t CurrentLevels;
+static uint16_t Params[SENSOR_CHANNELS]; // for the next edge of each channel
+static SensorDeltaStats_t Stats;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void CopyParams(SensorDelta_t *pDelta, uint8_t Changed);
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void SensorDelta_Init(void)
+{
+    Head = 0;
+    Count = 0;
+    Stats.Edges = 0;
+    Stats.Posts = 0;
+    Stats.Drops = 0;
+}
+
+void SensorDelta_SetParam(uint8_t Channel, uint16_t Param)
+{
+    if (Channel < SENSOR_CHANNELS) {
+        Params[Channel] = Param;
+    }
+}
+
+uint8_t SensorDelta_Post(uint8_t Changed, uint8_t Levels)
+{
+    ES_Event ThisEvent;
+    SensorDelta_t *pNewest;
+    uint8_t Edges = 0;
+    uint8_t Bits;
+
+    if (Changed == 0) {
+        return TRUE;
+    }
+    for (Bits = Changed; Bits; Bits &= Bits - 1) {
+        Edges++;
+    }
+    Stats.Edges += Edges;
+    Levels &= Changed;
+    CurrentLevels = (CurrentLevels & ~Changed) | Levels;
+
+    // still in RobotHSM's queue, so it can take any channel it doesn't have yet
+    if (Count > 0) {
+        pNewest = &Waiting[(Head + Count - 1) & (SENSOR_DELTA_DEPTH - 1)];
+        if ((pNewest->Changed & Changed) == 0) {
+            pNewest->Changed |= Changed;
+            pNewest->Levels |= Levels;
+            CopyParams(pNewest, Changed);
+            return TRUE;
+        }
+    }
+
+    if (Count == SENSOR_DELTA_DEPTH) {
+        Stats.Drops += Edges;
+        return FALSE;
+    }
+    ThisEvent.EventType = SensorDelta;
+    ThisEvent.EventParam = 0;
+    if (PostRobotHSM(ThisEvent) == FALSE) {
+        Stats.Drops += Edges;
+        return FALSE;
+    }
+    pNewest = &Waiting[(Head + Count) & (SENSOR_DELTA_DEPTH - 1)];
+    pNewest->Changed = Changed;
+    pNewest->Levels = Levels;
+    CopyParams(pNewest, Changed);
+    Count++;
+    Stats.Posts++;
+    return TRUE;
+}
+
+uint8_t SensorDelta_Take(SensorDelta_t *pDelta)
+{
+    if (Count == 0) {
+        return FALSE;
+    }
+    *pDelta = Waiting[Head];
+    Head = (Head + 1) & (SENSOR_DELTA_DEPTH - 1);
+    Count--;
+    return TRUE;
+}
+
+ES_Event SensorDelta_ChannelEvent(const SensorDelta_t *pDelta, uint8_t Channel)
+{
+    ES_Event ThisEvent;
+
+    ThisEvent.EventType = (pDelta->Levels & (1 << Channel)) ?
+            ChannelEvents[Channel].Active : ChannelEvents[Channel].Inactive;
+    ThisEvent.EventParam = pDelta->Params[Channel];
+    return ThisEvent;
+}
+
+uint8_t SensorDelta_GetLevels(void)
+{
+    return CurrentLevels;
+}
+
+void SensorDelta_GetStats(SensorDeltaStats_t *pStats)
+{
+    *pStats = Stats;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static void CopyParams(SensorDelta_t *pDelta, uint8_t Changed)
+{
+    uint8_t Channel;
+
+    for (; Changed; Changed &= Changed - 1) {
+        Channel = __builtin_ctz(Changed);
+        pDelta->Params[Channel] = Params[Channel];
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * File: SensorDelta.h
+ *
+ * Coalesced sensor edges for RobotHSM. A sensor service packs every channel
+ * that changed on one acquisition into a single SensorDelta event instead of
+ * posting one event per channel, and RunRobotHSM() unpacks it back into the
+ * original per-channel events, so the state machine tables are unchanged.
+ *
+ * The deltas themselves wait here, in a small FIFO beside RobotHSM's queue,
+ * one entry per SensorDelta event posted. A post whose channels don't overlap
+ * the newest waiting entry is merged into it and posts nothing, so edges
+ * from several services that land before RobotHSM runs share one event too.
+ * A channel that changes again before its first edge is delivered starts a
+ * new entry; no edge is ever merged away.
+ *
+ * A service can give a channel's next edge an EventParam with
+ * SensorDelta_SetParam() before posting it, e.g. the beacon tone magnitude.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SENSOR_DELTA_H
+#define SENSOR_DELTA_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// channel bits of Changed and Levels, in the order RunRobotHSM() unpacks them
+#define SENSOR_CANNON_TAPE 0x01
+#define SENSOR_RIGHT_TAPE 0x02
+#define SENSOR_LEFT_TAPE 0x04
+#define SENSOR_RIGHT_BUMP 0x08
+#define SENSOR_LEFT_BUMP 0x10
+#define SENSOR_SIDE_BUMP 0x20
+#define SENSOR_BEACON 0x40
+#define SENSOR_TRACK_WIRE 0x80
+#define SENSOR_ALL 0xFF
+
+#define SENSOR_CHANNELS 8
+
+// deltas that can be waiting at once, a power of two; each one holds a slot
+// in RobotHSM's queue, so this only needs to cover SERV_2_QUEUE_SIZE
+#define SENSOR_DELTA_DEPTH 4
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint8_t Changed; // channels with an edge
+    uint8_t Levels; // new level of each changed channel, 1 = active
+    uint16_t Params[SENSOR_CHANNELS]; // EventParam of each changed channel
+} SensorDelta_t;
+
+typedef struct {
+    uint32_t Edges; // channel edges handed to SensorDelta_Post()
+    uint32_t Posts; // SensorDelta events posted to RobotHSM
+    uint32_t Drops; // edges lost to a full FIFO or a failed post
+} SensorDeltaStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SensorDelta_Init(void)
+ * @param None
+ * @return None
+ * @brief Empties the FIFO and clears the counters. Called from InitRobotHSM(),
+ *        which is when the framework empties RobotHSM's queue. */
+void SensorDelta_Init(void);
+
+/**
+ * @Function SensorDelta_SetParam(uint8_t Channel, uint16_t Param)
+ * @param Channel - channel number, 0 to SENSOR_CHANNELS - 1
+ * @param Param - EventParam for the channel's edges from now on
+ * @return None
+ * @brief Channels start with 0. */
+void SensorDelta_SetParam(uint8_t Channel, uint16_t Param);
+
+/**
+ * @Function SensorDelta_Post(uint8_t Changed, uint8_t Levels)
+ * @param Changed - channels that changed on this acquisition, may be 0
+ * @param Levels - new levels; bits of unchanged channels are ignored
+ * @return TRUE, or FALSE if the edges had to be dropped
+ * @brief Merges the edges into the waiting delta or posts a new SensorDelta
+ *        event to RobotHSM. */
+uint8_t SensorDelta_Post(uint8_t Changed, uint8_t Levels);
+
+/**
+ * @Function SensorDelta_Take(SensorDelta_t *pDelta)
+ * @param pDelta - filled with the oldest waiting delta
+ * @return TRUE, or FALSE if no delta was waiting
+ * @brief Called by RunRobotHSM() for each SensorDelta event. */
+uint8_t SensorDelta_Take(SensorDelta_t *pDelta);
+
+/**
+ * @Function SensorDelta_ChannelEvent(const SensorDelta_t *pDelta, uint8_t Channel)
+ * @param pDelta - a delta from SensorDelta_Take()
+ * @param Channel - channel number, 0 to SENSOR_CHANNELS - 1
+ * @return the event the sensor service used to post for that edge, e.g.
+ *         FrontRightBump or NoFrontRightBump, with the channel's EventParam */
+ES_Event SensorDelta_ChannelEvent(const SensorDelta_t *pDelta, uint8_t Channel);
+
+/**
+ * @Function SensorDelta_GetLevels(void)
+ * @param None
+ * @return the latest level of every channel, as posted */
+uint8_t SensorDelta_GetLevels(void);
+
+/**
+ * @Function SensorDelta_GetStats(SensorDeltaStats_t *pStats)
+ * @param pStats - filled with the counters since SensorDelta_Init()
+ * @return None */
+void SensorDelta_GetStats(SensorDeltaStats_t *pStats);
+
+#endif /* SENSOR_DELTA_H */
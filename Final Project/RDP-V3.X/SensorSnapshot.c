@@ -0,0 +1,93 @@
+/*
+ * File: SensorSnapshot.c
+ *
+ * Double-buffered input snapshot, see SensorSnapshot.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "SensorSnapshot.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// the snapshot is moved a word at a time: an aligned word is one load or
+// store on the PIC32, and the host build's atomics keep the copies defined
+#define SNAPSHOT_WORDS ((sizeof (SensorSnapshot_t) + 3) / 4)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef union {
+    SensorSnapshot_t Snapshot;
+    uint32_t Words[SNAPSHOT_WORDS];
+} Buffer_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static Buffer_t Buffers[2];
+
+// twice the snapshots published, plus one while the next is being filled;
+// snapshot n is in Buffers[n & 1]
+static uint32_t Sequence;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void SensorSnapshot_Init(void)
+{
+    __atomic_store_n(&Sequence, 0, __ATOMIC_SEQ_CST);
+}
+
+void SensorSnapshot_Publish(const SensorSnapshot_t *pSnapshot)
+{
+    Buffer_t New;
+    uint32_t Seq = __atomic_load_n(&Sequence, __ATOMIC_RELAXED);
+    uint32_t *pWords = Buffers[((Seq >> 1) + 1) & 1].Words;
+    uint8_t i;
+
+    New.Snapshot = *pSnapshot;
+    // odd: a reader that started on this buffer two publishes ago retries
+    __atomic_store_n(&Sequence, Seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (i = 0; i < SNAPSHOT_WORDS; i++) {
+        __atomic_store_n(&pWords[i], New.Words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&Sequence, Seq + 2, __ATOMIC_RELEASE);
+}
+
+uint8_t SensorSnapshot_Read(SensorSnapshot_t *pSnapshot)
+{
+    Buffer_t Copy;
+    uint32_t Before, After;
+    const uint32_t *pWords;
+    uint8_t Copies = 0, i;
+
+    do {
+        Before = __atomic_load_n(&Sequence, __ATOMIC_ACQUIRE);
+        if (Before < 2) {
+            return 0;
+        }
+        // the last whole snapshot, whether or not the next is being filled
+        pWords = Buffers[(Before >> 1) & 1].Words;
+        for (i = 0; i < SNAPSHOT_WORDS; i++) {
+            Copy.Words[i] = __atomic_load_n(&pWords[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        After = __atomic_load_n(&Sequence, __ATOMIC_RELAXED);
+        Copies++;
+        // refilling this buffer starts at the odd value two publishes on
+    } while (After - (Before & ~1u) >= 3);
+    *pSnapshot = Copy.Snapshot;
+    return Copies;
+}
@@ -0,0 +1,85 @@
+/*
+ * File: SensorSnapshot.h
+ *
+ * The robot's inputs as RobotSensors last took them, for anyone to read. Once
+ * a sensor tick RobotSensors publishes every analog channel, the bumper port,
+ * the beacon magnitude and the levels it has posted, all taken at one time,
+ * with that time; a reader always gets one whole tick, never part of one and
+ * part of the next, so whatever it decides on was true at one moment.
+ *
+ * The store is double-buffered: the writer fills the buffer readers are not
+ * being pointed at and then publishes it by bumping a sequence number, which
+ * is odd while a buffer is being filled. A reader copies the last published
+ * buffer and checks the sequence afterwards; only a writer that has started
+ * to refill that same buffer, two publishes on, makes it copy again. Neither
+ * side takes a lock or turns interrupts off, the writer never waits, and a
+ * reader in an interrupt (which the writer can't run over) never copies
+ * twice.
+ *
+ * There is one writer, RobotSensors, in the main loop.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// Analog[] indexes, in RobotSensors' comparator bank order
+#define SNAPSHOT_CANNON_TAPE 0
+#define SNAPSHOT_RIGHT_TAPE 1
+#define SNAPSHOT_LEFT_TAPE 2
+#define SNAPSHOT_FRONT_TRACK 3
+#define SNAPSHOT_REAR_TRACK 4
+#define SNAPSHOT_ANALOG 5
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Time; // ES_Timer_GetTime() ms the inputs were taken at
+    uint16_t Analog[SNAPSHOT_ANALOG]; // filtered AD counts
+    uint16_t Beacon; // AD counts, or the last Goertzel block's tone magnitude
+    uint8_t Bumpers; // port as read, FRONT_LEFT_BUMPER etc.
+    uint8_t Levels; // SENSOR_* levels of the tick, as posted unless resynced
+} SensorSnapshot_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SensorSnapshot_Init(void)
+ * @param None
+ * @return None
+ * @brief Empties the store; until the next publish there is nothing to read.
+ *        Called from InitRobotSensors(). */
+void SensorSnapshot_Init(void);
+
+/**
+ * @Function SensorSnapshot_Publish(const SensorSnapshot_t *pSnapshot)
+ * @param pSnapshot - the inputs of one tick
+ * @return None
+ * @brief Copies the snapshot in and makes it the one readers get. For the one
+ *        writer only. */
+void SensorSnapshot_Publish(const SensorSnapshot_t *pSnapshot);
+
+/**
+ * @Function SensorSnapshot_Read(SensorSnapshot_t *pSnapshot)
+ * @param pSnapshot - filled with the newest whole snapshot
+ * @return copies it took, 1 unless the writer lapped the reader, or 0 if
+ *         nothing has been published and pSnapshot is left alone
+ * @brief Safe from any number of readers at once, in or out of interrupts. */
+uint8_t SensorSnapshot_Read(SensorSnapshot_t *pSnapshot);
+
+#endif /* SENSOR_SNAPSHOT_H */
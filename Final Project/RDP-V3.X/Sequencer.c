@@ -0,0 +1,128 @@
+/*
+ * File: Sequencer.c
+ *
+ * Timed action script service, see Sequencer.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "Actuators.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Motion.h"
+#include "Recorder.h"
+#include "RobotHSM.h"
+#include "Sequencer.h"
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void RunSteps(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint8_t MyPriority;
+static const SequencerStep_t *pNext; // next step to run, NULL with no script
+static uint32_t WaitEnd; // ms the current SEQ_WAIT runs out
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitSequencer(uint8_t Priority)
+{
+    ES_Event ThisEvent;
+
+    MyPriority = Priority;
+    pNext = NULL;
+    ThisEvent.EventType = ES_INIT;
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+void Sequencer_Start(const SequencerStep_t *pScript)
+{
+    pNext = pScript;
+    RunSteps();
+}
+
+void Sequencer_Stop(void)
+{
+    pNext = NULL;
+    ES_Timer_StopTimer(SEQUENCER_TIMER);
+}
+
+uint8_t Sequencer_IsRunning(void)
+{
+    return pNext != NULL;
+}
+
+uint8_t PostSequencer(ES_Event ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunSequencer(ES_Event ThisEvent)
+{
+    ES_Event ReturnEvent;
+
+    ReturnEvent.EventType = ES_NO_EVENT;
+    Recorder_Event(MyPriority, ThisEvent);
+    // a timeout already queued when a new script restarted the timer is
+    // early for the new wait
+    if ((ThisEvent.EventType == ES_TIMEOUT) && (ThisEvent.EventParam == SEQUENCER_TIMER)
+            && pNext && ((int32_t) (ES_Timer_GetTime() - WaitEnd) >= 0)) {
+        RunSteps();
+    }
+    return ReturnEvent;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function RunSteps(void)
+ * @param None
+ * @return None
+ * @brief Runs steps from pNext on until a wait starts or the script ends. */
+static void RunSteps(void)
+{
+    ES_Event ThisEvent;
+    const SequencerStep_t *pStep;
+
+    while (pNext) {
+        pStep = pNext++;
+        switch (pStep->Action) {
+        case SEQ_ACT_DRIVE:
+            Motion_Arc(pStep->A, pStep->B, 0);
+            break;
+
+        case SEQ_ACT_CANNON:
+            Actuators_Cannon(pStep->A);
+            break;
+
+        case SEQ_ACT_POST:
+            ThisEvent.EventType = pStep->A;
+            ThisEvent.EventParam = (uint16_t) pStep->B;
+            PostRobotHSM(ThisEvent);
+            break;
+
+        case SEQ_ACT_WAIT:
+            WaitEnd = ES_Timer_GetTime() + (uint16_t) pStep->A;
+            ES_Timer_InitTimer(SEQUENCER_TIMER, (uint16_t) pStep->A);
+            return;
+
+        default: // SEQ_ACT_END
+            pNext = NULL;
+            break;
+        }
+    }
+}
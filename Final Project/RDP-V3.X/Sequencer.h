@@ -0,0 +1,105 @@
+/*
+ * File: Sequencer.h
+ *
+ * Timed action scripts for the state machines. A script is a const array of
+ * steps (set the drive motors, set the cannon, post an event to RobotHSM,
+ * wait so many ms) ending in SEQ_END. Sequencer_Start() runs the script's
+ * steps up to its first wait there and then, and the rest are run from this
+ * service as its timer runs out, so a state that has to do something, wait
+ * and do something else returns at once instead of spinning in its step
+ * while every other service waits behind it.
+ *
+ * One script runs at a time; starting another drops the rest of the one
+ * running.
+ *
+ *   static const SequencerStep_t Kick[] = {
+ *       SEQ_CANNON(0), SEQ_WAIT(200), SEQ_POST(Ball_deposit, 0), SEQ_END
+ *   };
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// step actions
+#define SEQ_ACT_END 0
+#define SEQ_ACT_DRIVE 1 // A = left, B = right motor speed, held (Motion_Arc())
+#define SEQ_ACT_CANNON 2 // A = cannon motor speed
+#define SEQ_ACT_WAIT 3 // A = ms
+#define SEQ_ACT_POST 4 // A = EventType, B = EventParam, to RobotHSM
+
+// script steps
+#define SEQ_DRIVE(Left, Right) {SEQ_ACT_DRIVE, (Left), (Right)}
+#define SEQ_CANNON(Speed) {SEQ_ACT_CANNON, (Speed), 0}
+#define SEQ_WAIT(Ms) {SEQ_ACT_WAIT, (Ms), 0}
+#define SEQ_POST(Type, Param) {SEQ_ACT_POST, (Type), (Param)}
+#define SEQ_END {SEQ_ACT_END, 0, 0}
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    uint8_t Action; // SEQ_ACT_*
+    int16_t A;
+    int16_t B;
+} SequencerStep_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function InitSequencer(uint8_t Priority)
+ * @param Priority - internal variable to track which event queue to use
+ * @return TRUE or FALSE
+ * @brief Leaves the sequencer with no script and posts ES_INIT. */
+uint8_t InitSequencer(uint8_t Priority);
+
+/**
+ * @Function Sequencer_Start(const SequencerStep_t *pScript)
+ * @param pScript - the steps, ending in SEQ_END; kept, not copied
+ * @return None
+ * @brief Drops any script running and runs this one's steps up to its first
+ *        SEQ_WAIT before returning. */
+void Sequencer_Start(const SequencerStep_t *pScript);
+
+/**
+ * @Function Sequencer_Stop(void)
+ * @param None
+ * @return None
+ * @brief Drops the rest of the script running, if any. The motors are left
+ *        as its last step set them. */
+void Sequencer_Stop(void);
+
+/**
+ * @Function Sequencer_IsRunning(void)
+ * @param None
+ * @return TRUE while a script has steps left to run */
+uint8_t Sequencer_IsRunning(void);
+
+/**
+ * @Function PostSequencer(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be posted to queue
+ * @return TRUE or FALSE */
+uint8_t PostSequencer(ES_Event ThisEvent);
+
+/**
+ * @Function RunSequencer(ES_Event ThisEvent)
+ * @param ThisEvent - the event (type and param) to be responded.
+ * @return ES_NO_EVENT
+ * @brief Runs the next steps of the script when SEQUENCER_TIMER runs out. */
+ES_Event RunSequencer(ES_Event ThisEvent);
+
+#endif /* SEQUENCER_H */
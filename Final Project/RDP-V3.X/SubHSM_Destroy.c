@@ -30,37 +30,31 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Destroy.h"
 #include "Robot.h"
+#include "Actuators.h"
+#include "Motion.h"
+#include "Sequencer.h"
 #include <stdio.h>
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
-    Check,
     Back,
     Forward,
     Lineup,
     Fire,
-    Stop,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"Check",
-	"Back",
-	"Forward",
-	"Lineup",
-	"Fire",
-	"Stop",
-};
 
 #define SHOOT_TIMER 4250 //Time needed to deposit one ball
 #define BACK_TIMER 500 //Timer to become parallel with the beacon and see if there is a tape
 #define FORWARD_TIMER 1000 //Timer to move forward
+#define FIRE_SPINDOWN 175 //Cannon stopped this long for the ball to drop out
+#define CANNON_SPEED 75
 
 
 /*******************************************************************************
@@ -69,14 +63,67 @@ static const char *StateNames[] = {
 /* Prototypes for private functions for this machine. They should be functions
    relevant to the behavior of this state machine */
 
+static void StartForward(void);
+static void StartBack(void);
+static void StartShoot(void);
+static void FireDone(void);
+
+static void BackEntry(void);
+static void ForwardEntry(void);
+static void LineupEntry(void);
+static void FireEntry(void);
+
 /*******************************************************************************
  * PRIVATE MODULE VARIABLES                                                            *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+// Move backwards to line up the tape sensor with the beacon tower. The
+// HSM_TIMER row catches the timer RobotHSM started on the way in.
+static const HSM_Transition_t BackRows[] = {
+    {ES_TIMEOUT, Forward, HSM_CONSUME, HSM_PARAM(DESTROY_TIMER) | HSM_PARAM(HSM_TIMER), StartForward},
+    {CannonTape, Lineup, HSM_PASS, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t ForwardRows[] = { // move forward for tape for about a second
+    {ES_TIMEOUT, Back, HSM_PASS, HSM_ANY_PARAM, StartBack},
+    {CannonTape, Lineup, HSM_PASS, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t LineupRows[] = { // the tape leaving means we are parallel
+    {NoCannonTape, Fire, HSM_PASS, HSM_ANY_PARAM, StartShoot},
+};
+
+static const HSM_Transition_t FireRows[] = { // one ball per SHOOT_TIMER
+    {ES_TIMEOUT, HSM_INTERNAL, HSM_CONSUME, HSM_PARAM(DESTROY_TIMER), FireDone},
+};
+
+// cannon stopped for the ball to go, then back up to speed, then tell RobotHSM
+static const SequencerStep_t FireScript[] = {
+    SEQ_CANNON(0),
+    SEQ_WAIT(FIRE_SPINDOWN),
+    SEQ_CANNON(CANNON_SPEED),
+    SEQ_POST(Ball_deposit, Ball_deposit),
+    SEQ_END
+};
+
+static const HSM_State_t States[] = {
+    [Back] =
+    {"Back", HSM_EV(ES_TIMEOUT) | HSM_EV(CannonTape),
+        HSM_ROWS(BackRows), BackEntry, NULL, NULL, NULL},
+    [Forward] =
+    {"Forward", HSM_EV(ES_TIMEOUT) | HSM_EV(CannonTape),
+        HSM_ROWS(ForwardRows), ForwardEntry, NULL, NULL, NULL},
+    [Lineup] =
+    {"Lineup", HSM_EV(NoCannonTape), HSM_ROWS(LineupRows), LineupEntry, NULL, NULL, NULL},
+    [Fire] =
+    {"Fire", HSM_EV(ES_TIMEOUT), HSM_ROWS(FireRows), FireEntry, NULL, NULL, NULL},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
+
+const HSM_Machine_t SubHSM_DestroyMachine = {
+    "Destroy", HSM_STATES(States), Back, NULL, &CurrentState
+};
 
 
 /*******************************************************************************
@@ -94,134 +141,19 @@ static uint8_t MyPriority;
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Destroy(void) {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Destroy(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_DestroyMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Destroy state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Destroy(ES_Event ThisEvent) {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-    ES_Event ReturnEvent;
-    static ES_EventTyp_t lastEvent = No_Ball_deposit;
-    ES_EventTyp_t curEvent = No_Ball_deposit;
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-        case InitPSubState: // If current state is initial Psedudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-            {
-                // this is where you would put any actions associated with the
-                // transition from the initial pseudo-state into the actual
-                // initial state
-                // now put the machine into the actual initial state
-                nextState = Back;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-        case Back: // in the first state, Move right motors backwards to line up the tape sensor with the beacon tower
-            switch (ThisEvent.EventType) {
-                case ES_NO_EVENT:
-                default: // all unhandled events pass the event back up to the next level
-                    break;
-            }
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == DESTROY_TIMER) {//if tape is not switching to no tape, then we know it is already on the tape
-                    nextState = Forward;
-                    ES_Timer_InitTimer(DESTROY_TIMER, FORWARD_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                } else if (ThisEvent.EventParam == HSM_TIMER) {
-                    nextState = Forward;
-                    ES_Timer_InitTimer(DESTROY_TIMER, FORWARD_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else if (ThisEvent.EventType == CannonTape) { //tape sensor should read no tape once it is close to the beacon tower, then we know we are parallel to it
-                nextState = Lineup;
-                makeTransition = TRUE;
-            }
-            Robot_RightMtrSpeed(-80);
-            Robot_LeftMtrSpeed(-80);
-            break;
-        case Forward: //move forward for tape for about a second
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                nextState = Back;
-                ES_Timer_InitTimer(DESTROY_TIMER, BACK_TIMER);
-                makeTransition = TRUE;
-            } else if (ThisEvent.EventType == CannonTape) {
-                nextState = Lineup;
-                makeTransition = TRUE;
-            }
-            Robot_RightMtrSpeed(100);
-            Robot_LeftMtrSpeed(90);
-            break;
-        case Lineup: //if the tape was not forward then we move back to find the tape
-            if (ThisEvent.EventType == NoCannonTape) {
-                nextState = Fire;
-                ES_Timer_InitTimer(DESTROY_TIMER, SHOOT_TIMER);
-                makeTransition = TRUE;
-            } else {
-                Robot_RightMtrSpeed(-70);
-                Robot_LeftMtrSpeed(-70);
-            }
-            break;
-        case Fire: //Move cannon motor for about 1.2 seconds
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == DESTROY_TIMER) {
-                    CannonMtrSpeed(0);
-                    int i;
-                    for (i = 0; i < 2000000; i++){
-                        
-                    }
-//                    printf("Stop \n");
-                    curEvent = Ball_deposit;
-                    ES_Timer_InitTimer(DESTROY_TIMER, BACK_TIMER);
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-//            printf("Shoot \n");
-            Robot_RightMtrSpeed(0);
-            Robot_LeftMtrSpeed(0);
-            CannonMtrSpeed(75);
-            break;
-        default: // all unhandled states fall into here
-            break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Destroy(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Destroy(ENTRY_EVENT); // <- rename to your own Run function
-    }
-    if (curEvent != lastEvent) {
-        ReturnEvent.EventType = curEvent;
-        ReturnEvent.EventParam = (uint16_t) curEvent;
-        lastEvent = curEvent;
-        PostRobotHSM(ReturnEvent);
-    }
+    ThisEvent = HSM_Run(&SubHSM_DestroyMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -231,3 +163,35 @@ ES_Event RunSubHSM_Destroy(ES_Event ThisEvent) {
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void StartForward(void) {
+    ES_Timer_InitTimer(DESTROY_TIMER, FORWARD_TIMER);
+}
+
+static void StartBack(void) {
+    ES_Timer_InitTimer(DESTROY_TIMER, BACK_TIMER);
+}
+
+static void StartShoot(void) {
+    ES_Timer_InitTimer(DESTROY_TIMER, SHOOT_TIMER);
+}
+
+static void FireDone(void) { // ball is out, tell RobotHSM and keep the cannon spinning
+    Sequencer_Start(FireScript);
+}
+
+static void BackEntry(void) {
+    Motion_Drive(-80, 0);
+}
+
+static void ForwardEntry(void) {
+    Motion_Arc(90, 100, 0);
+}
+
+static void LineupEntry(void) {
+    Motion_Drive(-70, 0);
+}
+
+static void FireEntry(void) {
+    Motion_Drive(0, 0);
+    Actuators_Cannon(CANNON_SPEED);
+}
@@ -30,25 +30,22 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Escape.h"
+#include "Robot.h"
+#include "Motion.h"
+#include "Odometry.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
     Escape1,
     Escape2,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"Escape1",
-	"Escape2",
-};
-
-#define TURN_TIMER 1500
+#define ESCAPE_TURN 60 // degrees, what 1500 ms at 85 came to on a charged battery
 
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
@@ -56,14 +53,29 @@ static const char *StateNames[] = {
 /* Prototypes for private functions for this machine. They should be functions
    relevant to the behavior of this state machine */
 
+static void Escape1Entry(void);
+static void Escape2Entry(void);
+
 /*******************************************************************************
  * PRIVATE MODULE VARIABLES                                                            *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+static const HSM_Transition_t Escape1Rows[] = { // turn ~70 degrees right
+    {TurnComplete, Escape2, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_State_t States[] = {
+    [Escape1] =
+    {"Escape1", HSM_EV(TurnComplete), HSM_ROWS(Escape1Rows), Escape1Entry, NULL, NULL, NULL},
+    [Escape2] =
+    {"Escape2", 0, HSM_NO_ROWS, Escape2Entry, NULL, NULL, NULL},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
+
+const HSM_Machine_t SubHSM_EscapeMachine = {
+    "Escape", HSM_STATES(States), Escape1, NULL, &CurrentState
+};
 
 
 /*******************************************************************************
@@ -81,84 +93,19 @@ static uint8_t MyPriority;
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Escape(void) {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Escape(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_EscapeMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Escape state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Escape(ES_Event ThisEvent) {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-        case InitPSubState: // If current state is initial Psedudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-            {
-                // this is where you would put any actions associated with the
-                // transition from the initial pseudo-state into the actual
-                // initial state
-
-                // now put the machine into the actual initial state
-                nextState = Escape1;
-                ES_Timer_InitTimer(ESCAPE_TIMER, TURN_TIMER);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-
-        case Escape1: // in the first state, turn `70 degrees right
-            switch (ThisEvent.EventType) {
-                case ES_NO_EVENT:
-                default: // all unhandled events pass the event back up to the next level
-                    break;
-            }
-            Robot_RightMtrSpeed(-85);
-            Robot_LeftMtrSpeed(85);
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == ESCAPE_TIMER) {
-                    nextState = Escape2;
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-            break;
-        case Escape2:
-            Robot_RightMtrSpeed(85);
-            Robot_LeftMtrSpeed(85);
-            break;
-        default: // all unhandled states fall into here
-            break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Escape(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Escape(ENTRY_EVENT); // <- rename to your own Run function
-    }
-
+    ThisEvent = HSM_Run(&SubHSM_EscapeMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -168,3 +115,11 @@ ES_Event RunSubHSM_Escape(ES_Event ThisEvent) {
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void Escape1Entry(void) {
+    Motion_Tank(85, 0);
+    Odometry_Turn(ESCAPE_TURN, PostRobotHSM);
+}
+
+static void Escape2Entry(void) {
+    Motion_Drive(85, 0);
+}
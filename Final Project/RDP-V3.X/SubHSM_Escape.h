@@ -26,6 +26,7 @@
  ******************************************************************************/
 
 #include "ES_Configure.h"   // defines ES_Event, INIT_EVENT, ENTRY_EVENT, and EXIT_EVENT
+#include "HSM.h"
 
 /*******************************************************************************
  * PUBLIC #DEFINES                                                             *
@@ -36,6 +37,9 @@
  * PUBLIC TYPEDEFS                                                             *
  ******************************************************************************/
 
+// state table, so a parent machine can name this one as a child
+extern const HSM_Machine_t SubHSM_EscapeMachine;
+
 
 /*******************************************************************************
  * PUBLIC FUNCTION PROTOTYPES                                                  *
@@ -30,26 +30,24 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Flank.h"
 #include "Robot.h"
+#include "Motion.h"
+#include "Odometry.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
     TankRight,
     CircleLeft,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"TankRight",
-	"CircleLeft",
-};
-
-#define TANK_TIMER 2000 //Time to make a 135 degree tank turn
+// mm backed straight, what 2000 ms at 50 came to on a charged battery; the
+// wheels were never driven apart for the 135 degree tank turn once meant
+#define TANK_BACKUP 103
 
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
@@ -57,14 +55,35 @@ static const char *StateNames[] = {
 /* Prototypes for private functions for this machine. They should be functions
    relevant to the behavior of this state machine */
 
+static void TankRightEntry(void);
+static void CircleLeftEntry(void);
+
 /*******************************************************************************
  * PRIVATE MODULE VARIABLES                                                            *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+static const HSM_Transition_t TankRightRows[] = {
+    {DistanceReached, CircleLeft, HSM_PASS, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t CircleLeftRows[] = { // either front tape sensor turns us back
+    {FrontRightTape, TankRight, HSM_PASS, HSM_ANY_PARAM, NULL},
+    {FrontLeftTape, TankRight, HSM_PASS, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_State_t States[] = {
+    [TankRight] =
+    {"TankRight", HSM_EV(DistanceReached), HSM_ROWS(TankRightRows), TankRightEntry, NULL, NULL, NULL},
+    [CircleLeft] =
+    {"CircleLeft", HSM_EV(FrontRightTape) | HSM_EV(FrontLeftTape),
+        HSM_ROWS(CircleLeftRows), CircleLeftEntry, NULL, NULL, NULL},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
+
+const HSM_Machine_t SubHSM_FlankMachine = {
+    "Flank", HSM_STATES(States), TankRight, NULL, &CurrentState
+};
 
 
 /*******************************************************************************
@@ -83,86 +102,20 @@ static uint8_t MyPriority;
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Flank(void)
 {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Flank(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_FlankMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Flank state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Flank(ES_Event ThisEvent)
 {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-    case InitPSubState: // If current state is initial Psedudo State
-        if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-        {
-            // this is where you would put any actions associated with the
-            // transition from the initial pseudo-state into the actual
-            // initial state
-
-            // now put the machine into the actual initial state
-            nextState = TankRight;
-            ES_Timer_InitTimer(HSM_TIMER, TANK_TIMER);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        break;
-
-    case TankRight: // in the first state, replace this with correct names
-        switch (ThisEvent.EventType) {
-        case ES_NO_EVENT:
-        default: // all unhandled events pass the event back up to the next level
-            break;
-        }
-        Robot_RightMtrSpeed(-50);
-        Robot_LeftMtrSpeed(-50);
-        if(ThisEvent.EventType == ES_TIMEOUT){
-            nextState = CircleLeft;
-            makeTransition = TRUE;
-        }
-        break;
-    case CircleLeft:
-        Robot_LeftMtrSpeed(35);
-        Robot_RightMtrSpeed(-60);
-        if(ThisEvent.EventType == (FrontRightTape | FrontLeftTape)){
-            nextState = TankRight;
-            ES_Timer_InitTimer(HSM_TIMER, TANK_TIMER);
-            makeTransition = TRUE;
-        } 
-    default: // all unhandled states fall into here
-        break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Flank(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Flank(ENTRY_EVENT); // <- rename to your own Run function
-    }
-
+    ThisEvent = HSM_Run(&SubHSM_FlankMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -172,3 +125,13 @@ ES_Event RunSubHSM_Flank(ES_Event ThisEvent)
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void TankRightEntry(void)
+{
+    Motion_Drive(-50, 0);
+    Odometry_Distance(TANK_BACKUP, PostRobotHSM);
+}
+
+static void CircleLeftEntry(void)
+{
+    Motion_Arc(35, -60, 0);
+}
@@ -30,41 +30,51 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Lookout.h"
 #include "Robot.h"
+#include "Motion.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
     Search,
     Right,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"Search",
-	"Right",
-};
-
-
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
-/* Prototypes for private functions for this machine. They should be functions
-   relevant to the behavior of this state machine */
+
+static void SearchEntry(void);
+static void RightEntry(void);
 
 /*******************************************************************************
- * PRIVATE MODULE VARIABLES                                                            *
+ * PRIVATE MODULE VARIABLES                                                    *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+static const HSM_Transition_t SearchRows[] = {
+    {FrontRightBump, Right, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t RightRows[] = {
+    {FrontLeftBump, Search, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_State_t States[] = {
+    [Search] =
+    {"Search", HSM_EV(FrontRightBump), HSM_ROWS(SearchRows), SearchEntry, NULL, NULL, NULL},
+    [Right] =
+    {"Right", HSM_EV(FrontLeftBump), HSM_ROWS(RightRows), RightEntry, NULL, NULL, NULL},
+};
 
+static uint8_t CurrentState = HSM_NOT_STARTED;
+
+const HSM_Machine_t SubHSM_LookoutMachine = {
+    "Lookout", HSM_STATES(States), Search, NULL, &CurrentState
+};
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -81,96 +91,19 @@ static uint8_t MyPriority;
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Lookout(void) {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Lookout(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_LookoutMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Lookout state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Lookout(ES_Event ThisEvent) {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-        case InitPSubState: // If current state is initial Psedudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-            {
-                // this is where you would put any actions associated with the
-                // transition from the initial pseudo-state into the actual
-                // initial state
-
-                // now put the machine into the actual initial state
-                nextState = Search;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-
-        case Search: // in the first state, replace this with correct names
-            switch (ThisEvent.EventType) {
-                case ES_NO_EVENT:
-                default: // all unhandled events pass the event back up to the next level
-                    break;
-            }
-//            if (ThisEvent.EventType == FrontRightTape) {
-//                nextState = Right;
-//                makeTransition = TRUE;
-//                ThisEvent.EventType = ES_NO_EVENT;
-//            } 
-            if (ThisEvent.EventType == FrontRightBump) {
-                nextState = Right;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(-90);
-            Robot_LeftMtrSpeed(90);
-            break;
-        case Right: //spin left
-//            if (ThisEvent.EventType == FrontLeftTape) {
-//                nextState = Search;
-//                makeTransition = TRUE;
-//                ThisEvent.EventType = ES_NO_EVENT;
-//            }
-            if (ThisEvent.EventType == FrontLeftBump) {
-                nextState = Search;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_LeftMtrSpeed(-90);
-            Robot_RightMtrSpeed(90);
-            break;
-        default: // all unhandled states fall into here
-            break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Lookout(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Lookout(ENTRY_EVENT); // <- rename to your own Run function
-    }
-
+    ThisEvent = HSM_Run(&SubHSM_LookoutMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -180,3 +113,10 @@ ES_Event RunSubHSM_Lookout(ES_Event ThisEvent) {
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void SearchEntry(void) {
+    Motion_Tank(90, 0);
+}
+
+static void RightEntry(void) { //spin left
+    Motion_Tank(-90, 0);
+}
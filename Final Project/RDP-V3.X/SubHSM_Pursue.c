@@ -30,20 +30,19 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Pursue.h"
 #include "Robot.h"
+#include "Motion.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
     Pursue,
     adjust,
     Slide,
-    Slide2,
-    PivotLeft,
     backup,
     Backup2,
     Side,
@@ -55,36 +54,13 @@ typedef enum {
     TapeBackR,
     TapeBackR2,
     TapeBackL,
-    Stop,
     SideFollowOn,
     SideFollowOff,
     Straight,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"Pursue",
-	"adjust",
-	"Slide",
-	"Slide2",
-	"PivotLeft",
-	"backup",
-	"Backup2",
-	"Side",
-	"bump",
-	"Check",
-	"RightTape",
-	"RightTape2",
-	"LeftTape",
-	"TapeBackR",
-	"TapeBackR2",
-	"TapeBackL",
-	"Stop",
-	"SideFollowOn",
-	"SideFollowOff",
-	"Straight",
-};
-
+// the moves are as long as they would run at their speeds, see Motion.h;
+// SIDE1_TIMER is the SideFollowOff watchdog
 #define CHECK_TIMER 1000
 #define TANK_TIMER 600
 #define TANK_TIMER2 500
@@ -93,24 +69,180 @@ static const char *StateNames[] = {
 #define TAPE_BACK 100
 #define SIDE1_TIMER 10000
 #define SIDE_TIMER 250
-#define LEFT_TIMER 3000
 #define STRAIGHT_TIMER 500
 
+// ParamMask of the ES_TIMEOUT row, which only answers to this machine's timer
+#define PURSUE_TIMEOUT HSM_PARAM(PURSUE_TIMER)
+
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
-/* Prototypes for private functions for this machine. They should be functions
-   relevant to the behavior of this state machine */
+
+static void StartBackUp(void);
+static void StartSide1(void);
+static void StartCheck(void);
+static void PostGoSeeking(void);
+
+static void PursueEntry(void);
+static void AdjustEntry(void);
+static void SlideEntry(void);
+static void BackupEntry(void);
+static void Backup2Entry(void);
+static void SideEntry(void);
+static void BumpEntry(void);
+static void CheckEntry(void);
+static void RightTapeEntry(void);
+static void RightTape2Entry(void);
+static void LeftTapeEntry(void);
+static void TapeBackEntry(void);
+static void SideFollowOnEntry(void);
+static void SideFollowOffEntry(void);
+static void StraightEntry(void);
 
 /*******************************************************************************
- * PRIVATE MODULE VARIABLES                                                            *
+ * PRIVATE MODULE VARIABLES                                                    *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+static const HSM_Transition_t PursueRows[] = { // Simply move forward
+    {No_Beacon_found, adjust, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontRightBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontRightTape, TapeBackR, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftTape, TapeBackL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t AdjustRows[] = {
+    {Beacon_found, Pursue, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontRightBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontRightTape, TapeBackR, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftTape, TapeBackL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t SlideRows[] = { // hug the side of the beacon tower
+    {SideBump, SideFollowOn, HSM_PASS, HSM_ANY_PARAM, StartSide1},
+    {FrontRightTape, TapeBackR2, HSM_PASS, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t BackupRows[] = { // back up for a better right turn
+    {MotionDone, bump, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t Backup2Rows[] = {
+    {MotionDone, Side, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
 
+static const HSM_Transition_t SideRows[] = { // keep bumping until the side bumper stays clear
+    {SideBump, Backup2, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {MotionDone, Check, HSM_CONSUME, HSM_CURRENT_PARAM, StartCheck},
+};
+
+static const HSM_Transition_t BumpRows[] = { // keep hitting the beacon until the side bumper does
+    {FrontRightBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftBump, backup, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {SideBump, SideFollowOn, HSM_CONSUME, HSM_ANY_PARAM, StartBackUp},
+    {FrontLeftTape, TapeBackL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t CheckRows[] = { // listen for the track wire with the motors off
+    {ES_TIMEOUT, Slide, HSM_CONSUME, PURSUE_TIMEOUT, NULL},
+};
+
+static const HSM_Transition_t RightTapeRows[] = { // move left, away from the tape
+    {MotionDone, Straight, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t RightTape2Rows[] = { // turn right onto the inside tape
+    {MotionDone, Straight, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t LeftTapeRows[] = {
+    {Beacon_found, Pursue, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {MotionDone, Straight, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t TapeBackRRows[] = {
+    {MotionDone, RightTape, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t TapeBackR2Rows[] = { // reverse the skid off the tape
+    {MotionDone, RightTape2, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t TapeBackLRows[] = {
+    {Beacon_found, Pursue, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {MotionDone, LeftTape, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t SideFollowOnRows[] = {
+    {NoFrontLeftBump, SideFollowOff, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {NoSideBump, SideFollowOff, HSM_CONSUME, HSM_ANY_PARAM, StartSide1},
+};
+
+static const HSM_Transition_t SideFollowOffRows[] = {
+    {ES_TIMEOUT, SideFollowOn, HSM_CONSUME, PURSUE_TIMEOUT, NULL},
+    {FrontLeftBump, SideFollowOn, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {SideBump, SideFollowOn, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t StraightRows[] = {
+    {MotionDone, Pursue, HSM_CONSUME, HSM_CURRENT_PARAM, PostGoSeeking},
+};
+
+static const HSM_State_t States[] = {
+    [Pursue] =
+    {"Pursue", HSM_EV(No_Beacon_found) | HSM_EV(FrontRightBump) | HSM_EV(FrontLeftBump)
+        | HSM_EV(FrontRightTape) | HSM_EV(FrontLeftTape),
+        HSM_ROWS(PursueRows), PursueEntry, NULL, NULL, NULL},
+    [adjust] =
+    {"adjust", HSM_EV(Beacon_found) | HSM_EV(FrontRightBump) | HSM_EV(FrontLeftBump)
+        | HSM_EV(FrontRightTape) | HSM_EV(FrontLeftTape),
+        HSM_ROWS(AdjustRows), AdjustEntry, NULL, NULL, NULL},
+    [Slide] =
+    {"Slide", HSM_EV(SideBump) | HSM_EV(FrontRightTape),
+        HSM_ROWS(SlideRows), SlideEntry, NULL, NULL, NULL},
+    [backup] =
+    {"backup", HSM_EV(MotionDone), HSM_ROWS(BackupRows), BackupEntry, NULL, NULL, NULL},
+    [Backup2] =
+    {"Backup2", HSM_EV(MotionDone), HSM_ROWS(Backup2Rows), Backup2Entry, NULL, NULL, NULL},
+    [Side] =
+    {"Side", HSM_EV(SideBump) | HSM_EV(MotionDone),
+        HSM_ROWS(SideRows), SideEntry, NULL, NULL, NULL},
+    [bump] =
+    {"bump", HSM_EV(FrontRightBump) | HSM_EV(FrontLeftBump) | HSM_EV(SideBump)
+        | HSM_EV(FrontLeftTape),
+        HSM_ROWS(BumpRows), BumpEntry, NULL, NULL, NULL},
+    [Check] =
+    {"Check", HSM_EV(ES_TIMEOUT), HSM_ROWS(CheckRows), CheckEntry, NULL, NULL, NULL},
+    [RightTape] =
+    {"RightTape", HSM_EV(MotionDone), HSM_ROWS(RightTapeRows), RightTapeEntry, NULL, NULL, NULL},
+    [RightTape2] =
+    {"RightTape2", HSM_EV(MotionDone), HSM_ROWS(RightTape2Rows), RightTape2Entry, NULL, NULL, NULL},
+    [LeftTape] =
+    {"LeftTape", HSM_EV(Beacon_found) | HSM_EV(MotionDone),
+        HSM_ROWS(LeftTapeRows), LeftTapeEntry, NULL, NULL, NULL},
+    [TapeBackR] =
+    {"TapeBackR", HSM_EV(MotionDone), HSM_ROWS(TapeBackRRows), TapeBackEntry, NULL, NULL, NULL},
+    [TapeBackR2] =
+    {"TapeBackR2", HSM_EV(MotionDone), HSM_ROWS(TapeBackR2Rows), TapeBackEntry, NULL, NULL, NULL},
+    [TapeBackL] =
+    {"TapeBackL", HSM_EV(Beacon_found) | HSM_EV(MotionDone),
+        HSM_ROWS(TapeBackLRows), TapeBackEntry, NULL, NULL, NULL},
+    [SideFollowOn] =
+    {"SideFollowOn", HSM_EV(NoFrontLeftBump) | HSM_EV(NoSideBump),
+        HSM_ROWS(SideFollowOnRows), SideFollowOnEntry, NULL, NULL, NULL},
+    [SideFollowOff] =
+    {"SideFollowOff", HSM_EV(ES_TIMEOUT) | HSM_EV(FrontLeftBump) | HSM_EV(SideBump),
+        HSM_ROWS(SideFollowOffRows), SideFollowOffEntry, NULL, NULL, NULL},
+    [Straight] =
+    {"Straight", HSM_EV(MotionDone), HSM_ROWS(StraightRows), StraightEntry, NULL, NULL, NULL},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
+
+const HSM_Machine_t SubHSM_PursueMachine = {
+    "Pursue", HSM_STATES(States), Pursue, NULL, &CurrentState
+};
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -127,382 +259,19 @@ static uint8_t MyPriority;
  *        Returns TRUE if successful, FALSE otherwise
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Pursue(void) {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Pursue(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_PursueMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Pursue state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Pursue(ES_Event ThisEvent) {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-    ES_Event ReturnEvent;
-    static ES_EventTyp_t lastEvent = NoSeeking;
-
-    ES_EventTyp_t curEvent = NoSeeking;
-
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-        case InitPSubState: // If current state is initial Psedudo State
-            if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-            {
-                // this is where you would put any actions associated with the
-                // transition from the initial pseudo-state into the actual
-                // initial state
-
-                // now put the machine into the actual initial state
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            break;
-        case Pursue: // in the first state, Simply move forward
-            switch (ThisEvent.EventType) {
-                case ES_NO_EVENT:
-                default: // all unhandled events pass the event back up to the next level
-                    break;
-            }
-            if (ThisEvent.EventType == No_Beacon_found) {
-                nextState = adjust;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftBump) {
-                nextState = backup;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontRightBump) {
-                nextState = backup;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontRightTape) {
-                nextState = TapeBackR;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftTape) {
-                nextState = TapeBackL;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(100);
-            Robot_LeftMtrSpeed(90);
-            break;
-        case backup: //Backup a little so robot can make better right turns
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = bump;
-                    //                ES_Timer_InitTimer(PURSUE2_TIMER, LEFT_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(-100);
-                Robot_LeftMtrSpeed(-100);
-            }
-            break;
-        case bump: //keep hitting beacon until the side bumper hits it
-            if (ThisEvent.EventType == FrontRightBump) {
-                nextState = backup;
-                //                ES_Timer_StopTimer(PURSUE2_TIMER);
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftBump) {
-                nextState = backup;
-                //                ES_Timer_StopTimer(PURSUE2_TIMER);
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == SideBump) {
-                nextState = SideFollowOn;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftTape) {
-                nextState = TapeBackL;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            //            else if (ThisEvent.EventType == ES_TIMEOUT) {
-            //                if (ThisEvent.EventParam == PURSUE2_TIMER);
-            //                {
-            //                    nextState = HardLeft;
-            //                    makeTransition = TRUE;
-            //                    ThisEvent.EventType = ES_NO_EVENT;
-            //                }
-            //            }
-            Robot_LeftMtrSpeed(90);
-            Robot_RightMtrSpeed(75);
-            break;
-        case Backup2: //backup a little bit so robot can better turns
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = Side;
-                    ES_Timer_InitTimer(PURSUE_TIMER, SIDE_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(-85);
-                Robot_LeftMtrSpeed(0);
-            }
-            break;
-        case Side: //Keep hitting the side bumper until it doesn't hit it within a time limit
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = Check;
-                    ES_Timer_InitTimer(PURSUE_TIMER, CHECK_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else if (ThisEvent.EventType == SideBump) {
-                nextState = Backup2;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK2);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(75);
-            Robot_LeftMtrSpeed(100);
-            break;
-        case Check: // Check for Track Wire with no noise from motors
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = Slide;
-                    //            ES_Timer_InitTimer(PURSUE_TIMER, SIDE1_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(0);
-                Robot_LeftMtrSpeed(0);
-            }
-
-            break;
-        case Slide: // Move along side of beacon tower by hugging the beacon
-            if (ThisEvent.EventType == SideBump) {
-                nextState = SideFollowOn;
-                ES_Timer_InitTimer(PURSUE_TIMER, SIDE1_TIMER);
-                makeTransition = TRUE;
-            } else if (ThisEvent.EventType == FrontRightTape) {
-                nextState = TapeBackR2;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-            }
-            Robot_RightMtrSpeed(100);
-            Robot_LeftMtrSpeed(60);
-            break;
-        case SideFollowOn:
-            if (ThisEvent.EventType == NoSideBump) {
-                nextState = SideFollowOff;
-                ES_Timer_InitTimer(PURSUE_TIMER, SIDE1_TIMER);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == NoFrontLeftBump) {
-                nextState = SideFollowOff;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_LeftMtrSpeed(100);
-            Robot_RightMtrSpeed(80);
-            break;
-        case SideFollowOff:
-            if (ThisEvent.EventType == SideBump) {
-                nextState = SideFollowOn;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = SideFollowOn;
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else if (ThisEvent.EventType == FrontLeftBump) {
-                nextState = SideFollowOn;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_LeftMtrSpeed(40);
-            Robot_RightMtrSpeed(100);
-            break;
-            //        case HardLeft:
-            //            if (ThisEvent.EventType == SideBump) {
-            //                nextState = SideFollowOn;
-            //                makeTransition = TRUE;
-            //                ThisEvent.EventType = ES_NO_EVENT;
-            //            } else {
-            //                Robot_RightMtrSpeed(100);
-            //                Robot_LeftMtrSpeed(0);
-            //            }
-            //            break;
-        case TapeBackR:
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = RightTape;
-                    ES_Timer_InitTimer(PURSUE_TIMER, TANK_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(-100);
-                Robot_LeftMtrSpeed(-100);
-            }
-            break;
-        case TapeBackR2: //Reverse to move skid off tape
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = RightTape2;
-                    ES_Timer_InitTimer(PURSUE_TIMER, TANK_TIMER2);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(-100);
-                Robot_LeftMtrSpeed(-100);
-            }
-            break;
-        case RightTape: //Move Left, away from tape to go to seeking again
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-//                    curEvent = GoSeeking;
-                    nextState = Straight;
-                    ES_Timer_InitTimer(PURSUE_TIMER, STRAIGHT_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(0);
-                Robot_LeftMtrSpeed(-100);
-            }
-            break;
-        case RightTape2: //Turn right to begin hugging the inside tape
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-//                    curEvent = GoSeeking;
-                    nextState = Straight;
-                    ES_Timer_InitTimer(PURSUE_TIMER, STRAIGHT_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else {
-                Robot_RightMtrSpeed(-100);
-                Robot_LeftMtrSpeed(0);
-            }
-            break;
-        case TapeBackL:
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    nextState = LeftTape;
-                    ES_Timer_InitTimer(PURSUE_TIMER, TANK_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else if (ThisEvent.EventType == Beacon_found) {
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(-100);
-            Robot_LeftMtrSpeed(-100);
-            break;
-        case LeftTape:
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-//                    curEvent = GoSeeking;
-                    nextState = Straight;
-                    ES_Timer_InitTimer(PURSUE_TIMER, STRAIGHT_TIMER);
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            } else if (ThisEvent.EventType == Beacon_found) {
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(-100);
-            Robot_LeftMtrSpeed(0);
-            break;
-        case adjust:
-            if (ThisEvent.EventType == Beacon_found) {
-                nextState = Pursue;
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontRightTape) {
-                nextState = TapeBackR;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftTape) {
-                nextState = TapeBackL;
-                ES_Timer_InitTimer(PURSUE_TIMER, TAPE_BACK);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontLeftBump) {
-                nextState = backup;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            } else if (ThisEvent.EventType == FrontRightBump) {
-                nextState = backup;
-                ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
-                makeTransition = TRUE;
-                ThisEvent.EventType = ES_NO_EVENT;
-            }
-            Robot_RightMtrSpeed(0);
-            Robot_LeftMtrSpeed(100);
-            break;
-        case Straight:
-            if (ThisEvent.EventType == ES_TIMEOUT) {
-                if (ThisEvent.EventParam == PURSUE_TIMER) {
-                    curEvent = GoSeeking;
-                    nextState = Pursue;
-                    makeTransition = TRUE;
-                    ThisEvent.EventType = ES_NO_EVENT;
-                }
-            }
-            Robot_RightMtrSpeed(85);
-            Robot_LeftMtrSpeed(85);
-            break;
-
-        default: // all unhandled states fall into here
-            break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Pursue(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Pursue(ENTRY_EVENT); // <- rename to your own Run function
-    }
-    if (curEvent != lastEvent) {
-        ReturnEvent.EventType = curEvent;
-        curEvent = NoSeeking;
-        PostRobotHSM(ReturnEvent);
-    }
-
+    ThisEvent = HSM_Run(&SubHSM_PursueMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -512,3 +281,82 @@ ES_Event RunSubHSM_Pursue(ES_Event ThisEvent) {
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void StartBackUp(void) {
+    ES_Timer_InitTimer(PURSUE_TIMER, BACK_UP);
+}
+
+static void StartSide1(void) {
+    ES_Timer_InitTimer(PURSUE_TIMER, SIDE1_TIMER);
+}
+
+static void StartCheck(void) {
+    ES_Timer_InitTimer(PURSUE_TIMER, CHECK_TIMER);
+}
+
+static void PostGoSeeking(void) { // hand control back to RobotHSM
+    ES_Event ReturnEvent;
+
+    ReturnEvent.EventType = GoSeeking;
+    ReturnEvent.EventParam = 0;
+    PostRobotHSM(ReturnEvent);
+}
+
+static void PursueEntry(void) {
+    Motion_Arc(90, 100, 0);
+}
+
+static void AdjustEntry(void) {
+    Motion_PivotRight(100, 0);
+}
+
+static void SlideEntry(void) {
+    Motion_Arc(60, 100, 0);
+}
+
+static void BackupEntry(void) {
+    Motion_Drive(-100, BACK_UP);
+}
+
+static void Backup2Entry(void) {
+    Motion_PivotLeft(-85, BACK2);
+}
+
+static void SideEntry(void) {
+    Motion_Arc(100, 75, SIDE_TIMER);
+}
+
+static void BumpEntry(void) {
+    Motion_Arc(90, 75, 0);
+}
+
+static void CheckEntry(void) {
+    Motion_Drive(0, 0);
+}
+
+static void RightTapeEntry(void) {
+    Motion_PivotRight(-100, TANK_TIMER);
+}
+
+static void RightTape2Entry(void) {
+    Motion_PivotLeft(-100, TANK_TIMER2);
+}
+
+static void LeftTapeEntry(void) {
+    Motion_PivotLeft(-100, TANK_TIMER);
+}
+
+static void TapeBackEntry(void) {
+    Motion_Drive(-100, TAPE_BACK);
+}
+
+static void SideFollowOnEntry(void) {
+    Motion_Arc(100, 80, 0);
+}
+
+static void SideFollowOffEntry(void) {
+    Motion_Arc(40, 100, 0);
+}
+
+static void StraightEntry(void) {
+    Motion_Drive(85, STRAIGHT_TIMER);
+}
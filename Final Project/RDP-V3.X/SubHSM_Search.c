@@ -30,53 +30,107 @@
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "BOARD.h"
+#include "HSM.h"
 #include "RobotHSM.h"
 #include "SubHSM_Search.h"
 #include "Robot.h"
+#include "Motion.h"
+#include "Odometry.h"
 
 /*******************************************************************************
  * MODULE #DEFINES                                                             *
  ******************************************************************************/
 typedef enum {
-    InitPSubState,
     Seeking,
     BackR,
     BackL,
-	FRT1,
+    FRT1,
     FRT2,
     FLT1,
-	FLT2,
+    FLT2,
 } TemplateSubHSMState_t;
 
-static const char *StateNames[] = {
-	"InitPSubState",
-	"Seeking",
-	"BackR",
-	"BackL",
-	"FRT1",
-	"FRT2",
-	"FLT1",
-	"FLT2",
-};
-
-#define REVERSE_TIMER 900
-#define TAPE_BACKUP 750
+// how far the robot backs off the tape and turns away from it, counted by
+// Odometry; what 750 ms backing at each one's speed and 900 ms pivoting at 90
+// used to come to on a charged battery
+#define TAPE_BACKUP_RIGHT 77 // mm
+#define TAPE_BACKUP_LEFT 69
+#define REVERSE_TURN 19 // degrees
 
 /*******************************************************************************
  * PRIVATE FUNCTION PROTOTYPES                                                 *
  ******************************************************************************/
-/* Prototypes for private functions for this machine. They should be functions
-   relevant to the behavior of this state machine */
+
+static void SeekingEntry(void);
+static void BackREntry(void);
+static void BackLEntry(void);
+static void FRT1Entry(void);
+static void FRT2Entry(void);
+static void FLT1Entry(void);
+static void FLT2Entry(void);
 
 /*******************************************************************************
- * PRIVATE MODULE VARIABLES                                                            *
+ * PRIVATE MODULE VARIABLES                                                    *
  ******************************************************************************/
-/* You will need MyPriority and the state variable; you may need others as well.
- * The type of state variable should match that of enum in header file. */
 
-static TemplateSubHSMState_t CurrentState = InitPSubState; // <- change name to match ENUM
-static uint8_t MyPriority;
+static const HSM_Transition_t SeekingRows[] = {
+    {FrontRightTape, BackR, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {FrontLeftTape, BackL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+// the backing and turning states swallow any timeout, HSM_TIMER included,
+// so RobotHSM can't pull the robot out of Search halfway through a turn
+static const HSM_Transition_t BackRRows[] = {
+    {ES_TIMEOUT, HSM_INTERNAL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {DistanceReached, FRT1, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t BackLRows[] = {
+    {ES_TIMEOUT, HSM_INTERNAL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {DistanceReached, FLT1, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t FRT1Rows[] = {
+    {ES_TIMEOUT, HSM_INTERNAL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {TurnComplete, Seeking, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t FRT2Rows[] = {
+    {FrontRightTape, BackR, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_Transition_t FLT1Rows[] = {
+    {ES_TIMEOUT, HSM_INTERNAL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+    {TurnComplete, FLT2, HSM_CONSUME, HSM_CURRENT_PARAM, NULL},
+};
+
+static const HSM_Transition_t FLT2Rows[] = {
+    {FrontLeftTape, BackL, HSM_CONSUME, HSM_ANY_PARAM, NULL},
+};
+
+static const HSM_State_t States[] = {
+    [Seeking] =
+    {"Seeking", HSM_EV(FrontRightTape) | HSM_EV(FrontLeftTape),
+        HSM_ROWS(SeekingRows), SeekingEntry, NULL, NULL, NULL},
+    [BackR] =
+    {"BackR", HSM_EV(ES_TIMEOUT) | HSM_EV(DistanceReached), HSM_ROWS(BackRRows), BackREntry, NULL, NULL, NULL},
+    [BackL] =
+    {"BackL", HSM_EV(ES_TIMEOUT) | HSM_EV(DistanceReached), HSM_ROWS(BackLRows), BackLEntry, NULL, NULL, NULL},
+    [FRT1] =
+    {"FRT1", HSM_EV(ES_TIMEOUT) | HSM_EV(TurnComplete), HSM_ROWS(FRT1Rows), FRT1Entry, NULL, NULL, NULL},
+    [FRT2] =
+    {"FRT2", HSM_EV(FrontRightTape), HSM_ROWS(FRT2Rows), FRT2Entry, NULL, NULL, NULL},
+    [FLT1] =
+    {"FLT1", HSM_EV(ES_TIMEOUT) | HSM_EV(TurnComplete), HSM_ROWS(FLT1Rows), FLT1Entry, NULL, NULL, NULL},
+    [FLT2] =
+    {"FLT2", HSM_EV(FrontLeftTape), HSM_ROWS(FLT2Rows), FLT2Entry, NULL, NULL, NULL},
+};
+
+static uint8_t CurrentState = HSM_NOT_STARTED;
 
+const HSM_Machine_t SubHSM_SearchMachine = {
+    "Search", HSM_STATES(States), Seeking, NULL, &CurrentState
+};
 
 /*******************************************************************************
  * PUBLIC FUNCTIONS                                                            *
@@ -94,157 +148,20 @@ static uint8_t MyPriority;
  * @author J. Edward Carryer, 2011.10.23 19:25 */
 uint8_t InitSubHSM_Search(void)
 {
-    ES_Event returnEvent;
-
-    CurrentState = InitPSubState;
-    returnEvent = RunSubHSM_Search(INIT_EVENT);
-    if (returnEvent.EventType == ES_NO_EVENT) {
-        return TRUE;
-    }
-    return FALSE;
+    return HSM_Init(&SubHSM_SearchMachine);
 }
 
 /**
  * @Function RunTemplateSubHSM(ES_Event ThisEvent)
  * @param ThisEvent - the event (type and param) to be responded.
  * @return Event - return event (type and param), in general should be ES_NO_EVENT
- * @brief This function is where you implement the whole of the heirarchical state
- *        machine, as this is called any time a new event is passed to the event
- *        queue. This function will be called recursively to implement the correct
- *        order for a state transition to be: exit current state -> enter next state
- *        using the ES_EXIT and ES_ENTRY events.
- * @note Remember to rename to something appropriate.
- *       The lower level state machines are run first, to see if the event is dealt
- *       with there rather than at the current level. ES_EXIT and ES_ENTRY events are
- *       not consumed as these need to pass pack to the higher level state machine.
+ * @brief Runs the Search state table; see HSM.h for the dispatch rules.
  * @author J. Edward Carryer, 2011.10.23 19:25
  * @author Gabriel H Elkaim, 2011.10.23 19:25 */
 ES_Event RunSubHSM_Search(ES_Event ThisEvent)
 {
-    uint8_t makeTransition = FALSE; // use to flag transition
-    TemplateSubHSMState_t nextState; // <- change type to correct enum
-
     ES_Tattle(); // trace call stack
-
-    switch (CurrentState) {
-    case InitPSubState: // If current state is initial Psedudo State
-        if (ThisEvent.EventType == ES_INIT)// only respond to ES_Init
-        {
-            // this is where you would put any actions associated with the
-            // transition from the initial pseudo-state into the actual
-            // initial state
-
-            // now put the machine into the actual initial state
-            nextState = Seeking;
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        break;
-
-    case Seeking: // in the first state, Simply move forward
-        switch (ThisEvent.EventType) {
-        case ES_NO_EVENT:
-        default: // all unhandled events pass the event back up to the next level
-            break;
-        }
-		if (ThisEvent.EventType == FrontRightTape){
-            nextState = BackR;
-            ES_Timer_InitTimer(SEARCH_TIMER, TAPE_BACKUP);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-		}
-		if (ThisEvent.EventType == FrontLeftTape){
-            nextState = BackL;
-            ES_Timer_InitTimer(SEARCH_TIMER, TAPE_BACKUP);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-		}
-		else{
-		Robot_RightMtrSpeed(90);
-		Robot_LeftMtrSpeed(90);		//Go straight
-		}
-        break;
-    case BackR:
-        if(ThisEvent.EventType == ES_TIMEOUT){
-            nextState = FRT1;
-            ES_Timer_InitTimer(SEARCH_TIMER, REVERSE_TIMER);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        else{
-            Robot_RightMtrSpeed(-100);
-            Robot_LeftMtrSpeed(-100);
-        }
-        break;
-    case BackL:
-        if(ThisEvent.EventType == ES_TIMEOUT){
-            nextState = FLT1;
-            ES_Timer_InitTimer(SEARCH_TIMER, REVERSE_TIMER);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        else{
-            Robot_RightMtrSpeed(-90);
-            Robot_LeftMtrSpeed(-90);
-        }
-        break;
-	case FRT1:		//Turn left
-		if(ThisEvent.EventType == ES_TIMEOUT){
-			nextState = Seeking;
-			makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-		}
-		else{
-			Robot_RightMtrSpeed(0);
-			Robot_LeftMtrSpeed(-90);
-		}
-		break;
-    case FRT2:
-        if(ThisEvent.EventType == FrontRightTape){
-            nextState = BackR;
-            ES_Timer_InitTimer(SEARCH_TIMER, TAPE_BACKUP);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        else{
-            Robot_RightMtrSpeed(75);
-            Robot_LeftMtrSpeed(90);
-        }
-        break;
-	case FLT1:		//Turn Right
-		if(ThisEvent.EventType == ES_TIMEOUT){
-			nextState = FLT2;
-			makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-		}
-		else{
-			Robot_RightMtrSpeed(-90);
-			Robot_LeftMtrSpeed(0);
-		}
-		break;   
-    case FLT2:
-        if(ThisEvent.EventType == FrontLeftTape){
-            nextState = BackL;
-            ES_Timer_InitTimer(SEARCH_TIMER, TAPE_BACKUP);
-            makeTransition = TRUE;
-            ThisEvent.EventType = ES_NO_EVENT;
-        }
-        else{
-            Robot_RightMtrSpeed(90);
-            Robot_LeftMtrSpeed(75);
-        }
-        break;
-    default: // all unhandled states fall into here
-        break;
-    } // end switch on Current State
-
-    if (makeTransition == TRUE) { // making a state transition, send EXIT and ENTRY
-        // recursively call the current state with an exit event
-        RunSubHSM_Search(EXIT_EVENT); // <- rename to your own Run function
-        CurrentState = nextState;
-        RunSubHSM_Search(ENTRY_EVENT); // <- rename to your own Run function
-    }
-
+    ThisEvent = HSM_Run(&SubHSM_SearchMachine, ThisEvent);
     ES_Tail(); // trace call stack end
     return ThisEvent;
 }
@@ -254,3 +171,41 @@ ES_Event RunSubHSM_Search(ES_Event ThisEvent)
  * PRIVATE FUNCTIONS                                                           *
  ******************************************************************************/
 
+static void SeekingEntry(void)
+{
+    Motion_Drive(90, 0); //Go straight
+}
+
+static void BackREntry(void)
+{
+    Motion_Drive(-100, 0);
+    Odometry_Distance(TAPE_BACKUP_RIGHT, PostRobotHSM);
+}
+
+static void BackLEntry(void)
+{
+    Motion_Drive(-90, 0);
+    Odometry_Distance(TAPE_BACKUP_LEFT, PostRobotHSM);
+}
+
+static void FRT1Entry(void) //Turn left
+{
+    Motion_PivotRight(-90, 0);
+    Odometry_Turn(REVERSE_TURN, PostRobotHSM);
+}
+
+static void FRT2Entry(void)
+{
+    Motion_Arc(90, 75, 0);
+}
+
+static void FLT1Entry(void) //Turn Right
+{
+    Motion_PivotLeft(-90, 0);
+    Odometry_Turn(REVERSE_TURN, PostRobotHSM);
+}
+
+static void FLT2Entry(void)
+{
+    Motion_Arc(75, 90, 0);
+}
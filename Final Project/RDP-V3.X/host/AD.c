@@ -0,0 +1,169 @@
+/*
+ * File: AD.c
+ *
+ * Simulated A/D converter. Each pin holds the last value written with
+ * Sim_SetADPin(), and Sim_ADScan() converts every enabled pin at once, as one
+ * pass of the PIC32's scan does. A pin can also carry a sine tone on top of
+ * its value, which the scan adds in. AD_ReadADPin() returns the pin's result
+ * from the last scan and counts the access.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define AD_ALL_PINS ((1 << AD_NUM_PINS) - 1)
+#define AD_MID_SCALE 512
+#define SCAN_HZ 1000 // Sim_Tick() scans once per ms
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint16_t PinValues[AD_NUM_PINS];
+static uint16_t ScanValues[AD_NUM_PINS];
+static uint32_t PinReads[AD_NUM_PINS];
+static unsigned int ActivePins;
+static char NewDataReady;
+static uint16_t ToneAmplitudes[AD_NUM_PINS];
+static uint16_t ToneHz[AD_NUM_PINS];
+static unsigned int TonePins;
+static uint32_t Scans;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+char AD_Init(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < AD_NUM_PINS; i++) {
+        PinValues[i] = AD_MID_SCALE;
+        ScanValues[i] = AD_MID_SCALE;
+        PinReads[i] = 0;
+        ToneAmplitudes[i] = 0;
+    }
+    TonePins = 0;
+    Scans = 0;
+    ActivePins = 0;
+    NewDataReady = FALSE;
+    return SUCCESS;
+}
+
+char AD_AddPins(unsigned int AddPins)
+{
+    if (AddPins & ~AD_ALL_PINS) {
+        return ERROR;
+    }
+    ActivePins |= AddPins;
+    return SUCCESS;
+}
+
+char AD_RemovePins(unsigned int RemovePins)
+{
+    if (RemovePins & ~AD_ALL_PINS) {
+        return ERROR;
+    }
+    ActivePins &= ~RemovePins;
+    return SUCCESS;
+}
+
+unsigned int AD_ActivePins(void)
+{
+    return ActivePins;
+}
+
+char AD_IsNewDataReady(void)
+{
+    char Ready = NewDataReady;
+
+    NewDataReady = FALSE;
+    return Ready;
+}
+
+unsigned int AD_ReadADPin(unsigned int Pin)
+{
+    if ((Pin == 0) || (Pin & ~AD_ALL_PINS) || (Pin & (Pin - 1))) {
+        return (unsigned int) ERROR;
+    }
+    SimStats.ADReads++;
+    PinReads[__builtin_ctz(Pin)]++;
+    return ScanValues[__builtin_ctz(Pin)];
+}
+
+void AD_End(void)
+{
+    ActivePins = 0;
+}
+
+void Sim_SetADPin(unsigned int Pin, uint16_t Value)
+{
+    if ((Pin == 0) || (Pin & ~AD_ALL_PINS) || (Pin & (Pin - 1))) {
+        return;
+    }
+    if (Value > AD_MAX_VALUE) {
+        Value = AD_MAX_VALUE;
+    }
+    PinValues[__builtin_ctz(Pin)] = Value;
+}
+
+void Sim_SetADTone(unsigned int Pin, uint16_t Amplitude, uint16_t Hz)
+{
+    uint8_t i;
+
+    if ((Pin == 0) || (Pin & ~AD_ALL_PINS) || (Pin & (Pin - 1))) {
+        return;
+    }
+    i = __builtin_ctz(Pin);
+    ToneAmplitudes[i] = Amplitude;
+    ToneHz[i] = Hz;
+    if (Amplitude) {
+        TonePins |= Pin;
+    } else {
+        TonePins &= ~Pin;
+    }
+}
+
+void Sim_ADScan(void)
+{
+    double Sample;
+    unsigned int Rest;
+    uint8_t i;
+
+    Scans++;
+    if (ActivePins == 0) {
+        return;
+    }
+    for (Rest = ActivePins; Rest; Rest &= Rest - 1) {
+        i = __builtin_ctz(Rest);
+        ScanValues[i] = PinValues[i];
+    }
+    if (TonePins) {
+        for (Rest = ActivePins & TonePins; Rest; Rest &= Rest - 1) {
+            i = __builtin_ctz(Rest);
+            Sample = PinValues[i] + ToneAmplitudes[i] * sin(2 * M_PI * ToneHz[i] * Scans / SCAN_HZ);
+            ScanValues[i] = (Sample < 0) ? 0 : (Sample > AD_MAX_VALUE) ? AD_MAX_VALUE : lround(Sample);
+        }
+    }
+    NewDataReady = TRUE;
+}
+
+uint32_t Sim_GetADReads(unsigned int Pin)
+{
+    if ((Pin == 0) || (Pin & ~AD_ALL_PINS) || (Pin & (Pin - 1))) {
+        return 0;
+    }
+    return PinReads[__builtin_ctz(Pin)];
+}
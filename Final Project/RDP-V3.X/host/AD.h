@@ -0,0 +1,91 @@
+/*
+ * File: AD.h
+ *
+ * Host stand-in for the CMPE118 A/D library. Pin values come from the
+ * simulator (see Sim.h) instead of the PIC32 ADC, and every read is counted
+ * so the benchmarks can report how often the services touch the converter.
+ * Sim_ADScan() plays one pass of the scan: it converts every enabled pin and
+ * sets the flag AD_IsNewDataReady() returns, as the end-of-scan interrupt
+ * does.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef AD_H
+#define AD_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define AD_PORTV3 (1 << 0)
+#define AD_PORTV4 (1 << 1)
+#define AD_PORTV5 (1 << 2)
+#define AD_PORTV6 (1 << 3)
+#define AD_PORTV7 (1 << 4)
+#define AD_PORTV8 (1 << 5)
+#define AD_PORTW3 (1 << 6)
+#define AD_PORTW4 (1 << 7)
+#define AD_PORTW5 (1 << 8)
+#define AD_PORTW6 (1 << 9)
+#define AD_PORTW7 (1 << 10)
+#define AD_PORTW8 (1 << 11)
+#define BAT_VOLTAGE (1 << 12)
+
+#define AD_NUM_PINS 13
+#define AD_MAX_VALUE 1023
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function AD_Init(void)
+ * @param None
+ * @return SUCCESS or ERROR
+ * @brief Resets every simulated pin to mid-scale and clears the read counters. */
+char AD_Init(void);
+
+/**
+ * @Function AD_AddPins(unsigned int AddPins)
+ * @param AddPins - OR'd list of AD_PORTxx pins to enable
+ * @return SUCCESS or ERROR */
+char AD_AddPins(unsigned int AddPins);
+
+/**
+ * @Function AD_RemovePins(unsigned int RemovePins)
+ * @param RemovePins - OR'd list of AD_PORTxx pins to disable
+ * @return SUCCESS or ERROR */
+char AD_RemovePins(unsigned int RemovePins);
+
+/**
+ * @Function AD_ActivePins(void)
+ * @param None
+ * @return the OR'd list of enabled pins */
+unsigned int AD_ActivePins(void);
+
+/**
+ * @Function AD_IsNewDataReady(void)
+ * @param None
+ * @return TRUE if a scan has completed since the last call */
+char AD_IsNewDataReady(void);
+
+/**
+ * @Function AD_ReadADPin(unsigned int Pin)
+ * @param Pin - a single AD_PORTxx pin
+ * @return the pin's 10-bit result from the last scan, or ERROR */
+unsigned int AD_ReadADPin(unsigned int Pin);
+
+/**
+ * @Function AD_End(void)
+ * @param None
+ * @return None */
+void AD_End(void);
+
+#endif /* AD_H */
@@ -0,0 +1,140 @@
+/*
+ * File: ADReplay.c
+ *
+ * ADAcquire fed from a recording, see ADReplay.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADAcquire.h"
+#include "ADReplay.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// samples queued per pin; one wakeup's worth is at most AD_RING_SIZE - 1
+#define QUEUE_SIZE 16
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    uint16_t Samples[QUEUE_SIZE];
+    uint8_t Head;
+    uint8_t Count;
+} Queue_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static Queue_t Queues[AD_NUM_PINS];
+static pPostFunc Subscriber;
+static ES_Event Waiting;
+static uint8_t IsWaiting;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t ADReplay_Push(unsigned int Pin, uint16_t Sample)
+{
+    Queue_t *pQueue = &Queues[__builtin_ctz(Pin)];
+
+    if (pQueue->Count == QUEUE_SIZE) {
+        return FALSE;
+    }
+    pQueue->Samples[(pQueue->Head + pQueue->Count++) % QUEUE_SIZE] = Sample;
+    return TRUE;
+}
+
+uint8_t ADReplay_Post(ES_Event ThisEvent)
+{
+    if ((Subscriber == NULL) || IsWaiting) {
+        return FALSE;
+    }
+    Waiting = ThisEvent;
+    IsWaiting = TRUE;
+    return TRUE;
+}
+
+void ADReplay_Clear(void)
+{
+    memset(Queues, 0, sizeof (Queues));
+    IsWaiting = FALSE;
+}
+
+uint8_t ADAcquire_Subscribe(unsigned int Pins, pPostFunc PostFunc, uint16_t Every,
+        uint16_t Phase)
+{
+    if ((Pins == 0) || (PostFunc == NULL) || (Every == 0)) {
+        return FALSE;
+    }
+    Subscriber = PostFunc;
+    return TRUE;
+}
+
+uint8_t ADAcquire_SetFilter(unsigned int Pin, const ADFilter_t *pFilter)
+{
+    return TRUE;
+}
+
+uint8_t ADAcquire_Read(unsigned int Pin, uint16_t *pSample)
+{
+    Queue_t *pQueue = &Queues[__builtin_ctz(Pin)];
+
+    if (pQueue->Count == 0) {
+        return FALSE;
+    }
+    *pSample = pQueue->Samples[pQueue->Head];
+    pQueue->Head = (pQueue->Head + 1) % QUEUE_SIZE;
+    pQueue->Count--;
+    return TRUE;
+}
+
+uint8_t ADAcquire_Latest(unsigned int Pin, uint16_t *pSample)
+{
+    Queue_t *pQueue = &Queues[__builtin_ctz(Pin)];
+
+    if (pQueue->Count == 0) {
+        return FALSE;
+    }
+    *pSample = pQueue->Samples[(pQueue->Head + pQueue->Count - 1) % QUEUE_SIZE];
+    pQueue->Head = 0;
+    pQueue->Count = 0;
+    return TRUE;
+}
+
+uint16_t ADAcquire_Unread(unsigned int Pin)
+{
+    return Queues[__builtin_ctz(Pin)].Count;
+}
+
+uint8_t ADAcquire_CheckScan(void)
+{
+    if (!IsWaiting) {
+        return FALSE;
+    }
+    IsWaiting = FALSE;
+    Subscriber(Waiting);
+    return TRUE;
+}
+
+void ADAcquire_ScanComplete(const uint16_t *Values, unsigned int Pins)
+{
+}
+
+void ADAcquire_GetStats(unsigned int Pin, ADAcquireStats_t *pStats)
+{
+    memset(pStats, 0, sizeof (*pStats));
+}
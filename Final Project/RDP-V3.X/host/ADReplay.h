@@ -0,0 +1,49 @@
+/*
+ * File: ADReplay.h
+ *
+ * Stand-in for ADAcquire that replay links in place of the real one. The
+ * samples a service reads come from a recording instead of the converter:
+ * the player queues them for each pin with ADReplay_Push() and wakes the
+ * subscriber with ADReplay_Post() at the next ADAcquire_CheckScan(), as the
+ * scan that was recorded did, and ADAcquire_Read()/ADAcquire_Latest()
+ * hand back exactly what was recorded. Filters are accepted and ignored,
+ * since the recorded samples have been through them.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef AD_REPLAY_H
+#define AD_REPLAY_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ADAcquire.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ADReplay_Push(unsigned int Pin, uint16_t Sample)
+ * @param Pin - a single AD_PORTxx pin
+ * @param Sample - a sample the service read from the pin
+ * @return TRUE, or FALSE if the pin's queue is full */
+uint8_t ADReplay_Push(unsigned int Pin, uint16_t Sample);
+
+/**
+ * @Function ADReplay_Post(ES_Event ThisEvent)
+ * @param ThisEvent - the NewADSamples the subscriber was posted
+ * @return TRUE, or FALSE if nothing has subscribed or one is already waiting
+ * @brief The event checker posts it the next time the ES loop runs it. */
+uint8_t ADReplay_Post(ES_Event ThisEvent);
+
+/**
+ * @Function ADReplay_Clear(void)
+ * @param None
+ * @return None
+ * @brief Empties every pin's queue. */
+void ADReplay_Clear(void);
+
+#endif /* AD_REPLAY_H */
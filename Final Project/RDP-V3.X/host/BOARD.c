@@ -0,0 +1,24 @@
+/*
+ * File: BOARD.c
+ *
+ * Host stand-in for the CMPE118 BOARD library.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#include "BOARD.h"
+#include "serial.h"
+
+void BOARD_Init(void)
+{
+    SERIAL_Init();
+}
+
+void BOARD_End(void)
+{
+}
+
+unsigned int BOARD_GetPBClock(void)
+{
+    return BOARD_PB_CLOCK;
+}
@@ -0,0 +1,62 @@
+/*
+ * File: BOARD.h
+ *
+ * Host (Linux) stand-in for the CMPE118 BOARD library. It provides the same
+ * constants and entry points as the Uno32 version so that the RDP-V3.X
+ * services and state machines compile unchanged against the simulated HAL.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#ifndef TRUE
+#define TRUE ((int8_t)1)
+#endif
+#ifndef FALSE
+#define FALSE ((int8_t)0)
+#endif
+
+#define SUCCESS ((int8_t)1)
+#define ERROR ((int8_t)-1)
+
+/* the simulated peripheral bus runs at the same rate as the PIC32MX320 */
+#define BOARD_SYS_CLOCK 80000000L
+#define BOARD_PB_CLOCK (BOARD_SYS_CLOCK >> 1)
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function BOARD_Init(void)
+ * @param None
+ * @return None
+ * @brief Resets the simulated peripherals to their power-on state. */
+void BOARD_Init(void);
+
+/**
+ * @Function BOARD_End(void)
+ * @param None
+ * @return None
+ * @brief Shuts down the simulated peripherals. */
+void BOARD_End(void);
+
+/**
+ * @Function BOARD_GetPBClock(void)
+ * @param None
+ * @return the peripheral bus clock in Hz */
+unsigned int BOARD_GetPBClock(void);
+
+#endif /* BOARD_H */
@@ -0,0 +1,75 @@
+/*
+ * File: BumperNotify.c
+ *
+ * Host stand-in for the project's BumperNotify.c. The simulator's bumper
+ * hook sees every change of the port; only a change of a BUMPER_NOTIFY_PINS
+ * bumper is latched, as only those have an interrupt on the robot, and
+ * BumperNotify_CheckEdge() hands it on as the robot's does.
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Robot.h"
+#include "BumperNotify.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void PortChanged(unsigned char Port);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static BumperNotifyHook_t Hook;
+static unsigned char LastPort;
+static unsigned char LatchedPort;
+static uint32_t LatchedAt; // ms
+static uint8_t Latched;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void BumperNotify_Init(BumperNotifyHook_t NewHook)
+{
+    Hook = NewHook;
+    LastPort = 0; // as Robot_Init() leaves the simulated port
+    Latched = FALSE;
+    Sim_SetBumperHook(PortChanged);
+}
+
+uint8_t BumperNotify_CheckEdge(void)
+{
+    if (!Latched) {
+        return FALSE;
+    }
+    Latched = FALSE;
+    Hook(LatchedPort, LatchedAt);
+    return TRUE;
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static void PortChanged(unsigned char Port)
+{
+    unsigned char Changed = Port ^ LastPort;
+
+    LastPort = Port;
+    if (Changed & BUMPER_NOTIFY_PINS) {
+        LatchedPort = Port;
+        LatchedAt = ES_Timer_GetTime();
+        Latched = TRUE;
+    }
+}
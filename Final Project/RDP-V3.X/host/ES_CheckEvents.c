@@ -0,0 +1,29 @@
+/*
+ * File: ES_CheckEvents.c
+ *
+ * Runs every event checker in EVENT_CHECK_LIST once.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "ES_CheckEvents.h"
+#include EVENT_CHECK_HEADER
+
+#define ARRAY_SIZE(x) (sizeof (x) / sizeof ((x)[0]))
+
+static CheckFunc * const ES_EventList[] = {EVENT_CHECK_LIST};
+
+uint8_t ES_CheckUserEvents(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < ARRAY_SIZE(ES_EventList); i++) {
+        if (ES_EventList[i]() == TRUE) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
@@ -0,0 +1,22 @@
+/*
+ * File: ES_CheckEvents.h
+ *
+ * Runs the event checkers listed in EVENT_CHECK_LIST.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_CHECKEVENTS_H
+#define ES_CHECKEVENTS_H
+
+#include <stdint.h>
+
+typedef uint8_t CheckFunc(void);
+
+/**
+ * @Function ES_CheckUserEvents(void)
+ * @param None
+ * @return TRUE if any checker found an event */
+uint8_t ES_CheckUserEvents(void);
+
+#endif /* ES_CHECKEVENTS_H */
@@ -0,0 +1,43 @@
+/*
+ * File: ES_Events.h
+ *
+ * Event type shared by every service, matching the CMPE118 Gen2 framework.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_EVENTS_H
+#define ES_EVENTS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "ES_Configure.h"
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct ES_Event_t {
+    ES_EventTyp_t EventType; // what kind of event?
+    uint16_t EventParam; // parameter value for use w/ this event
+} ES_Event;
+
+typedef uint8_t PostFunc_t(ES_Event);
+typedef PostFunc_t (*pPostFunc);
+
+typedef uint8_t InitFunc_t(uint8_t Priority);
+typedef ES_Event RunFunc_t(ES_Event ThisEvent);
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define INIT_EVENT ((ES_Event){ES_INIT, 0x0000})
+#define ENTRY_EVENT ((ES_Event){ES_ENTRY, 0x0000})
+#define EXIT_EVENT ((ES_Event){ES_EXIT, 0x0000})
+#define NO_EVENT ((ES_Event){ES_NO_EVENT, 0x0000})
+
+#endif /* ES_EVENTS_H */
@@ -0,0 +1,508 @@
+/*
+ * File: ES_Framework.c
+ *
+ * Host build of the Events and Services run loop. Services, queue sizes and
+ * priorities all come from ES_Configure.h, so the host runs the same service
+ * table as the robot.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "ES_Queue.h"
+#include "ES_Ring.h"
+#include "ES_ServiceHeaders.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define ARRAY_SIZE(x) (sizeof (x) / sizeof ((x)[0]))
+
+#if NUM_SERVICES > 32
+#error the ready bitmap holds at most 32 services
+#endif
+
+#ifndef ES_ISR_RING_SIZE
+#define ES_ISR_RING_SIZE 16
+#endif
+
+#if (ES_ISR_RING_SIZE & (ES_ISR_RING_SIZE - 1)) != 0
+#error ES_ISR_RING_SIZE must be a power of two
+#endif
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    InitFunc_t *InitFunc;
+    RunFunc_t *RunFunc;
+} ES_ServDesc_t;
+
+typedef struct {
+    ES_Event *pMem;
+    uint8_t Size;
+} ES_QueueDesc_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static ES_ServDesc_t const ServDescList[] = {
+    {SERV_0_INIT, SERV_0_RUN},
+#if NUM_SERVICES > 1
+    {SERV_1_INIT, SERV_1_RUN},
+#endif
+#if NUM_SERVICES > 2
+    {SERV_2_INIT, SERV_2_RUN},
+#endif
+#if NUM_SERVICES > 3
+    {SERV_3_INIT, SERV_3_RUN},
+#endif
+#if NUM_SERVICES > 4
+    {SERV_4_INIT, SERV_4_RUN},
+#endif
+#if NUM_SERVICES > 5
+    {SERV_5_INIT, SERV_5_RUN},
+#endif
+#if NUM_SERVICES > 6
+    {SERV_6_INIT, SERV_6_RUN},
+#endif
+#if NUM_SERVICES > 7
+    {SERV_7_INIT, SERV_7_RUN},
+#endif
+#if NUM_SERVICES > 8
+    {SERV_8_INIT, SERV_8_RUN},
+#endif
+#if NUM_SERVICES > 9
+    {SERV_9_INIT, SERV_9_RUN},
+#endif
+#if NUM_SERVICES > 10
+    {SERV_10_INIT, SERV_10_RUN},
+#endif
+#if NUM_SERVICES > 11
+    {SERV_11_INIT, SERV_11_RUN},
+#endif
+#if NUM_SERVICES > 12
+    {SERV_12_INIT, SERV_12_RUN},
+#endif
+#if NUM_SERVICES > 13
+    {SERV_13_INIT, SERV_13_RUN},
+#endif
+#if NUM_SERVICES > 14
+    {SERV_14_INIT, SERV_14_RUN},
+#endif
+#if NUM_SERVICES > 15
+    {SERV_15_INIT, SERV_15_RUN},
+#endif
+#if NUM_SERVICES > 16
+    {SERV_16_INIT, SERV_16_RUN},
+#endif
+#if NUM_SERVICES > 17
+    {SERV_17_INIT, SERV_17_RUN},
+#endif
+#if NUM_SERVICES > 18
+    {SERV_18_INIT, SERV_18_RUN},
+#endif
+#if NUM_SERVICES > 19
+    {SERV_19_INIT, SERV_19_RUN},
+#endif
+#if NUM_SERVICES > 20
+    {SERV_20_INIT, SERV_20_RUN},
+#endif
+#if NUM_SERVICES > 21
+    {SERV_21_INIT, SERV_21_RUN},
+#endif
+#if NUM_SERVICES > 22
+    {SERV_22_INIT, SERV_22_RUN},
+#endif
+#if NUM_SERVICES > 23
+    {SERV_23_INIT, SERV_23_RUN},
+#endif
+#if NUM_SERVICES > 24
+    {SERV_24_INIT, SERV_24_RUN},
+#endif
+#if NUM_SERVICES > 25
+    {SERV_25_INIT, SERV_25_RUN},
+#endif
+#if NUM_SERVICES > 26
+    {SERV_26_INIT, SERV_26_RUN},
+#endif
+#if NUM_SERVICES > 27
+    {SERV_27_INIT, SERV_27_RUN},
+#endif
+#if NUM_SERVICES > 28
+    {SERV_28_INIT, SERV_28_RUN},
+#endif
+#if NUM_SERVICES > 29
+    {SERV_29_INIT, SERV_29_RUN},
+#endif
+#if NUM_SERVICES > 30
+    {SERV_30_INIT, SERV_30_RUN},
+#endif
+#if NUM_SERVICES > 31
+    {SERV_31_INIT, SERV_31_RUN},
+#endif
+};
+
+static ES_Event Queue0[SERV_0_QUEUE_SIZE + 1];
+#if NUM_SERVICES > 1
+static ES_Event Queue1[SERV_1_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 2
+static ES_Event Queue2[SERV_2_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 3
+static ES_Event Queue3[SERV_3_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 4
+static ES_Event Queue4[SERV_4_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 5
+static ES_Event Queue5[SERV_5_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 6
+static ES_Event Queue6[SERV_6_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 7
+static ES_Event Queue7[SERV_7_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 8
+static ES_Event Queue8[SERV_8_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 9
+static ES_Event Queue9[SERV_9_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 10
+static ES_Event Queue10[SERV_10_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 11
+static ES_Event Queue11[SERV_11_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 12
+static ES_Event Queue12[SERV_12_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 13
+static ES_Event Queue13[SERV_13_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 14
+static ES_Event Queue14[SERV_14_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 15
+static ES_Event Queue15[SERV_15_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 16
+static ES_Event Queue16[SERV_16_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 17
+static ES_Event Queue17[SERV_17_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 18
+static ES_Event Queue18[SERV_18_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 19
+static ES_Event Queue19[SERV_19_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 20
+static ES_Event Queue20[SERV_20_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 21
+static ES_Event Queue21[SERV_21_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 22
+static ES_Event Queue22[SERV_22_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 23
+static ES_Event Queue23[SERV_23_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 24
+static ES_Event Queue24[SERV_24_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 25
+static ES_Event Queue25[SERV_25_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 26
+static ES_Event Queue26[SERV_26_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 27
+static ES_Event Queue27[SERV_27_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 28
+static ES_Event Queue28[SERV_28_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 29
+static ES_Event Queue29[SERV_29_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 30
+static ES_Event Queue30[SERV_30_QUEUE_SIZE + 1];
+#endif
+#if NUM_SERVICES > 31
+static ES_Event Queue31[SERV_31_QUEUE_SIZE + 1];
+#endif
+
+static ES_QueueDesc_t const EventQueues[NUM_SERVICES] = {
+    {Queue0, ARRAY_SIZE(Queue0)},
+#if NUM_SERVICES > 1
+    {Queue1, ARRAY_SIZE(Queue1)},
+#endif
+#if NUM_SERVICES > 2
+    {Queue2, ARRAY_SIZE(Queue2)},
+#endif
+#if NUM_SERVICES > 3
+    {Queue3, ARRAY_SIZE(Queue3)},
+#endif
+#if NUM_SERVICES > 4
+    {Queue4, ARRAY_SIZE(Queue4)},
+#endif
+#if NUM_SERVICES > 5
+    {Queue5, ARRAY_SIZE(Queue5)},
+#endif
+#if NUM_SERVICES > 6
+    {Queue6, ARRAY_SIZE(Queue6)},
+#endif
+#if NUM_SERVICES > 7
+    {Queue7, ARRAY_SIZE(Queue7)},
+#endif
+#if NUM_SERVICES > 8
+    {Queue8, ARRAY_SIZE(Queue8)},
+#endif
+#if NUM_SERVICES > 9
+    {Queue9, ARRAY_SIZE(Queue9)},
+#endif
+#if NUM_SERVICES > 10
+    {Queue10, ARRAY_SIZE(Queue10)},
+#endif
+#if NUM_SERVICES > 11
+    {Queue11, ARRAY_SIZE(Queue11)},
+#endif
+#if NUM_SERVICES > 12
+    {Queue12, ARRAY_SIZE(Queue12)},
+#endif
+#if NUM_SERVICES > 13
+    {Queue13, ARRAY_SIZE(Queue13)},
+#endif
+#if NUM_SERVICES > 14
+    {Queue14, ARRAY_SIZE(Queue14)},
+#endif
+#if NUM_SERVICES > 15
+    {Queue15, ARRAY_SIZE(Queue15)},
+#endif
+#if NUM_SERVICES > 16
+    {Queue16, ARRAY_SIZE(Queue16)},
+#endif
+#if NUM_SERVICES > 17
+    {Queue17, ARRAY_SIZE(Queue17)},
+#endif
+#if NUM_SERVICES > 18
+    {Queue18, ARRAY_SIZE(Queue18)},
+#endif
+#if NUM_SERVICES > 19
+    {Queue19, ARRAY_SIZE(Queue19)},
+#endif
+#if NUM_SERVICES > 20
+    {Queue20, ARRAY_SIZE(Queue20)},
+#endif
+#if NUM_SERVICES > 21
+    {Queue21, ARRAY_SIZE(Queue21)},
+#endif
+#if NUM_SERVICES > 22
+    {Queue22, ARRAY_SIZE(Queue22)},
+#endif
+#if NUM_SERVICES > 23
+    {Queue23, ARRAY_SIZE(Queue23)},
+#endif
+#if NUM_SERVICES > 24
+    {Queue24, ARRAY_SIZE(Queue24)},
+#endif
+#if NUM_SERVICES > 25
+    {Queue25, ARRAY_SIZE(Queue25)},
+#endif
+#if NUM_SERVICES > 26
+    {Queue26, ARRAY_SIZE(Queue26)},
+#endif
+#if NUM_SERVICES > 27
+    {Queue27, ARRAY_SIZE(Queue27)},
+#endif
+#if NUM_SERVICES > 28
+    {Queue28, ARRAY_SIZE(Queue28)},
+#endif
+#if NUM_SERVICES > 29
+    {Queue29, ARRAY_SIZE(Queue29)},
+#endif
+#if NUM_SERVICES > 30
+    {Queue30, ARRAY_SIZE(Queue30)},
+#endif
+#if NUM_SERVICES > 31
+    {Queue31, ARRAY_SIZE(Queue31)},
+#endif
+};
+
+// one bit per service with a non-empty queue, bit number == priority
+static uint32_t Ready;
+// same for the ISR rings; set by the producer, cleared by ES_RunStep
+static uint32_t RingReady;
+
+// interrupt-context posts, one ring per service; every ISR that posts to a
+// service shares its ring, see ES_PostToService
+static ES_Event ISRRingMem[NUM_SERVICES][ES_ISR_RING_SIZE];
+static ES_Ring_t ISRRings[NUM_SERVICES];
+
+static uint8_t QueueHighWater[NUM_SERVICES];
+static uint32_t QueueOverflows[NUM_SERVICES];
+
+/*******************************************************************************
+ * PUBLIC VARIABLES                                                            *
+ ******************************************************************************/
+
+volatile uint8_t ES_ISRNesting;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+ES_Return_t ES_Initialize(void)
+{
+    unsigned char i;
+
+    ES_Timer_Init();
+    Ready = 0;
+    RingReady = 0;
+    ES_ISRNesting = 0;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        QueueHighWater[i] = 0;
+        QueueOverflows[i] = 0;
+        ES_Ring_Init(&ISRRings[i], ISRRingMem[i], ES_ISR_RING_SIZE);
+        if (EventQueues[i].pMem == (ES_Event *) 0) {
+            return FailedPointer;
+        }
+        if (ES_InitQueue(EventQueues[i].pMem, EventQueues[i].Size) == 0) {
+            return FailedIndex;
+        }
+        if (ServDescList[i].InitFunc == (InitFunc_t *) 0) {
+            return FailedPointer;
+        }
+        if (ServDescList[i].InitFunc(i) != TRUE) {
+            return FailedInit;
+        }
+    }
+    return Success;
+}
+
+ES_Return_t ES_Run(void)
+{
+    while (1) {
+        while (ES_RunStep() == TRUE) {
+            ;
+        }
+        ES_CheckUserEvents();
+        // nothing left to do at this instant: let the clock move on
+        ES_Timer_Tick();
+    }
+    return Success;
+}
+
+uint8_t ES_RunStep(void)
+{
+    uint8_t HighestPrior;
+    uint32_t RingPending = __atomic_load_n(&RingReady, __ATOMIC_ACQUIRE);
+    uint32_t Pending = Ready | RingPending;
+    uint32_t Bit;
+    ES_Event ThisEvent;
+
+    if (Pending == 0) {
+        return FALSE;
+    }
+    HighestPrior = ES_HighestBit(Pending);
+    Bit = (uint32_t) 1 << HighestPrior;
+    // ISR posts are older than anything the services queued since, so they
+    // go first. The bit is cleared before the ring is read and put back if
+    // events remain, so a post that races the clear is never stranded.
+    if (RingPending & Bit) {
+        __atomic_fetch_and(&RingReady, ~Bit, __ATOMIC_ACQ_REL);
+        ES_Ring_Get(&ISRRings[HighestPrior], &ThisEvent);
+        if (!ES_Ring_IsEmpty(&ISRRings[HighestPrior])) {
+            __atomic_fetch_or(&RingReady, Bit, __ATOMIC_RELEASE);
+        }
+    } else if (ES_DeQueue(EventQueues[HighestPrior].pMem, &ThisEvent) == 0) {
+        Ready &= ~Bit;
+    }
+    ServDescList[HighestPrior].RunFunc(ThisEvent);
+    return TRUE;
+}
+
+uint8_t ES_PostAll(ES_Event ThisEvent)
+{
+    unsigned char i;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        if (ES_PostToService(i, ThisEvent) != TRUE) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+uint8_t ES_PostToService(uint8_t WhichService, ES_Event ThisEvent)
+{
+    uint8_t Depth;
+    uint8_t Posted;
+
+    if (WhichService >= NUM_SERVICES) {
+        return FALSE;
+    }
+    if (ES_InISR()) {
+        // the ring takes one producer at a time, but the tick, ADC and
+        // bumper interrupts run at different priorities and can preempt
+        // each other mid-post, so keep the others out while Head moves
+        ES_EnterCritical();
+        Posted = ES_Ring_Put(&ISRRings[WhichService], ThisEvent);
+        ES_ExitCritical();
+        if (Posted == FALSE) {
+            return FALSE;
+        }
+        __atomic_fetch_or(&RingReady, (uint32_t) 1 << WhichService, __ATOMIC_RELEASE);
+        return TRUE;
+    }
+    if (ES_EnQueueFIFO(EventQueues[WhichService].pMem, ThisEvent) == FALSE) {
+        QueueOverflows[WhichService]++;
+        return FALSE;
+    }
+    Ready |= (uint32_t) 1 << WhichService;
+    Depth = ES_QueueCount(EventQueues[WhichService].pMem);
+    if (Depth > QueueHighWater[WhichService]) {
+        QueueHighWater[WhichService] = Depth;
+    }
+    return TRUE;
+}
+
+uint32_t ES_GetDroppedPosts(void)
+{
+    uint32_t Dropped = 0;
+    uint8_t i;
+
+    for (i = 0; i < NUM_SERVICES; i++) {
+        Dropped += QueueOverflows[i] + ISRRings[i].Overflows;
+    }
+    return Dropped;
+}
+
+int8_t ES_GetQueueStats(uint8_t WhichService, ES_QueueStats_t *pStats)
+{
+    if (WhichService >= NUM_SERVICES) {
+        return ERROR;
+    }
+    pStats->QueueHighWater = QueueHighWater[WhichService];
+    pStats->QueueOverflows = QueueOverflows[WhichService];
+    pStats->RingHighWater = ISRRings[WhichService].HighWater;
+    pStats->RingOverflows = ISRRings[WhichService].Overflows;
+    return SUCCESS;
+}
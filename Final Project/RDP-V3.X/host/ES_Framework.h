@@ -0,0 +1,106 @@
+/*
+ * File: ES_Framework.h
+ *
+ * Host build of the CMPE118 Events and Services framework. The public API
+ * matches the PIC32 library so services and HSMs compile unchanged; the
+ * additions at the bottom let the simulator and benchmarks step the run
+ * loop one event at a time.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_FRAMEWORK_H
+#define ES_FRAMEWORK_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "ES_Timers.h"
+#include "ES_PostList.h"
+#include "ES_CheckEvents.h"
+#include "ES_TattleTale.h"
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef enum {
+    Success = 0,
+    FailedPost = 1,
+    FailedPointer,
+    FailedIndex,
+    FailedInit,
+    FailedRun
+} ES_Return_t;
+
+typedef struct {
+    uint8_t QueueHighWater;
+    uint32_t QueueOverflows;
+    uint16_t RingHighWater;
+    uint32_t RingOverflows;
+} ES_QueueStats_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ES_Initialize(void)
+ * @param None
+ * @return Success or FailedInit
+ * @brief Initializes the timers and every service queue, then calls each
+ *        service's Init function in priority order. */
+ES_Return_t ES_Initialize(void);
+
+/**
+ * @Function ES_Run(void)
+ * @param None
+ * @return FailedRun if a service returns an event, otherwise never returns
+ * @brief Dispatches events highest priority first. When every queue is empty
+ *        the event checkers run and the virtual clock advances one tick, so
+ *        service handlers take zero virtual time. */
+ES_Return_t ES_Run(void);
+
+/**
+ * @Function ES_PostAll(ES_Event ThisEvent)
+ * @param ThisEvent - event to post to every service
+ * @return TRUE if every post succeeded */
+uint8_t ES_PostAll(ES_Event ThisEvent);
+
+/**
+ * @Function ES_PostToService(uint8_t WhichService, ES_Event ThisEvent)
+ * @param WhichService - service priority from ES_Configure.h
+ * @param ThisEvent - event to post
+ * @return TRUE, or FALSE if the service's queue was full
+ * @brief Called from interrupt context (ES_InISR()) the event goes to the
+ *        service's lock-free ISR ring instead of its queue. */
+uint8_t ES_PostToService(uint8_t WhichService, ES_Event ThisEvent);
+
+/**
+ * @Function ES_RunStep(void)
+ * @param None
+ * @return TRUE if an event was dispatched, FALSE if every queue was empty
+ * @brief Host only: one pass of the ES_Run loop, dispatching at most one
+ *        event to the highest-priority ready service. A service's ISR ring
+ *        is drained before its queue. */
+uint8_t ES_RunStep(void);
+
+/**
+ * @Function ES_GetDroppedPosts(void)
+ * @param None
+ * @return number of posts refused because a queue or ISR ring was full */
+uint32_t ES_GetDroppedPosts(void);
+
+/**
+ * @Function ES_GetQueueStats(uint8_t WhichService, ES_QueueStats_t *pStats)
+ * @param WhichService - service priority from ES_Configure.h
+ * @param pStats - receives the counters for that service
+ * @return SUCCESS or ERROR for a bad service number
+ * @brief High-water marks and overflow counts for both the task-level queue
+ *        and the ISR ring of one service, counted since ES_Initialize(). */
+int8_t ES_GetQueueStats(uint8_t WhichService, ES_QueueStats_t *pStats);
+
+#endif /* ES_FRAMEWORK_H */
@@ -0,0 +1,31 @@
+/*
+ * File: ES_KeyboardInput.c
+ *
+ * Keyboard service placeholder for the host build: there is no console
+ * input, so it only consumes its ES_INIT.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_KeyboardInput.h"
+
+static uint8_t MyPriority;
+
+uint8_t InitKeyboardInput(uint8_t Priority)
+{
+    MyPriority = Priority;
+    return ES_PostToService(MyPriority, INIT_EVENT);
+}
+
+uint8_t PostKeyboardInput(ES_Event ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+ES_Event RunKeyboardInput(ES_Event ThisEvent)
+{
+    return NO_EVENT;
+}
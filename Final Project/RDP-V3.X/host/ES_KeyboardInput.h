@@ -0,0 +1,19 @@
+/*
+ * File: ES_KeyboardInput.h
+ *
+ * Service 0 of every ES application. The host build has no keyboard, so the
+ * service only consumes its ES_INIT.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_KEYBOARDINPUT_H
+#define ES_KEYBOARDINPUT_H
+
+#include "ES_Events.h"
+
+uint8_t InitKeyboardInput(uint8_t Priority);
+uint8_t PostKeyboardInput(ES_Event ThisEvent);
+ES_Event RunKeyboardInput(ES_Event ThisEvent);
+
+#endif /* ES_KEYBOARDINPUT_H */
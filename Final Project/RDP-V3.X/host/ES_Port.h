@@ -0,0 +1,34 @@
+/*
+ * File: ES_Port.h
+ *
+ * Host port layer for the Events and Services framework. On the PIC32 the
+ * critical-section macros mask interrupts, saving and restoring the previous
+ * state since ES_PostToService also uses them from inside an ISR; on the
+ * host the "interrupts" only run between run-to-completion steps, so they
+ * compile to nothing.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_PORT_H
+#define ES_PORT_H
+
+#include <stdint.h>
+
+#define ES_EnterCritical()
+#define ES_ExitCritical()
+
+// Interrupt nesting depth. The PIC32 port reads this from the CP0 status
+// register; here ES_Timer_Tick() brackets itself with ES_ISR_Enter/Exit so
+// ES_PostToService() can tell an "interrupt" post from a task-level one.
+extern volatile uint8_t ES_ISRNesting;
+
+#define ES_ISR_Enter() (ES_ISRNesting++)
+#define ES_ISR_Exit() (ES_ISRNesting--)
+#define ES_InISR() (ES_ISRNesting != 0)
+
+// Number of the highest set bit of a non-zero 32-bit word. Compiles to the
+// clz instruction on both MIPS32 (PIC32) and the usual host targets.
+#define ES_HighestBit(x) (31 - __builtin_clz(x))
+
+#endif /* ES_PORT_H */
@@ -0,0 +1,32 @@
+/*
+ * File: ES_PostList.c
+ *
+ * Distribution lists from ES_Configure.h. RDP-V3.X does not define any
+ * (NUM_DIST_LISTS is 0) so this module is empty unless that changes.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_PostList.h"
+#include "ES_ServiceHeaders.h"
+
+#define ARRAY_SIZE(x) (sizeof (x) / sizeof ((x)[0]))
+
+#if NUM_DIST_LISTS > 0
+static pPostFunc const DistList00[] = {DIST_LIST0};
+
+uint8_t ES_PostList00(ES_Event ThisEvent)
+{
+    uint8_t i;
+
+    for (i = 0; i < ARRAY_SIZE(DistList00); i++) {
+        if (DistList00[i](ThisEvent) != TRUE) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+#endif
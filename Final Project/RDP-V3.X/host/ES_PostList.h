@@ -0,0 +1,39 @@
+/*
+ * File: ES_PostList.h
+ *
+ * Distribution lists from ES_Configure.h (NUM_DIST_LISTS / DIST_LISTn).
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_POSTLIST_H
+#define ES_POSTLIST_H
+
+#include "ES_Events.h"
+
+#if NUM_DIST_LISTS > 0
+uint8_t ES_PostList00(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 1
+uint8_t ES_PostList01(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 2
+uint8_t ES_PostList02(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 3
+uint8_t ES_PostList03(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 4
+uint8_t ES_PostList04(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 5
+uint8_t ES_PostList05(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 6
+uint8_t ES_PostList06(ES_Event ThisEvent);
+#endif
+#if NUM_DIST_LISTS > 7
+uint8_t ES_PostList07(ES_Event ThisEvent);
+#endif
+
+#endif /* ES_POSTLIST_H */
@@ -0,0 +1,92 @@
+/*
+ * File: ES_Queue.c
+ *
+ * Ring-buffer event queues for the host ES runtime. The first element of
+ * each block is reused as the queue header, as in the Gen2 framework.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Port.h"
+#include "ES_Queue.h"
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    unsigned char RingSize;
+    unsigned char CurrentIndex;
+    unsigned char NumEntries;
+} ES_QueueHeader_t;
+
+typedef ES_QueueHeader_t *pQueue_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t ES_InitQueue(ES_Event *pBlock, unsigned char BlockSize)
+{
+    pQueue_t pThisQueue = (pQueue_t) pBlock;
+
+    // the header occupies the first slot
+    pThisQueue->RingSize = BlockSize - 1;
+    pThisQueue->CurrentIndex = 0;
+    pThisQueue->NumEntries = 0;
+    return (pThisQueue->RingSize);
+}
+
+uint8_t ES_EnQueueFIFO(ES_Event *pBlock, ES_Event Event2Add)
+{
+    pQueue_t pThisQueue = (pQueue_t) pBlock;
+
+    if (pThisQueue->NumEntries < pThisQueue->RingSize) {
+        ES_EnterCritical();
+        pBlock[1 + ((pThisQueue->CurrentIndex + pThisQueue->NumEntries)
+                % pThisQueue->RingSize)] = Event2Add;
+        pThisQueue->NumEntries++;
+        ES_ExitCritical();
+        return TRUE;
+    }
+    return FALSE;
+}
+
+uint8_t ES_DeQueue(ES_Event *pBlock, ES_Event *pReturnEvent)
+{
+    pQueue_t pThisQueue = (pQueue_t) pBlock;
+    uint8_t NumLeft;
+
+    if (pThisQueue->NumEntries > 0) {
+        ES_EnterCritical();
+        *pReturnEvent = pBlock[1 + pThisQueue->CurrentIndex];
+        pThisQueue->CurrentIndex++;
+        if (pThisQueue->CurrentIndex >= pThisQueue->RingSize) {
+            pThisQueue->CurrentIndex = 0;
+        }
+        NumLeft = --pThisQueue->NumEntries;
+        ES_ExitCritical();
+    } else {
+        pReturnEvent->EventType = ES_NO_EVENT;
+        pReturnEvent->EventParam = 0;
+        NumLeft = 0;
+    }
+    return NumLeft;
+}
+
+uint8_t ES_QueueCount(ES_Event *pBlock)
+{
+    pQueue_t pThisQueue = (pQueue_t) pBlock;
+    return (pThisQueue->NumEntries);
+}
+
+uint8_t ES_IsQueueEmpty(ES_Event *pBlock)
+{
+    pQueue_t pThisQueue = (pQueue_t) pBlock;
+    return (pThisQueue->NumEntries == 0);
+}
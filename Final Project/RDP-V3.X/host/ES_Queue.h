@@ -0,0 +1,57 @@
+/*
+ * File: ES_Queue.h
+ *
+ * Ring-buffer event queues for the host ES runtime. As in the Gen2
+ * framework the first element of each block holds the queue header, so a
+ * block of N+1 events holds N queued events.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_QUEUE_H
+#define ES_QUEUE_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ES_InitQueue(ES_Event *pBlock, unsigned char BlockSize)
+ * @param pBlock - storage for the queue, header included
+ * @param BlockSize - number of ES_Event elements in pBlock
+ * @return number of events the queue can hold */
+uint8_t ES_InitQueue(ES_Event *pBlock, unsigned char BlockSize);
+
+/**
+ * @Function ES_EnQueueFIFO(ES_Event *pBlock, ES_Event Event2Add)
+ * @param pBlock - an initialized queue
+ * @param Event2Add - event to append
+ * @return TRUE, or FALSE if the queue was full */
+uint8_t ES_EnQueueFIFO(ES_Event *pBlock, ES_Event Event2Add);
+
+/**
+ * @Function ES_DeQueue(ES_Event *pBlock, ES_Event *pReturnEvent)
+ * @param pBlock - an initialized queue
+ * @param pReturnEvent - receives the oldest event
+ * @return number of events left in the queue */
+uint8_t ES_DeQueue(ES_Event *pBlock, ES_Event *pReturnEvent);
+
+/**
+ * @Function ES_QueueCount(ES_Event *pBlock)
+ * @param pBlock - an initialized queue
+ * @return number of events currently queued */
+uint8_t ES_QueueCount(ES_Event *pBlock);
+
+/**
+ * @Function ES_IsQueueEmpty(ES_Event *pBlock)
+ * @param pBlock - an initialized queue
+ * @return TRUE if the queue is empty */
+uint8_t ES_IsQueueEmpty(ES_Event *pBlock);
+
+#endif /* ES_QUEUE_H */
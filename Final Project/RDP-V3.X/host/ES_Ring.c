@@ -0,0 +1,69 @@
+/*
+ * File: ES_Ring.c
+ *
+ * Lock-free SPSC event ring, see ES_Ring.h. Index hand-off uses the GCC
+ * __atomic builtins (also available in XC32) so the event copy is visible
+ * before the index that publishes it, both on the host and on the PIC32.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Ring.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int8_t ES_Ring_Init(ES_Ring_t *pRing, ES_Event *pMem, uint16_t Size)
+{
+    if ((Size == 0) || (Size & (Size - 1))) {
+        return ERROR;
+    }
+    pRing->pMem = pMem;
+    pRing->Mask = Size - 1;
+    pRing->Head = 0;
+    pRing->Tail = 0;
+    pRing->HighWater = 0;
+    pRing->Overflows = 0;
+    return SUCCESS;
+}
+
+uint8_t ES_Ring_Put(ES_Ring_t *pRing, ES_Event ThisEvent)
+{
+    uint16_t Head = pRing->Head;
+    uint16_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);
+    uint16_t Depth = Head - Tail;
+
+    if (Depth > pRing->Mask) {
+        pRing->Overflows++;
+        return FALSE;
+    }
+    pRing->pMem[Head & pRing->Mask] = ThisEvent;
+    __atomic_store_n(&pRing->Head, (uint16_t) (Head + 1), __ATOMIC_RELEASE);
+    if (++Depth > pRing->HighWater) {
+        pRing->HighWater = Depth;
+    }
+    return TRUE;
+}
+
+uint8_t ES_Ring_Get(ES_Ring_t *pRing, ES_Event *pReturnEvent)
+{
+    uint16_t Tail = pRing->Tail;
+
+    if (__atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE) == Tail) {
+        return FALSE;
+    }
+    *pReturnEvent = pRing->pMem[Tail & pRing->Mask];
+    __atomic_store_n(&pRing->Tail, (uint16_t) (Tail + 1), __ATOMIC_RELEASE);
+    return TRUE;
+}
+
+uint8_t ES_Ring_IsEmpty(ES_Ring_t *pRing)
+{
+    return (__atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE) == pRing->Tail);
+}
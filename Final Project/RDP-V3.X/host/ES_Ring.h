@@ -0,0 +1,80 @@
+/*
+ * File: ES_Ring.h
+ *
+ * Single-producer/single-consumer event ring for posting from interrupt
+ * context. The producer only ever writes Head, the consumer (the run loop)
+ * only ever writes Tail, so the consumer never needs to mask interrupts.
+ * Two producers must not be inside ES_Ring_Put at once: when several ISRs
+ * of different priority post to one ring the caller serializes them, as
+ * ES_PostToService does. Both indices free-run and are masked on access,
+ * which is why the ring size has to be a power of two.
+ *
+ * Host simulation only: the rings sit behind this directory's
+ * ES_PostToService(). The robot links the CMPE118 framework library, whose
+ * service queues are still the plain SERV_n_QUEUE_SIZE ones.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_RING_H
+#define ES_RING_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef struct {
+    ES_Event *pMem;
+    uint16_t Mask; // size - 1
+    uint16_t Head; // written by the producer only
+    uint16_t Tail; // written by the consumer only
+    uint16_t HighWater; // deepest the ring has been, producer side
+    uint32_t Overflows; // events refused because the ring was full
+} ES_Ring_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ES_Ring_Init(ES_Ring_t *pRing, ES_Event *pMem, uint16_t Size)
+ * @param pRing - ring to initialize
+ * @param pMem - storage for Size events
+ * @param Size - number of slots, must be a power of two
+ * @return SUCCESS or ERROR if Size is not a power of two
+ * @brief Empties the ring and clears its counters. Unlike ES_InitQueue no
+ *        slot is spent on a header, so all Size slots hold events. */
+int8_t ES_Ring_Init(ES_Ring_t *pRing, ES_Event *pMem, uint16_t Size);
+
+/**
+ * @Function ES_Ring_Put(ES_Ring_t *pRing, ES_Event ThisEvent)
+ * @param pRing - an initialized ring
+ * @param ThisEvent - event to append
+ * @return TRUE, or FALSE if the ring was full
+ * @brief Producer side. Safe to call from an ISR while the consumer is in
+ *        the middle of ES_Ring_Get, but not while another producer is in
+ *        the middle of ES_Ring_Put. */
+uint8_t ES_Ring_Put(ES_Ring_t *pRing, ES_Event ThisEvent);
+
+/**
+ * @Function ES_Ring_Get(ES_Ring_t *pRing, ES_Event *pReturnEvent)
+ * @param pRing - an initialized ring
+ * @param pReturnEvent - receives the oldest event
+ * @return TRUE, or FALSE if the ring was empty
+ * @brief Consumer side. */
+uint8_t ES_Ring_Get(ES_Ring_t *pRing, ES_Event *pReturnEvent);
+
+/**
+ * @Function ES_Ring_IsEmpty(ES_Ring_t *pRing)
+ * @param pRing - an initialized ring
+ * @return TRUE if the ring is empty
+ * @brief Consumer side. */
+uint8_t ES_Ring_IsEmpty(ES_Ring_t *pRing);
+
+#endif /* ES_RING_H */
@@ -0,0 +1,109 @@
+/*
+ * File: ES_ServiceHeaders.h
+ *
+ * Pulls in the public header of every service named in ES_Configure.h.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_SERVICEHEADERS_H
+#define ES_SERVICEHEADERS_H
+
+#include "ES_Configure.h"
+
+#include SERV_0_HEADER
+#if NUM_SERVICES > 1
+#include SERV_1_HEADER
+#endif
+#if NUM_SERVICES > 2
+#include SERV_2_HEADER
+#endif
+#if NUM_SERVICES > 3
+#include SERV_3_HEADER
+#endif
+#if NUM_SERVICES > 4
+#include SERV_4_HEADER
+#endif
+#if NUM_SERVICES > 5
+#include SERV_5_HEADER
+#endif
+#if NUM_SERVICES > 6
+#include SERV_6_HEADER
+#endif
+#if NUM_SERVICES > 7
+#include SERV_7_HEADER
+#endif
+#if NUM_SERVICES > 8
+#include SERV_8_HEADER
+#endif
+#if NUM_SERVICES > 9
+#include SERV_9_HEADER
+#endif
+#if NUM_SERVICES > 10
+#include SERV_10_HEADER
+#endif
+#if NUM_SERVICES > 11
+#include SERV_11_HEADER
+#endif
+#if NUM_SERVICES > 12
+#include SERV_12_HEADER
+#endif
+#if NUM_SERVICES > 13
+#include SERV_13_HEADER
+#endif
+#if NUM_SERVICES > 14
+#include SERV_14_HEADER
+#endif
+#if NUM_SERVICES > 15
+#include SERV_15_HEADER
+#endif
+#if NUM_SERVICES > 16
+#include SERV_16_HEADER
+#endif
+#if NUM_SERVICES > 17
+#include SERV_17_HEADER
+#endif
+#if NUM_SERVICES > 18
+#include SERV_18_HEADER
+#endif
+#if NUM_SERVICES > 19
+#include SERV_19_HEADER
+#endif
+#if NUM_SERVICES > 20
+#include SERV_20_HEADER
+#endif
+#if NUM_SERVICES > 21
+#include SERV_21_HEADER
+#endif
+#if NUM_SERVICES > 22
+#include SERV_22_HEADER
+#endif
+#if NUM_SERVICES > 23
+#include SERV_23_HEADER
+#endif
+#if NUM_SERVICES > 24
+#include SERV_24_HEADER
+#endif
+#if NUM_SERVICES > 25
+#include SERV_25_HEADER
+#endif
+#if NUM_SERVICES > 26
+#include SERV_26_HEADER
+#endif
+#if NUM_SERVICES > 27
+#include SERV_27_HEADER
+#endif
+#if NUM_SERVICES > 28
+#include SERV_28_HEADER
+#endif
+#if NUM_SERVICES > 29
+#include SERV_29_HEADER
+#endif
+#if NUM_SERVICES > 30
+#include SERV_30_HEADER
+#endif
+#if NUM_SERVICES > 31
+#include SERV_31_HEADER
+#endif
+
+#endif /* ES_SERVICEHEADERS_H */
@@ -0,0 +1,16 @@
+/*
+ * File: ES_TattleTale.h
+ *
+ * The host build does not trace the HSM call stack, so ES_Tattle() and
+ * ES_Tail() compile away whether or not USE_TATTLETALE is defined.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_TATTLETALE_H
+#define ES_TATTLETALE_H
+
+#define ES_Tattle()
+#define ES_Tail()
+
+#endif /* ES_TATTLETALE_H */
@@ -0,0 +1,343 @@
+/*
+ * File: ES_Timers.c
+ *
+ * Virtual-clock ES_Timers for the host build. Behaves like the PIC32 module
+ * (1 ms timers routed through the TIMERn_RESP_FUNC table in ES_Configure.h)
+ * except that ES_Timer_Tick() stands in for the Timer1 ISR.
+ *
+ * Instead of sixteen down-counters decremented on every tick, each armed
+ * timer holds its absolute expiry time and sits in one list of a three-level
+ * timing wheel, 32 slots per level plus a list for anything further out:
+ *
+ *   level 0  expires in the current 32 ms block, slot = expiry ms
+ *   level 1  expires in the current 1024 ms block, slot = expiry / 32
+ *   level 2  expires in the current 32768 ms block, slot = expiry / 1024
+ *   far      anything later
+ *
+ * A periodic timer is put straight back in when it expires, one period on
+ * from its due time, so it never drifts.
+ *
+ * A level 0 slot only ever holds timers expiring on that exact tick. At the
+ * start of each block the matching slot of the level above is emptied into
+ * the levels below, so a timer moves down at most three times in its life.
+ *
+ * All the lists are circular and doubly linked through the Next/Prev arrays,
+ * with one sentinel node per list after the timers, so a timer can be
+ * stopped without knowing which list it is in.
+ *
+ * Host simulation only: the robot links the CMPE118 library's ES_Timers,
+ * which keeps its sixteen down-counters and has no periodic timers.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "ES_ServiceHeaders.h"
+#include "ES_Timers.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define WHEEL_BITS 5
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 3
+
+#define FAR_LIST (WHEEL_LEVELS * WHEEL_SLOTS)
+#define NUM_LISTS (FAR_LIST + 1)
+#define NUM_NODES (ES_NUM_TIMERS + NUM_LISTS)
+
+// sentinel node of a list, and of a level's slot
+#define LIST_NODE(List) (ES_NUM_TIMERS + (List))
+#define SLOT_NODE(Level, Slot) LIST_NODE((Level) * WHEEL_SLOTS + (Slot))
+
+#define IS_VALID(Num) (((Num) < ES_NUM_TIMERS) && (PostFuncs[Num] != TIMER_UNUSED))
+#define IS_ARMED(Num) (Next[Num] != (Num))
+
+#if (ES_NUM_TIMERS < ES_NUM_FIXED_TIMERS) || (NUM_NODES > 0xFFFF)
+#error ES_NUM_TIMERS must be at least ES_NUM_FIXED_TIMERS and fit a uint16_t
+#endif
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static void Link(uint16_t Num);
+static void Unlink(uint16_t Node);
+static void Cascade(uint16_t Head);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static pPostFunc const FixedPostFuncs[ES_NUM_FIXED_TIMERS] = {
+    TIMER0_RESP_FUNC, TIMER1_RESP_FUNC, TIMER2_RESP_FUNC, TIMER3_RESP_FUNC,
+    TIMER4_RESP_FUNC, TIMER5_RESP_FUNC, TIMER6_RESP_FUNC, TIMER7_RESP_FUNC,
+    TIMER8_RESP_FUNC, TIMER9_RESP_FUNC, TIMER10_RESP_FUNC, TIMER11_RESP_FUNC,
+    TIMER12_RESP_FUNC, TIMER13_RESP_FUNC, TIMER14_RESP_FUNC, TIMER15_RESP_FUNC
+};
+
+static pPostFunc PostFuncs[ES_NUM_TIMERS];
+// absolute expiry tick while armed, otherwise the ms loaded by SetTimer
+static uint32_t Expiry[ES_NUM_TIMERS];
+// reload of a periodic timer, 0 for a one-shot
+static uint32_t Periods[ES_NUM_TIMERS];
+static uint16_t Next[NUM_NODES];
+static uint16_t Prev[NUM_NODES];
+static uint32_t FreeRunningTimer;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void ES_Timer_Init(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < NUM_NODES; i++) {
+        Next[i] = i;
+        Prev[i] = i;
+    }
+    for (i = 0; i < ES_NUM_TIMERS; i++) {
+        PostFuncs[i] = (i < ES_NUM_FIXED_TIMERS) ? FixedPostFuncs[i] : TIMER_UNUSED;
+        Expiry[i] = 0;
+        Periods[i] = 0;
+    }
+    FreeRunningTimer = 0;
+}
+
+ES_TimerReturn_t ES_Timer_Alloc(pPostFunc PostFunc, uint16_t *pNum)
+{
+    uint16_t i;
+
+    if (PostFunc == TIMER_UNUSED) {
+        return ES_Timer_ERR;
+    }
+    for (i = ES_NUM_FIXED_TIMERS; i < ES_NUM_TIMERS; i++) {
+        if (PostFuncs[i] == TIMER_UNUSED) {
+            PostFuncs[i] = PostFunc;
+            Expiry[i] = 0;
+            Periods[i] = 0;
+            *pNum = i;
+            return ES_Timer_OK;
+        }
+    }
+    return ES_Timer_ERR;
+}
+
+ES_TimerReturn_t ES_Timer_Free(uint16_t Num)
+{
+    if ((Num < ES_NUM_FIXED_TIMERS) || !IS_VALID(Num)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    Unlink(Num);
+    PostFuncs[Num] = TIMER_UNUSED;
+    ES_ExitCritical();
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_SetTimer(uint16_t Num, uint32_t NewTime)
+{
+    if (!IS_VALID(Num) || (NewTime == 0)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    Periods[Num] = 0;
+    if (IS_ARMED(Num)) {
+        Unlink(Num);
+        Expiry[Num] = FreeRunningTimer + NewTime;
+        Link(Num);
+    } else {
+        Expiry[Num] = NewTime;
+    }
+    ES_ExitCritical();
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_StartTimer(uint16_t Num)
+{
+    ES_Event ThisEvent;
+
+    if (!IS_VALID(Num)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    if (!IS_ARMED(Num)) {
+        if (Expiry[Num] == 0) {
+            ES_ExitCritical();
+            return ES_Timer_ERR;
+        }
+        Expiry[Num] += FreeRunningTimer;
+        Link(Num);
+    }
+    ES_ExitCritical();
+    ThisEvent.EventType = ES_TIMERACTIVE;
+    ThisEvent.EventParam = Num;
+    PostFuncs[Num](ThisEvent);
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_StopTimer(uint16_t Num)
+{
+    ES_Event ThisEvent;
+
+    if (!IS_VALID(Num)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    if (IS_ARMED(Num)) {
+        Unlink(Num);
+        Expiry[Num] = 0;
+    }
+    Periods[Num] = 0;
+    ES_ExitCritical();
+    ThisEvent.EventType = ES_TIMERSTOPPED;
+    ThisEvent.EventParam = Num;
+    PostFuncs[Num](ThisEvent);
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_InitTimer(uint16_t Num, uint32_t NewTime)
+{
+    if (!IS_VALID(Num) || (NewTime == 0)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    Unlink(Num);
+    Expiry[Num] = FreeRunningTimer + NewTime;
+    Periods[Num] = 0;
+    Link(Num);
+    ES_ExitCritical();
+    return ES_Timer_OK;
+}
+
+ES_TimerReturn_t ES_Timer_InitPeriodic(uint16_t Num, uint32_t Period, uint32_t Phase)
+{
+    if (!IS_VALID(Num) || (Period == 0)) {
+        return ES_Timer_ERR;
+    }
+    ES_EnterCritical();
+    Unlink(Num);
+    Expiry[Num] = FreeRunningTimer + (Phase ? Phase : Period);
+    Periods[Num] = Period;
+    Link(Num);
+    ES_ExitCritical();
+    return ES_Timer_OK;
+}
+
+uint32_t ES_Timer_GetTime(void)
+{
+    return FreeRunningTimer;
+}
+
+void ES_Timer_Tick(void)
+{
+    ES_Event ThisEvent;
+    uint32_t Now;
+    uint16_t Head, Num;
+
+    ES_ISR_Enter();
+    Now = ++FreeRunningTimer;
+
+    // new block: bring the timers due in it down from the levels above,
+    // highest first so they can fall more than one level
+    if ((Now & WHEEL_MASK) == 0) {
+        if (((Now >> WHEEL_BITS) & WHEEL_MASK) == 0) {
+            if (((Now >> (2 * WHEEL_BITS)) & WHEEL_MASK) == 0) {
+                Cascade(LIST_NODE(FAR_LIST));
+            }
+            Cascade(SLOT_NODE(2, (Now >> (2 * WHEEL_BITS)) & WHEEL_MASK));
+        }
+        Cascade(SLOT_NODE(1, (Now >> WHEEL_BITS) & WHEEL_MASK));
+    }
+
+    // everything left in this slot expires now; periodic timers go back in
+    // one period after when they were due, not after their owner gets to run
+    ThisEvent.EventType = ES_TIMEOUT;
+    Head = SLOT_NODE(0, Now & WHEEL_MASK);
+    while (Next[Head] != Head) {
+        Num = Next[Head];
+        Unlink(Num);
+        if (Periods[Num]) {
+            Expiry[Num] = Now + Periods[Num];
+            Link(Num);
+        } else {
+            Expiry[Num] = 0;
+        }
+        ThisEvent.EventParam = Num;
+        PostFuncs[Num](ThisEvent);
+    }
+    ES_ISR_Exit();
+}
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/**
+ * @Function Link(uint16_t Num)
+ * @param Num - unlinked timer with its expiry time set, later than now
+ * @return None
+ * @brief Adds the timer to the list for the block it expires in. */
+static void Link(uint16_t Num)
+{
+    uint32_t Now = FreeRunningTimer;
+    uint32_t When = Expiry[Num];
+    uint16_t Head;
+
+    if (((When ^ Now) >> WHEEL_BITS) == 0) {
+        Head = SLOT_NODE(0, When & WHEEL_MASK);
+    } else if (((When ^ Now) >> (2 * WHEEL_BITS)) == 0) {
+        Head = SLOT_NODE(1, (When >> WHEEL_BITS) & WHEEL_MASK);
+    } else if (((When ^ Now) >> (3 * WHEEL_BITS)) == 0) {
+        Head = SLOT_NODE(2, (When >> (2 * WHEEL_BITS)) & WHEEL_MASK);
+    } else {
+        Head = LIST_NODE(FAR_LIST);
+    }
+    Next[Num] = Head;
+    Prev[Num] = Prev[Head];
+    Next[Prev[Head]] = Num;
+    Prev[Head] = Num;
+}
+
+/**
+ * @Function Unlink(uint16_t Node)
+ * @param Node - timer to take out of its list, may already be unlinked
+ * @return None */
+static void Unlink(uint16_t Node)
+{
+    Next[Prev[Node]] = Next[Node];
+    Prev[Next[Node]] = Prev[Node];
+    Next[Node] = Node;
+    Prev[Node] = Node;
+}
+
+/**
+ * @Function Cascade(uint16_t Head)
+ * @param Head - sentinel of the list to empty
+ * @return None
+ * @brief Re-links every timer in the list against the current time. The
+ *        list is detached first, since far timers can land back in it. */
+static void Cascade(uint16_t Head)
+{
+    uint16_t Node = Next[Head];
+    uint16_t Following;
+
+    // the last timer still points back at Head, which ends the walk
+    Next[Head] = Head;
+    Prev[Head] = Head;
+    while (Node != Head) {
+        Following = Next[Node];
+        Link(Node);
+        Node = Following;
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * File: ES_Timers.h
+ *
+ * Virtual-clock version of the ES_Timers module. The sixteen fixed timers
+ * and their response functions are configured in ES_Configure.h exactly as
+ * on the PIC32; the only difference is that the 1 ms tick is driven by
+ * ES_Timer_Tick() instead of the Timer1 interrupt.
+ *
+ * Timers ES_NUM_FIXED_TIMERS and up are handed out at run time by
+ * ES_Timer_Alloc(), each with its own response function, so a state that
+ * needs a timer of its own doesn't have to share one and sort the timeouts
+ * out by EventParam. Any timer can be made periodic with
+ * ES_Timer_InitPeriodic(). Armed timers sit in a hierarchical timing wheel,
+ * so a tick only touches the timers that expire on it (plus, every 32 ticks,
+ * the ones moving down a level), however many are armed.
+ *
+ * ES_Timer_Alloc(), ES_Timer_Free() and ES_Timer_InitPeriodic() are host
+ * only, for the benchmarks: the CMPE118 ES_Timers the robot links has just
+ * the sixteen one-shot timers, so the project sources keep to those.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ES_TIMERS_H
+#define ES_TIMERS_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "ES_Events.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+// timers 0 to 15, TIMER0_RESP_FUNC to TIMER15_RESP_FUNC in ES_Configure.h
+#define ES_NUM_FIXED_TIMERS 16
+
+// fixed timers plus handles for ES_Timer_Alloc(), 16 bytes of RAM each on
+// the PIC32 on top of about 400 for the wheel itself
+#ifndef ES_NUM_TIMERS
+#define ES_NUM_TIMERS 32
+#endif
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+typedef enum {
+    ES_Timer_ERR = -1,
+    ES_Timer_ACTIVE = 1,
+    ES_Timer_OK = 0,
+    ES_Timer_NOT_ACTIVE = 0
+} ES_TimerReturn_t;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function ES_Timer_Init(void)
+ * @param None
+ * @return None
+ * @brief Stops every timer, frees every allocated handle and resets the
+ *        virtual clock to zero. */
+void ES_Timer_Init(void);
+
+/**
+ * @Function ES_Timer_Alloc(pPostFunc PostFunc, uint16_t *pNum)
+ * @param PostFunc - response function the timer's events are posted to
+ * @param pNum - set to the new timer's number
+ * @return ES_Timer_ERR if PostFunc is NULL or every handle is taken,
+ *         ES_Timer_OK otherwise
+ * @brief Allocates a stopped timer; use it like a fixed one. */
+ES_TimerReturn_t ES_Timer_Alloc(pPostFunc PostFunc, uint16_t *pNum);
+
+/**
+ * @Function ES_Timer_Free(uint16_t Num)
+ * @param Num - timer from ES_Timer_Alloc()
+ * @return ES_Timer_ERR if Num is a fixed or unallocated timer, ES_Timer_OK
+ *         otherwise
+ * @brief Stops the timer without posting ES_TIMERSTOPPED and returns the
+ *        handle. */
+ES_TimerReturn_t ES_Timer_Free(uint16_t Num);
+
+/**
+ * @Function ES_Timer_SetTimer(uint16_t Num, uint32_t NewTime)
+ * @param Num - timer number, below ES_NUM_TIMERS
+ * @param NewTime - timeout in ms
+ * @return ES_Timer_ERR if Num has no response function, ES_Timer_OK otherwise
+ * @brief Loads the timer without starting it; a running timer is restarted
+ *        with the new time. Either way it becomes a one-shot. */
+ES_TimerReturn_t ES_Timer_SetTimer(uint16_t Num, uint32_t NewTime);
+
+/**
+ * @Function ES_Timer_StartTimer(uint16_t Num)
+ * @param Num - timer number, below ES_NUM_TIMERS
+ * @return ES_Timer_ERR if Num has no response function or no time loaded,
+ *         ES_Timer_OK otherwise
+ * @brief Starts a loaded timer and posts ES_TIMERACTIVE to its owner. An
+ *        expired timer has to be loaded again first. */
+ES_TimerReturn_t ES_Timer_StartTimer(uint16_t Num);
+
+/**
+ * @Function ES_Timer_StopTimer(uint16_t Num)
+ * @param Num - timer number, below ES_NUM_TIMERS
+ * @return ES_Timer_ERR or ES_Timer_OK
+ * @brief Stops a timer and posts ES_TIMERSTOPPED to its owner. */
+ES_TimerReturn_t ES_Timer_StopTimer(uint16_t Num);
+
+/**
+ * @Function ES_Timer_InitTimer(uint16_t Num, uint32_t NewTime)
+ * @param Num - timer number, below ES_NUM_TIMERS
+ * @param NewTime - timeout in ms
+ * @return ES_Timer_ERR or ES_Timer_OK
+ * @brief Loads and starts a one-shot timer; ES_TIMEOUT with EventParam = Num
+ *        is posted to the timer's response function when it expires. */
+ES_TimerReturn_t ES_Timer_InitTimer(uint16_t Num, uint32_t NewTime);
+
+/**
+ * @Function ES_Timer_InitPeriodic(uint16_t Num, uint32_t Period, uint32_t Phase)
+ * @param Num - timer number, below ES_NUM_TIMERS
+ * @param Period - ms between timeouts
+ * @param Phase - ms to the first timeout, or 0 for one Period
+ * @return ES_Timer_ERR or ES_Timer_OK
+ * @brief Starts a timer that posts ES_TIMEOUT every Period ms until it is
+ *        stopped or re-initialized. It is re-armed in the tick that expires
+ *        it, so the timeouts stay on a fixed grid however long the owner
+ *        takes to handle them. */
+ES_TimerReturn_t ES_Timer_InitPeriodic(uint16_t Num, uint32_t Period, uint32_t Phase);
+
+/**
+ * @Function ES_Timer_GetTime(void)
+ * @param None
+ * @return virtual ms since ES_Timer_Init() */
+uint32_t ES_Timer_GetTime(void);
+
+/**
+ * @Function ES_Timer_Tick(void)
+ * @param None
+ * @return None
+ * @brief Host replacement for the Timer1 interrupt: advances the virtual
+ *        clock by 1 ms and posts ES_TIMEOUT for every timer that expires. */
+void ES_Timer_Tick(void);
+
+#endif /* ES_TIMERS_H */
@@ -0,0 +1,223 @@
+/*
+ * File: Robot.c
+ *
+ * Simulated robot drive: motor commands are latched for the simulator,
+ * counted as register writes and passed on to the PWM module as the
+ * magnitude of the speed, and the bumper port is whatever the simulator last
+ * wrote with Sim_SetBumpers(), which runs the bumper hook (Sim_SetBumperHook)
+ * in interrupt context when the port changes.
+ *
+ * The drive wheels are modelled every tick (Sim_DriveTick()). A wheel's rim
+ * follows its motor's speed with the motor's lag, MOTOR_TAU_MS, and the floor
+ * under it follows the rim only as fast as the tyre's grip
+ * (Sim_SetTraction()) allows. Past that the tyre slips, and
+ * while it slips it grips less and unevenly, KINETIC of the traction give or
+ * take SLIP_JITTER each ms, so how far a slipping wheel gets differs run to
+ * run. The robot's pose is worked out from the travel of both wheels.
+ *
+ * A motor's speed falls with the battery (Sim_SetBattery()), which reads on
+ * BAT_VOLTAGE in proportion.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "AD.h"
+#include "BOARD.h"
+#include "ES_Port.h"
+#include "Robot.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define LEFT_PWM PWM_PORTY12
+#define RIGHT_PWM PWM_PORTY10
+#define CANNON_PWM PWM_PORTX11
+
+#define DUTY(Speed) ((unsigned int) ((Speed) < 0 ? -(Speed) : (Speed)) * MAX_PWM / ROBOT_MAX_SPEED)
+
+// drive model, speeds in motor speed units
+#define MOTOR_TAU_MS 25.0f
+#define NO_SLIP 1000.0f // traction no motor can break
+#define GRIP_BAND 0.25f // rim and floor speeds this close are gripping
+#define KINETIC 0.7f // share of the traction left to a slipping tyre
+#define SLIP_JITTER 0.3f
+#define MM_PER_UNIT_MS 0.001027f // floor travel of a wheel at speed 1 for 1 ms
+#define WHEELBASE_MM 250.0f
+#define SLIP_SEED 118
+#define BATTERY_FULL_COUNTS 279 // BAT_VOLTAGE of a charged battery
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static int8_t LeftSpeed;
+static int8_t RightSpeed;
+static int8_t CannonSpeed;
+static uint8_t Bumpers;
+static SimBumperHook_t BumperHook;
+
+static float Rim[2]; // left, right
+static float Floor[2];
+static float Traction;
+static float Battery; // share of a charged battery's motor speed
+static SimPose_t Pose;
+static uint32_t SlipRandom;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+void Robot_Init(void)
+{
+    LeftSpeed = 0;
+    RightSpeed = 0;
+    CannonSpeed = 0;
+    Bumpers = 0;
+    BumperHook = (SimBumperHook_t) 0;
+    Rim[0] = Rim[1] = 0;
+    Floor[0] = Floor[1] = 0;
+    Traction = NO_SLIP;
+    Sim_SetBattery(100);
+    memset(&Pose, 0, sizeof (Pose));
+    SlipRandom = SLIP_SEED;
+    PWM_AddPins(ROBOT_PWM_PINS);
+    PWM_SetDutyCycle(LEFT_PWM, 0);
+    PWM_SetDutyCycle(RIGHT_PWM, 0);
+    PWM_SetDutyCycle(CANNON_PWM, 0);
+}
+
+char Robot_LeftMtrSpeed(char newSpeed)
+{
+    if ((newSpeed < -ROBOT_MAX_SPEED) || (newSpeed > ROBOT_MAX_SPEED)) {
+        return ERROR;
+    }
+    SimStats.MotorWrites++;
+    LeftSpeed = newSpeed;
+    PWM_SetDutyCycle(LEFT_PWM, DUTY(newSpeed));
+    return SUCCESS;
+}
+
+char Robot_RightMtrSpeed(char newSpeed)
+{
+    if ((newSpeed < -ROBOT_MAX_SPEED) || (newSpeed > ROBOT_MAX_SPEED)) {
+        return ERROR;
+    }
+    SimStats.MotorWrites++;
+    RightSpeed = newSpeed;
+    PWM_SetDutyCycle(RIGHT_PWM, DUTY(newSpeed));
+    return SUCCESS;
+}
+
+char CannonMtrSpeed(char newSpeed)
+{
+    if ((newSpeed < 0) || (newSpeed > ROBOT_MAX_SPEED)) {
+        return ERROR;
+    }
+    SimStats.MotorWrites++;
+    CannonSpeed = newSpeed;
+    PWM_SetDutyCycle(CANNON_PWM, DUTY(newSpeed));
+    return SUCCESS;
+}
+
+unsigned char Robot_ReadBumpers(void)
+{
+    SimStats.BumperReads++;
+    return Bumpers;
+}
+
+char Robot_ReadFrontLeftBumper(void)
+{
+    return (Robot_ReadBumpers() & FRONT_LEFT_BUMPER) ? BUMPER_TRIPPED : BUMPER_NOT_TRIPPED;
+}
+
+char Robot_ReadFrontRightBumper(void)
+{
+    return (Robot_ReadBumpers() & FRONT_RIGHT_BUMPER) ? BUMPER_TRIPPED : BUMPER_NOT_TRIPPED;
+}
+
+char Robot_ReadSideBumper(void)
+{
+    return (Robot_ReadBumpers() & SIDE_BUMPER) ? BUMPER_TRIPPED : BUMPER_NOT_TRIPPED;
+}
+
+void Sim_SetBumperHook(SimBumperHook_t Hook)
+{
+    BumperHook = Hook;
+}
+
+void Sim_SetBumpers(uint8_t Mask)
+{
+    Mask &= FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER;
+    if (Mask == Bumpers) {
+        return;
+    }
+    Bumpers = Mask;
+    if (BumperHook) {
+        ES_ISR_Enter();
+        BumperHook(Mask);
+        ES_ISR_Exit();
+    }
+}
+
+int8_t Sim_GetLeftMtr(void)
+{
+    return LeftSpeed;
+}
+
+int8_t Sim_GetRightMtr(void)
+{
+    return RightSpeed;
+}
+
+int8_t Sim_GetCannonMtr(void)
+{
+    return CannonSpeed;
+}
+
+void Sim_SetTraction(float UnitsPerMs)
+{
+    Traction = UnitsPerMs;
+}
+
+void Sim_SetBattery(uint8_t Percent)
+{
+    Battery = Percent / 100.0f;
+    Sim_SetADPin(BAT_VOLTAGE, BATTERY_FULL_COUNTS * Percent / 100);
+}
+
+void Sim_GetPose(SimPose_t *pPose)
+{
+    *pPose = Pose;
+}
+
+void Sim_DriveTick(void)
+{
+    const int8_t Command[2] = {LeftSpeed, RightSpeed};
+    float Change, Limit, Travel[2];
+    uint8_t i;
+
+    for (i = 0; i < 2; i++) {
+        Rim[i] += (Command[i] * Battery - Rim[i]) / MOTOR_TAU_MS;
+        Change = Rim[i] - Floor[i];
+        Limit = Traction;
+        if (fabsf(Change) > Limit + GRIP_BAND) {
+            SlipRandom = SlipRandom * 1103515245 + 12345;
+            Limit *= KINETIC * (1.0f + SLIP_JITTER * (((SlipRandom >> 16) & 0x7fff) / 16384.0f - 1.0f));
+        }
+        Floor[i] += fmaxf(-Limit, fminf(Limit, Change));
+        Travel[i] = Floor[i] * MM_PER_UNIT_MS;
+    }
+    Pose.LeftMm += Travel[0];
+    Pose.RightMm += Travel[1];
+    Pose.Heading += (Travel[0] - Travel[1]) / WHEELBASE_MM;
+    Pose.X += (Travel[0] + Travel[1]) / 2 * cos(Pose.Heading);
+    Pose.Y += (Travel[0] + Travel[1]) / 2 * sin(Pose.Heading);
+}
@@ -0,0 +1,94 @@
+/*
+ * File: Robot.h
+ *
+ * Host stand-in for the RDP robot library (drive motors, cannon motor and
+ * bumpers). Motor commands are latched for the simulator and set the duty
+ * cycle of the motor's PWM pin, each counted as one write of the motor's
+ * direction pins, and the bumper port is whatever the simulator last wrote.
+ * A change on the port runs the bumper hook in interrupt context, as the
+ * PIC32's change notification on the bumper pins does.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef ROBOT_H
+#define ROBOT_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "pwm.h"
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define ROBOT_MAX_SPEED 100
+
+/* the PWM pins of the left, right and cannon motors */
+#define ROBOT_PWM_PINS (PWM_PORTY12 | PWM_PORTY10 | PWM_PORTX11)
+
+#define BUMPER_TRIPPED 1
+#define BUMPER_NOT_TRIPPED 0
+
+/* bit positions returned by Robot_ReadBumpers() */
+#define FRONT_LEFT_BUMPER 0x01
+#define FRONT_RIGHT_BUMPER 0x02
+#define SIDE_BUMPER 0x04
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Robot_Init(void)
+ * @param None
+ * @return None
+ * @brief Stops every motor and releases the bumpers. Call after PWM_Init(). */
+void Robot_Init(void);
+
+/**
+ * @Function Robot_LeftMtrSpeed(char newSpeed)
+ * @param newSpeed - -100 to 100
+ * @return SUCCESS or ERROR */
+char Robot_LeftMtrSpeed(char newSpeed);
+
+/**
+ * @Function Robot_RightMtrSpeed(char newSpeed)
+ * @param newSpeed - -100 to 100
+ * @return SUCCESS or ERROR */
+char Robot_RightMtrSpeed(char newSpeed);
+
+/**
+ * @Function CannonMtrSpeed(char newSpeed)
+ * @param newSpeed - 0 to 100
+ * @return SUCCESS or ERROR */
+char CannonMtrSpeed(char newSpeed);
+
+/**
+ * @Function Robot_ReadBumpers(void)
+ * @param None
+ * @return 3-bit mask of FRONT_LEFT_BUMPER, FRONT_RIGHT_BUMPER and SIDE_BUMPER */
+unsigned char Robot_ReadBumpers(void);
+
+/**
+ * @Function Robot_ReadFrontLeftBumper(void)
+ * @param None
+ * @return BUMPER_TRIPPED or BUMPER_NOT_TRIPPED */
+char Robot_ReadFrontLeftBumper(void);
+
+/**
+ * @Function Robot_ReadFrontRightBumper(void)
+ * @param None
+ * @return BUMPER_TRIPPED or BUMPER_NOT_TRIPPED */
+char Robot_ReadFrontRightBumper(void);
+
+/**
+ * @Function Robot_ReadSideBumper(void)
+ * @param None
+ * @return BUMPER_TRIPPED or BUMPER_NOT_TRIPPED */
+char Robot_ReadSideBumper(void);
+
+#endif /* ROBOT_H */
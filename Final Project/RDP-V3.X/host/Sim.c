@@ -0,0 +1,100 @@
+/*
+ * File: Sim.c
+ *
+ * Virtual clock and run-loop driver for the host build of RDP-V3.X.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <string.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "pwm.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Sim.h"
+#include "xc.h"
+
+/*******************************************************************************
+ * PUBLIC VARIABLES                                                            *
+ ******************************************************************************/
+
+SimStats_t SimStats;
+unsigned int SimCoreSkew;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static SimTickHook_t TickHook;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+char Sim_Init(void)
+{
+    BOARD_Init();
+    AD_Init();
+    PWM_Init();
+    Robot_Init();
+    TickHook = (SimTickHook_t) 0;
+    SimCoreSkew = 0;
+    if (ES_Initialize() != Success) {
+        return ERROR;
+    }
+    Sim_Drain();
+    Sim_ResetStats();
+    return SUCCESS;
+}
+
+void Sim_SetTickHook(SimTickHook_t Hook)
+{
+    TickHook = Hook;
+}
+
+void Sim_Tick(void)
+{
+    Sim_DriveTick();
+    if (TickHook) {
+        TickHook(ES_Timer_GetTime() + 1);
+    }
+    Sim_ADScan();
+    ES_Timer_Tick();
+}
+
+uint32_t Sim_Drain(void)
+{
+    uint32_t Count = 0;
+
+    do {
+        while (ES_RunStep() == TRUE) {
+            Count++;
+        }
+    } while (ES_CheckUserEvents() == TRUE);
+    SimStats.Dispatches += Count;
+    return Count;
+}
+
+void Sim_RunFor(uint32_t Ms)
+{
+    while (Ms--) {
+        Sim_Tick();
+        Sim_Drain();
+    }
+}
+
+void Sim_AddCoreTicks(uint32_t Ticks)
+{
+    SimCoreSkew += Ticks;
+}
+
+void Sim_ResetStats(void)
+{
+    memset(&SimStats, 0, sizeof (SimStats));
+}
@@ -0,0 +1,213 @@
+/*
+ * File: Sim.h
+ *
+ * Simulator control for the host build of RDP-V3.X. The simulated HAL
+ * (BOARD/AD/pwm/Robot) reads its inputs from here and the host ES runtime
+ * uses the virtual clock driven from here, so a run is fully deterministic:
+ * time only advances when Sim_Tick() is called.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC TYPEDEFS                                                             *
+ ******************************************************************************/
+
+/* hardware access counters, incremented by the simulated HAL */
+typedef struct {
+    uint32_t ADReads;
+    uint32_t BumperReads;
+    uint32_t MotorWrites;
+    uint32_t PWMWrites;
+    uint32_t Dispatches;
+} SimStats_t;
+
+/* where the drive model has the robot, from where Robot_Init() left it */
+typedef struct {
+    double X; // mm, forward from the start
+    double Y; // mm, right of the start
+    double Heading; // radians, clockwise from the start
+    double LeftMm; // floor travel of each wheel, backwards taken off
+    double RightMm;
+} SimPose_t;
+
+typedef void (*SimTickHook_t)(uint32_t Now);
+
+typedef void (*SimBumperHook_t)(unsigned char Bumpers);
+
+typedef void (*SimSerialSink_t)(char ch);
+
+/*******************************************************************************
+ * PUBLIC VARIABLES                                                            *
+ ******************************************************************************/
+
+extern SimStats_t SimStats;
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function Sim_Init(void)
+ * @param None
+ * @return SUCCESS or ERROR
+ * @brief Resets the simulated hardware and the virtual clock, then runs
+ *        ES_Initialize() and drains the ES_INIT events. */
+char Sim_Init(void);
+
+/**
+ * @Function Sim_SetADPin(unsigned int Pin, uint16_t Value)
+ * @param Pin - a single AD_PORTxx pin
+ * @param Value - 10-bit sample the next scan converts
+ * @return None */
+void Sim_SetADPin(unsigned int Pin, uint16_t Value);
+
+/**
+ * @Function Sim_SetADTone(unsigned int Pin, uint16_t Amplitude, uint16_t Hz)
+ * @param Pin - a single AD_PORTxx pin
+ * @param Amplitude - peak of the tone in AD counts, 0 for none
+ * @param Hz - frequency of the tone
+ * @return None
+ * @brief Adds a sine to the pin's value in every scan, as the beacon
+ *        detector's output would. */
+void Sim_SetADTone(unsigned int Pin, uint16_t Amplitude, uint16_t Hz);
+
+/**
+ * @Function Sim_ADScan(void)
+ * @param None
+ * @return None
+ * @brief Completes one conversion scan of the enabled pins, for
+ *        AD_ReadADPin() and AD_IsNewDataReady(). Sim_Tick() scans once per
+ *        tick; tests can call it directly, followed by ADAcquire_CheckScan()
+ *        where the ES loop is not running. */
+void Sim_ADScan(void);
+
+/**
+ * @Function Sim_GetADReads(unsigned int Pin)
+ * @param Pin - a single AD_PORTxx pin
+ * @return AD_ReadADPin() calls on that pin since AD_Init() */
+uint32_t Sim_GetADReads(unsigned int Pin);
+
+/**
+ * @Function Sim_SetBumpers(uint8_t Mask)
+ * @param Mask - FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER
+ * @return None
+ * @brief A mask that differs from the port's runs the bumper hook
+ *        (Sim_SetBumperHook()) in interrupt context. */
+void Sim_SetBumpers(uint8_t Mask);
+
+/**
+ * @Function Sim_SetBumperHook(SimBumperHook_t Hook)
+ * @param Hook - called with the new bumper mask whenever any bumper pin
+ *        changes, or NULL
+ * @return None
+ * @brief The pin-change side of the bumper port, for host/BumperNotify.c to
+ *        play the interrupts from. Robot_Init() clears the hook. */
+void Sim_SetBumperHook(SimBumperHook_t Hook);
+
+/**
+ * @Function Sim_GetLeftMtr(void), Sim_GetRightMtr(void), Sim_GetCannonMtr(void)
+ * @param None
+ * @return the last speed commanded on that motor */
+int8_t Sim_GetLeftMtr(void);
+int8_t Sim_GetRightMtr(void);
+int8_t Sim_GetCannonMtr(void);
+
+/**
+ * @Function Sim_SetTraction(float UnitsPerMs)
+ * @param UnitsPerMs - the most a gripping tyre can change the wheel's floor
+ *        speed in a ms, in motor speed units
+ * @return None
+ * @brief A motor follows its speed with a 25 ms lag, so one stepped by
+ *        Change first pulls its wheel on by Change / 25 a ms and slips its
+ *        tyre on any traction under that. Robot_Init() sets a traction that
+ *        never slips. */
+void Sim_SetTraction(float UnitsPerMs);
+
+/**
+ * @Function Sim_SetBattery(uint8_t Percent)
+ * @param Percent - battery charge, as a share of a charged battery's voltage
+ * @return None
+ * @brief The motors turn at Percent of the speed they are given, and
+ *        BAT_VOLTAGE reads Percent of a charged battery's counts. Robot_Init()
+ *        sets 100. */
+void Sim_SetBattery(uint8_t Percent);
+
+/**
+ * @Function Sim_GetPose(SimPose_t *pPose)
+ * @param pPose - filled with the robot's pose
+ * @return None */
+void Sim_GetPose(SimPose_t *pPose);
+
+/**
+ * @Function Sim_DriveTick(void)
+ * @param None
+ * @return None
+ * @brief Moves the drive model on a ms at the speeds the motors have been
+ *        given. Sim_Tick() runs it once per tick. */
+void Sim_DriveTick(void);
+
+/**
+ * @Function Sim_SetTickHook(SimTickHook_t Hook)
+ * @param Hook - called at the start of every tick with the new time, or NULL
+ * @return None
+ * @brief Scenario scripts use the hook to drive sensor inputs over time. */
+void Sim_SetTickHook(SimTickHook_t Hook);
+
+/**
+ * @Function Sim_SetSerialSink(SimSerialSink_t Sink)
+ * @param Sink - called with every byte PutChar() transmits, or NULL for
+ *        stdout
+ * @return None
+ * @brief Lets a test take what the robot sends over the UART. */
+void Sim_SetSerialSink(SimSerialSink_t Sink);
+
+/**
+ * @Function Sim_Tick(void)
+ * @param None
+ * @return None
+ * @brief Advances the virtual clock by one 1 ms timer interrupt, after
+ *        one A/D scan of the inputs the tick hook has just set. The drive
+ *        model moves on a ms first. */
+void Sim_Tick(void);
+
+/**
+ * @Function Sim_Drain(void)
+ * @param None
+ * @return number of events dispatched
+ * @brief Runs the ES loop, services then event checkers, until every
+ *        service queue is empty and no checker posts anything. */
+uint32_t Sim_Drain(void);
+
+/**
+ * @Function Sim_RunFor(uint32_t Ms)
+ * @param Ms - virtual milliseconds to run
+ * @return None
+ * @brief Alternates Sim_Tick() and Sim_Drain() for Ms ticks. */
+void Sim_RunFor(uint32_t Ms);
+
+/**
+ * @Function Sim_AddCoreTicks(uint32_t Ticks)
+ * @param Ticks - core timer ticks, 40 a us
+ * @return None
+ * @brief Moves the core timer stand-in of host/xc.h on by Ticks without
+ *        moving the ms clock, as if the code had taken that long between
+ *        two reads of it. Sim_Init() puts the two back in step. */
+void Sim_AddCoreTicks(uint32_t Ticks);
+
+/**
+ * @Function Sim_ResetStats(void)
+ * @param None
+ * @return None */
+void Sim_ResetStats(void);
+
+#endif /* SIM_H */
@@ -0,0 +1,181 @@
+/*
+ * File: bench_actuators.c
+ *
+ * Motor register writes with the Actuators shadow. The robot is run in
+ * virtual time two ways:
+ *
+ *   field   the tape, beacon, track wire and bumpers of bench_cpu's field
+ *   events  the same, with one of bench_dispatch's events (sensor edges and
+ *           timeouts) posted to RobotHSM at random every 20 ms on top, so
+ *           the states come and go far faster than on the field
+ *
+ * For each, per virtual second: the motor speeds the state machines asked
+ * for, the robot library motor calls Actuators made for them, and the
+ * register writes those cost on the simulated robot (SimStats, a direction
+ * port write per call and a PWM duty write per motor). Before Actuators
+ * every speed asked for was its own library call, so the writes before are
+ * two a speed.
+ *
+ * Fails if the shadow ever makes more writes than writing through would.
+ *
+ * usage: bench_actuators [virtual seconds]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Actuators.h"
+#include "RobotHSM.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 600
+#define RANDOM_SEED 118
+#define EVENT_EVERY_MS 20
+#define WRITES_PER_CALL 2 // direction port and PWM duty, one motor
+
+// the field, as bench_cpu has it
+#define FLOOR_READING 500 // tape sensors over the floor
+#define TAPE_LOW 150 // and over tape, where the right one reads high
+#define TAPE_HIGH 850
+#define TAPE_CHANGE 40 // chance in 10000 each ms
+#define BEACON_HEARD 150 // the beacon board's output, low while it hears it
+#define BEACON_QUIET 800
+#define BEACON_CHANGE 1
+#define TRACK_LOW 400
+#define TRACK_HIGH 950
+#define TRACK_CHANGE 10
+#define BUMP_CHANGE 20
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const ES_Event EventMix[] = {
+    {Beacon_found, 0}, {No_Beacon_found, 0},
+    {Wall_found, 0}, {No_Wall_found, 0},
+    {FrontRightBump, 0}, {NoFrontRightBump, 0},
+    {FrontLeftBump, 0}, {NoFrontLeftBump, 0},
+    {SideBump, 0}, {NoSideBump, 0},
+    {FrontRightTape, 0}, {NoFrontRightTape, 0},
+    {FrontLeftTape, 0}, {NoFrontLeftTape, 0},
+    {CannonTape, 0}, {NoCannonTape, 0},
+    {ES_TIMEOUT, HSM_TIMER}, {ES_TIMEOUT, SEARCH_TIMER},
+    {ES_TIMEOUT, PURSUE_TIMER}, {ES_TIMEOUT, DESTROY_TIMER},
+    {ES_TIMEOUT, ESCAPE_TIMER}, {MotionDone, 0},
+    {TurnComplete, 0}, {DistanceReached, 0},
+};
+
+static uint32_t RandomState;
+static uint8_t PostEvents;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static void FieldInputs(uint32_t Now)
+{
+    static const unsigned int TapePins[] = {AD_PORTV6, AD_PORTV4, AD_PORTV3};
+    static const uint16_t TapeReadings[] = {TAPE_LOW, TAPE_HIGH, TAPE_LOW};
+    static const unsigned int TrackPins[] = {AD_PORTW7, AD_PORTW8};
+    static uint16_t Track = TRACK_LOW;
+    uint8_t i;
+
+    if (Now == 1) {
+        Track = TRACK_LOW;
+        for (i = 0; i < 3; i++) {
+            Sim_SetADPin(TapePins[i], FLOOR_READING);
+        }
+        Sim_SetADPin(AD_PORTW6, BEACON_QUIET);
+        Sim_SetBumpers(0);
+    }
+    if ((NextRandom() % 10000) < TAPE_CHANGE) {
+        i = NextRandom() % 3;
+        Sim_SetADPin(TapePins[i], (NextRandom() & 1) ? TapeReadings[i] : FLOOR_READING);
+    }
+    if ((NextRandom() % 10000) < BEACON_CHANGE) {
+        Sim_SetADPin(AD_PORTW6, (NextRandom() & 1) ? BEACON_HEARD : BEACON_QUIET);
+    }
+    if ((NextRandom() % 10000) < TRACK_CHANGE) {
+        Track = (Track == TRACK_LOW) ? TRACK_HIGH : TRACK_LOW;
+    }
+    for (i = 0; i < 2; i++) {
+        Sim_SetADPin(TrackPins[i], Track);
+    }
+    if ((NextRandom() % 10000) < BUMP_CHANGE) {
+        Sim_SetBumpers(NextRandom() & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+    if (PostEvents && ((Now % EVENT_EVERY_MS) == 0)) {
+        PostRobotHSM(EventMix[NextRandom() % (sizeof (EventMix) / sizeof (EventMix[0]))]);
+    }
+}
+
+static int RunScenario(const char *Name, uint8_t Events, uint32_t RunS)
+{
+    ActuatorStats_t Stats;
+    uint32_t Writes, WritesBefore;
+    uint8_t Failed;
+
+    RandomState = RANDOM_SEED;
+    PostEvents = Events;
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_actuators: init failed\n");
+        return 1;
+    }
+    Sim_SetTickHook(FieldInputs);
+    Sim_RunFor(RunS * 1000);
+    Sim_SetTickHook((SimTickHook_t) 0);
+    Actuators_GetStats(&Stats);
+    Writes = SimStats.MotorWrites + SimStats.PWMWrites;
+    WritesBefore = Stats.Commands * WRITES_PER_CALL;
+    Failed = (Stats.Commands == 0) || (Writes > WritesBefore);
+    printf("  %-7s %8.2f %8.2f %8.2f %8.2f %5.0f%%%s\n", Name,
+            (double) Stats.Commands / RunS, (double) Stats.Calls / RunS,
+            (double) WritesBefore / RunS, (double) Writes / RunS,
+            WritesBefore ? 100.0 * (WritesBefore - Writes) / WritesBefore : 0.0,
+            Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunS = DEFAULT_RUN_S;
+    int Failed = 0;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (RunS == 0) {
+        fprintf(stderr, "bench_actuators: bad run length\n");
+        return 1;
+    }
+    printf("bench_actuators: %u s each, per virtual second\n", RunS);
+    printf("  run       speeds    calls   writes   writes  saved\n");
+    printf("                                before    after\n");
+    Failed |= RunScenario("field", FALSE, RunS);
+    Failed |= RunScenario("events", TRUE, RunS);
+    return Failed;
+}
@@ -0,0 +1,277 @@
+/*
+ * File: bench_adring.c
+ *
+ * Test for the ADAcquire sample rings. A synthetic ADC feed stands in for the
+ * end-of-scan interrupt:
+ *
+ *   every   one thread plays the interrupt and converts sequence-numbered
+ *           samples into a ring as fast as it can, the other reads them with
+ *           ADAcquire_Read(); the reader checks they come out in order with
+ *           no sample twice, and that read + lost == converted
+ *   latest  the same feed read with ADAcquire_Latest(), which must never
+ *           hand out a sample older than one it already returned
+ *   robot   RobotSensors in virtual time with inputs changing at random;
+ *           each pin may only be read with AD_ReadADPin() once per scan, by
+ *           ADAcquire_CheckScan(), and every sample the service takes must
+ *           be fresh: one per pin per NewADSamples wakeup; the checker must
+ *           find every scan on time
+ *   stall   the same run, with the ES loop held for two scans now and then:
+ *           the checker must count the scan each stall loses as missed
+ *
+ * usage: bench_adring [scans per pass]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADAcquire.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_SCANS 2000000
+#define TEST_PIN AD_PORTV5 // RobotSensors doesn't use it
+#define TEST_EVERY 4
+#define YIELD_ODDS 64 // the feed lets the reader in after one scan in this many
+#define SIM_RUN_MS 60000
+#define RANDOM_SEED 118
+#define STALL_EVERY 97 // ms between stalls of the stall pass
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    unsigned int Pins;
+    uint16_t Every;
+    uint16_t Phase;
+    uint8_t AllSamples; // reads every conversion, not one per wakeup
+} Service_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// the subscription made in RobotSensors' init function, split by how the
+// pins are read; the beacon is a level, read like the rest unless
+// RobotSensors is built with BEACON_GOERTZEL
+static const Service_t Services[] = {
+    {"sensors", AD_PORTV6 | AD_PORTV4 | AD_PORTV3 | AD_PORTW6 | AD_PORTW7 | AD_PORTW8,
+        5, 5, FALSE},
+};
+
+static uint32_t NumScans;
+static volatile uint8_t FeedDone;
+static uint32_t Wakeups;
+static uint32_t RandomState = RANDOM_SEED;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint8_t CountWakeup(ES_Event ThisEvent)
+{
+    if ((ThisEvent.EventType == NewADSamples) && (ThisEvent.EventParam == TEST_PIN)) {
+        Wakeups++;
+    }
+    return TRUE;
+}
+
+/* the end-of-scan interrupt, converting 0, 1, 2... on the test pin */
+static void *Feed(void *Arg)
+{
+    uint16_t Values[AD_NUM_PINS] = {0};
+    uint32_t Seed = RANDOM_SEED, i;
+
+    for (i = 0; i < NumScans; i++) {
+        Values[__builtin_ctz(TEST_PIN)] = (uint16_t) i;
+        ADAcquire_ScanComplete(Values, TEST_PIN);
+        Seed = Seed * 1103515245 + 12345;
+        if (((Seed >> 16) % YIELD_ODDS) == 0) {
+            sched_yield();
+        }
+    }
+    FeedDone = TRUE;
+    return NULL;
+}
+
+static int RunFeed(const char *Name, uint8_t Latest)
+{
+    ADAcquireStats_t Before, After;
+    pthread_t Thread;
+    uint32_t Received = 0, OrderErrors = 0, Samples, Reads, Lost;
+    uint16_t Sample, Last = 0;
+    uint8_t Got, Draining = FALSE, Failed;
+
+    ADAcquire_Subscribe(TEST_PIN, CountWakeup, TEST_EVERY, 0);
+    ADAcquire_GetStats(TEST_PIN, &Before);
+    Wakeups = 0;
+    FeedDone = FALSE;
+    pthread_create(&Thread, NULL, Feed, NULL);
+    for (;;) {
+        Got = Latest ? ADAcquire_Latest(TEST_PIN, &Sample) : ADAcquire_Read(TEST_PIN, &Sample);
+        if (Got) {
+            // 16-bit sequence: a wrapped difference of 0 is a repeat, and
+            // anything past the ring is a sample from the future
+            if (Received && ((uint16_t) (Sample - Last) == 0
+                    || (uint16_t) (Sample - Last) > 0x8000)) {
+                OrderErrors++;
+            }
+            Last = Sample;
+            Received++;
+        } else if (Draining) {
+            break;
+        } else if (FeedDone) {
+            Draining = TRUE; // one last look after the feed has finished
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(Thread, NULL);
+
+    ADAcquire_GetStats(TEST_PIN, &After);
+    Samples = After.Samples - Before.Samples;
+    Reads = After.Reads - Before.Reads;
+    Lost = After.Lost - Before.Lost;
+    Failed = (Samples != NumScans) || (Reads != Received) || (OrderErrors != 0)
+            || (Wakeups != NumScans / TEST_EVERY) || (Last != (uint16_t) (NumScans - 1))
+            || (!Latest && (Reads + Lost != Samples));
+    printf("  %-7s %u converted, %u read, %u lost, %u out of order, %u wakeups%s\n",
+            Name, Samples, Reads, Lost, OrderErrors, Wakeups, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+/* checks the scans taken since the last call against what was converted */
+static int PrintPace(const char *Name, uint32_t Stalls)
+{
+    static ADScanStats_t Last;
+    ADScanStats_t Now;
+    uint32_t Taken, Missed, Early;
+    uint8_t Failed;
+
+    ADAcquire_GetScanStats(&Now);
+    Taken = Now.Taken - Last.Taken;
+    Missed = Now.Missed - Last.Missed;
+    Early = Now.Early - Last.Early;
+    Last = Now;
+    Failed = (Taken != SIM_RUN_MS - Stalls) || (Missed != Stalls) || (Early != 0);
+    printf("  %-7s %u scans taken, %u missed, %u early, longest gap %.1f ms%s\n", Name,
+            Taken, Missed, Early, Now.Longest / (BOARD_SYS_CLOCK / 2000.0),
+            Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+static void RandomInputs(uint32_t Now)
+{
+    static const unsigned int Pins[] = {
+        AD_PORTV6, AD_PORTV4, AD_PORTV3, AD_PORTW6, AD_PORTW7, AD_PORTW8
+    };
+
+    if ((NextRandom() % 8) == 0) {
+        Sim_SetADPin(Pins[NextRandom() % 6], NextRandom() % (AD_MAX_VALUE + 1));
+    }
+}
+
+static int RunRobot(void)
+{
+    ADAcquireStats_t Stats;
+    const Service_t *pService;
+    unsigned int Rest;
+    uint32_t Expected, Samples, Reads, Converter = 0;
+    uint8_t i, Failed = FALSE, Stale, Reread = FALSE;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_adring: init failed\n");
+        return 1;
+    }
+    Sim_SetTickHook(RandomInputs);
+    Sim_RunFor(SIM_RUN_MS);
+    Sim_SetTickHook((SimTickHook_t) 0);
+
+    for (i = 0; i < sizeof (Services) / sizeof (Services[0]); i++) {
+        pService = &Services[i];
+        Expected = (SIM_RUN_MS - pService->Phase) / pService->Every + 1;
+        Samples = 0;
+        Reads = 0;
+        Stale = FALSE;
+        for (Rest = pService->Pins; Rest; Rest &= Rest - 1) {
+            ADAcquire_GetStats(Rest & -Rest, &Stats);
+            Samples += Stats.Samples;
+            Reads += Stats.Reads;
+            Stale |= (Stats.Reads != (pService->AllSamples ? Stats.Samples : Expected))
+                    || (Stats.Lost != 0);
+        }
+        Failed |= Stale;
+        printf("  robot   %-10s %u wakeups, %6u samples converted, %4u read%s\n",
+                pService->Name, Expected, Samples, Reads, Stale ? "  FAILED" : "");
+    }
+    // nothing but the checker reads the converter, and it reads each scan once
+    for (Rest = AD_ActivePins(); Rest; Rest &= Rest - 1) {
+        Reread |= (Sim_GetADReads(Rest & -Rest) != SIM_RUN_MS);
+        Converter += Sim_GetADReads(Rest & -Rest);
+    }
+    Reread |= (SimStats.ADReads != Converter);
+    printf("  robot   %u AD_ReadADPin() calls in %u ms, %u scans%s\n",
+            SimStats.ADReads, SIM_RUN_MS, SIM_RUN_MS, Reread ? "  FAILED" : "");
+    return Failed || Reread || PrintPace("robot", 0);
+}
+
+/* the ES loop held up for a scan every STALL_EVERY ms, so the checker only
+ * sees the second of the two */
+static int RunStalls(void)
+{
+    uint32_t Ms, Stalls = 0;
+
+    for (Ms = 0; Ms < SIM_RUN_MS; Ms++) {
+        if (((Ms % STALL_EVERY) == STALL_EVERY - 1) && (Ms + 1 < SIM_RUN_MS)) {
+            Sim_Tick();
+            Ms++;
+            Stalls++;
+        }
+        Sim_Tick();
+        Sim_Drain();
+    }
+    return PrintPace("stall", Stalls);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    int Failed = 0;
+
+    NumScans = DEFAULT_SCANS;
+    if (argc > 1) {
+        NumScans = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+
+    printf("bench_adring: %u scans per feed pass, ring of %d\n", NumScans, AD_RING_SIZE);
+    AD_Init();
+    Failed |= RunFeed("every", FALSE);
+    Failed |= RunFeed("latest", TRUE);
+    Failed |= RunRobot();
+    Failed |= RunStalls();
+    return Failed;
+}
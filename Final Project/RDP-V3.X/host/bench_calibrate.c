@@ -0,0 +1,379 @@
+/*
+ * File: bench_calibrate.c
+ *
+ * Test for the learned sensor thresholds. Two parts:
+ *
+ *   statistics  Calibrate fed long runs of synthetic samples alongside a
+ *               double-precision model of the same running mean and
+ *               deviation, through the startup count and well past the
+ *               window; the largest difference of either, in counts, is
+ *               reported
+ *   fields      a tape sensor set up the way RobotSensors sets it up
+ *               (8-scan average, Comparator) and fed by the simulated
+ *               converter, on fields whose floor and tape read higher or
+ *               lower than the one the fixed threshold of 300 was tuned on:
+ *
+ *     tuned   the field the fixed threshold was set on
+ *     dark    a floor and tape that read half as high
+ *     bright  a floor and tape that read half as high again
+ *     drift   the tuned field, with floor and tape sliding down to half and
+ *             back over the run, as a floor in and out of shadow does
+ *
+ * Each field is run with the fixed threshold and with the threshold learned
+ * the way RobotSensors learns it from the start of the run, which stands for
+ * the startup spin. Scored after the spin:
+ *
+ *   wrong   decisions that disagree with the tape, leaving out the SETTLE_MS
+ *           after each change
+ *   false   tapes found that were not there
+ *   missed  tapes that went by unseen
+ *
+ * and the learned threshold at the end of the run is shown.
+ *
+ * Fails if the statistics are more than a count out, or if the learned
+ * threshold has a false tape or a miss on any field.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADAcquire.h"
+#include "Calibrate.h"
+#include "Comparator.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+// as RobotSensors has them for the left tape sensor, which reads low over tape
+#define TAPE_PIN AD_PORTV3
+#define AVERAGE 8
+#define THRESHOLD 300
+#define MIN_MARGIN 100
+#define HYSTERESIS 25
+#define WINDOW 4096
+#define MIN_SAMPLES 1024
+#define SIGMAS 3
+#define SETTLE_TICKS 20
+#define UPDATE_TICKS 200
+#define TICK_SCANS 5
+#define DECISION_TICKS 3
+
+#define STATS_SAMPLES 20000
+#define STATS_TOLERANCE 1.0
+
+#define RUN_MS 300000
+#define SPIN_MS 8500 // RobotHSM's first Lookout
+#define SETTLE_MS 30
+#define MIN_TAPE_MS 60
+#define MAX_TAPE_MS 300
+#define MIN_FLOOR_MS 200
+#define MAX_FLOOR_MS 1500
+#define FLOOR_LOW 450 // readings over the tuned floor
+#define FLOOR_HIGH 600
+#define TAPE_LOW 100 // and over its tape
+#define TAPE_HIGH 200
+#define NOISE 10
+#define RANDOM_SEED 118
+
+#define NUM_STREAMS (sizeof (Streams) / sizeof (Streams[0]))
+#define NUM_FIELDS (sizeof (Fields) / sizeof (Fields[0]))
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    uint16_t (*Next)(uint32_t n);
+} Stream_t;
+
+/* double-precision model of a Calibration_t */
+typedef struct {
+    double Mean;
+    double M2;
+    uint32_t Count;
+    uint32_t Window;
+} Model_t;
+
+typedef struct {
+    const char *Name;
+    double Scale; // of the tuned field's readings
+    uint8_t Drift;
+} Field_t;
+
+typedef struct {
+    uint32_t Decisions;
+    uint32_t Wrong;
+    uint32_t False;
+    uint32_t Missed;
+    uint16_t Threshold;
+    uint8_t Found;
+    uint8_t Seen;
+} Score_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint16_t Uniform(uint32_t n);
+static uint16_t Bell(uint32_t n);
+static uint16_t Ramp(uint32_t n);
+static uint16_t Step(uint32_t n);
+static uint8_t Wakeup(ES_Event ThisEvent);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const Stream_t Streams[] = {
+    {"uniform", Uniform},
+    {"bell", Bell},
+    {"ramp", Ramp},
+    {"step", Step},
+};
+
+static const Field_t Fields[] = {
+    {"tuned", 1.0, FALSE},
+    {"dark", 0.5, FALSE},
+    {"bright", 1.5, FALSE},
+    {"drift", 1.0, TRUE},
+};
+
+static uint32_t RandomState;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static int32_t Between(int32_t Low, int32_t High)
+{
+    return Low + (int32_t) (NextRandom() % (uint32_t) (High - Low + 1));
+}
+
+/* synthetic streams for the statistics */
+static uint16_t Uniform(uint32_t n)
+{
+    return Between(400, 600);
+}
+
+static uint16_t Bell(uint32_t n)
+{
+    return 500 + Between(-40, 40) + Between(-40, 40) + Between(-40, 40) + Between(-40, 40);
+}
+
+/* a baseline drifting up most of the range, with noise */
+static uint16_t Ramp(uint32_t n)
+{
+    return 100 + (800 * n) / STATS_SAMPLES + Between(-20, 20);
+}
+
+/* a baseline that jumps half way through */
+static uint16_t Step(uint32_t n)
+{
+    return ((n < STATS_SAMPLES / 2) ? 300 : 700) + Between(-20, 20);
+}
+
+static void ModelAdd(Model_t *pModel, uint16_t Sample)
+{
+    double Delta = Sample - pModel->Mean;
+
+    if (pModel->Count < pModel->Window) {
+        pModel->Count++;
+    }
+    pModel->Mean += Delta / pModel->Count;
+    pModel->M2 += Delta * (Sample - pModel->Mean);
+    if (pModel->Count == pModel->Window) {
+        pModel->M2 -= pModel->M2 / pModel->Window;
+    }
+}
+
+/* one stream through Calibrate and the model; returns TRUE if it failed */
+static uint8_t RunStream(const Stream_t *pStream)
+{
+    Calibration_t Calibration;
+    Model_t Model = {0, 0, 0, WINDOW};
+    double MeanError = 0, SigmaError = 0, Error;
+    uint16_t Sample;
+    uint32_t n;
+
+    RandomState = RANDOM_SEED;
+    Calibrate_Init(&Calibration, WINDOW);
+    for (n = 0; n < STATS_SAMPLES; n++) {
+        Sample = pStream->Next(n);
+        Calibrate_Add(&Calibration, Sample);
+        ModelAdd(&Model, Sample);
+        Error = fabs(Calibrate_Mean(&Calibration) - Model.Mean);
+        MeanError = (Error > MeanError) ? Error : MeanError;
+        Error = fabs(Calibrate_Sigma(&Calibration) - sqrt(Model.M2 / Model.Count));
+        SigmaError = (Error > SigmaError) ? Error : SigmaError;
+    }
+    printf("  %-8s  mean %4u  sigma %3u   worst error: mean %4.2f  sigma %4.2f%s\n",
+            pStream->Name, Calibrate_Mean(&Calibration), Calibrate_Sigma(&Calibration),
+            MeanError, SigmaError,
+            ((MeanError > STATS_TOLERANCE) || (SigmaError > STATS_TOLERANCE)) ? "  FAILED" : "");
+    return (MeanError > STATS_TOLERANCE) || (SigmaError > STATS_TOLERANCE);
+}
+
+static uint8_t Wakeup(ES_Event ThisEvent)
+{
+    return TRUE;
+}
+
+/* RobotSensors' LearnThresholds() for the one channel */
+static void Learn(ComparatorBank_t *pBank, Calibration_t *pCalibration, uint16_t Input,
+        uint16_t *pThreshold, uint32_t Tick)
+{
+    if (Tick <= SETTLE_TICKS) {
+        return;
+    }
+    if ((Calibrate_Count(pCalibration) == 0)
+            || (Input + MIN_MARGIN > Calibrate_Mean(pCalibration))) {
+        Calibrate_Add(pCalibration, Input);
+    }
+    if (((Tick % UPDATE_TICKS) == 0) && (Calibrate_Count(pCalibration) >= MIN_SAMPLES)) {
+        *pThreshold = Calibrate_Threshold(pCalibration, SIGMAS, MIN_MARGIN, TRUE);
+        Comparator_SetChannel(pBank, 0, *pThreshold, HYSTERESIS, TRUE);
+    }
+}
+
+/* one decision against where the tape really is */
+static void Score(Score_t *pScore, uint8_t Found, uint8_t Tape, uint8_t Settled)
+{
+    if (Found && !pScore->Found) {
+        if (Tape) {
+            pScore->Seen = TRUE;
+        } else if (Settled) {
+            pScore->False++;
+        }
+    }
+    pScore->Found = Found;
+    if (Settled) {
+        pScore->Decisions++;
+        pScore->Wrong += (Found != Tape);
+    }
+}
+
+/* the floor and tape readings, as a share of the tuned field's */
+static double FieldScale(const Field_t *pField, uint32_t Time)
+{
+    if (!pField->Drift) {
+        return pField->Scale;
+    }
+    // down to half by the middle of the run and back
+    return pField->Scale * (0.5 + fabs((double) Time / RUN_MS - 0.5));
+}
+
+static void RunField(const Field_t *pField, uint8_t Learning, Score_t *pScore)
+{
+    ComparatorBank_t Bank;
+    ADFilter_t Filter;
+    Calibration_t Calibration;
+    uint16_t Input = 0, Threshold = THRESHOLD, Level = 0;
+    uint32_t Time, SegmentEnd = 0, Changed = 0, Tick = 0;
+    uint8_t Tape = TRUE, Settled;
+
+    RandomState = RANDOM_SEED;
+    AD_Init();
+    ADAcquire_Subscribe(TAPE_PIN, Wakeup, TICK_SCANS, 0);
+    ADFilter_InitAverage(&Filter, AVERAGE);
+    ADAcquire_SetFilter(TAPE_PIN, &Filter);
+    Comparator_Init(&Bank, 1);
+    Comparator_SetChannel(&Bank, 0, THRESHOLD, HYSTERESIS, TRUE);
+    Calibrate_Init(&Calibration, WINDOW);
+    pScore->Seen = TRUE;
+
+    for (Time = 0; Time < RUN_MS; Time++) {
+        if (Time >= SegmentEnd) {
+            Tape = !Tape;
+            if (Tape) {
+                pScore->Seen = FALSE;
+                Level = Between(TAPE_LOW, TAPE_HIGH);
+                SegmentEnd = Time + Between(MIN_TAPE_MS, MAX_TAPE_MS);
+            } else {
+                pScore->Missed += (Time > SPIN_MS) && !pScore->Seen;
+                Level = Between(FLOOR_LOW, FLOOR_HIGH);
+                SegmentEnd = Time + Between(MIN_FLOOR_MS, MAX_FLOOR_MS);
+            }
+            Changed = Time;
+        }
+        Sim_SetADPin(TAPE_PIN, lround(Level * FieldScale(pField, Time)) + Between(-NOISE, NOISE));
+        Sim_ADScan();
+        ADAcquire_CheckScan();
+        Settled = ((Time - Changed) >= SETTLE_MS) && (Time >= SPIN_MS);
+        if (((Time + 1) % TICK_SCANS) != 0) {
+            continue;
+        }
+        Tick++;
+        ADAcquire_Latest(TAPE_PIN, &Input);
+        if (Learning) {
+            Learn(&Bank, &Calibration, Input, &Threshold, Tick);
+        }
+        Comparator_Update(&Bank, &Input);
+        if ((Tick % DECISION_TICKS) == 0) {
+            Score(pScore, Comparator_Active(&Bank) != 0, Tape, Settled);
+        }
+    }
+    pScore->Missed += Tape && !pScore->Seen;
+    pScore->Threshold = Threshold;
+}
+
+static void PrintScore(const Score_t *pScore)
+{
+    printf("  %6.2f%%  %5u  %6u  %9u", 100.0 * pScore->Wrong / pScore->Decisions, pScore->False,
+            pScore->Missed, pScore->Threshold);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(void)
+{
+    Score_t Fixed, Learned;
+    uint8_t i, Failed = FALSE;
+
+    printf("bench_calibrate: window of %d samples, thresholds %d deviations or %d counts"
+            " from the mean\n", WINDOW, SIGMAS, MIN_MARGIN);
+    printf("  statistics, %d samples against the double-precision model\n", STATS_SAMPLES);
+    for (i = 0; i < NUM_STREAMS; i++) {
+        Failed |= RunStream(&Streams[i]);
+    }
+
+    printf("  fields, %u s each, %d s spin, the tuned floor reading %d-%d and"
+            " its tape %d-%d\n", RUN_MS / 1000, SPIN_MS / 1000, FLOOR_LOW, FLOOR_HIGH,
+            TAPE_LOW, TAPE_HIGH);
+    printf("  %-8s  %33s   %33s\n", "", "fixed", "learned");
+    printf("  %-8s  %7s  %5s  %6s  %9s   %7s  %5s  %6s  %9s\n", "field",
+            "wrong", "false", "missed", "threshold", "wrong", "false", "missed", "threshold");
+    for (i = 0; i < NUM_FIELDS; i++) {
+        Fixed = (Score_t) {0};
+        Learned = (Score_t) {0};
+        RunField(&Fields[i], FALSE, &Fixed);
+        RunField(&Fields[i], TRUE, &Learned);
+        printf("  %-8s", Fields[i].Name);
+        PrintScore(&Fixed);
+        printf(" ");
+        PrintScore(&Learned);
+        if (Learned.False || Learned.Missed) {
+            printf("  FAILED");
+            Failed = TRUE;
+        }
+        printf("\n");
+    }
+    return Failed;
+}
@@ -0,0 +1,302 @@
+/*
+ * File: bench_cnbump.c
+ *
+ * Test for the bumper change notification path in RobotSensors. The robot is
+ * run in virtual time with the bumpers pressed and released at random,
+ * bouncing for a few ms on every transition, and the odd 1 ms glitch, the
+ * same bumping bench_debounce does. The time from each contact (the first
+ * edge of a transition) to the ms its edge reaches RobotHSM, as
+ * SensorDelta_GetLevels() has it, is taken three ways:
+ *
+ *   polled 5 ms     no interrupt, the bumper group run every tick, as the
+ *                   bumpers were read before RobotSensors_Attend
+ *   polled 10 ms    no interrupt, the bumper group at its watched rate; this
+ *                   is also the fallback the service keeps for lost edges
+ *   change notify   the interrupts, with the group at its watched rate; the
+ *                   front bumpers only (BUMPER_NOTIFY_PINS)
+ *   side, polled    the same run, the side bumper, which has no interrupt
+ *                   and goes the polled 10 ms way
+ *
+ * The bumpers are watched at the pass's rate after every ms, whatever
+ * RobotHSM asks for, but RobotHSM still stops watching them now and then as
+ * it reacts to the bumps; a transition that comes while it is not watching
+ * is counted as unwatched, not missed, whether or not it is reported.
+ * Reported for each are the p50, p90, p99 and worst latency of the watched
+ * transitions, the ones never reported and the edges that were not a
+ * transition (bounce or glitches).
+ *
+ * Fails if a watched transition is missed or an extra edge reported with the
+ * interrupts on, for any bumper, or if the interrupt bumpers are not faster
+ * than polling at p99.
+ *
+ * usage: bench_cnbump [virtual seconds]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "Robot.h"
+#include "BumperNotify.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "RobotSensors.h"
+#include "SensorDelta.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 3600
+#define RANDOM_SEED 118
+
+#define NUM_BUMPERS 3
+#define MIN_GAP_MS 200
+#define MAX_GAP_MS 3000
+#define MIN_PRESS_MS 40
+#define MAX_PRESS_MS 600
+#define MAX_BOUNCE_MS 10
+#define GLITCH_ODDS 3000
+#define LATE_MS 100 // longest a transition may take to be reported
+#define RESYNC_MS 10 // for the bumper group to be run again once watched
+
+#define SENSOR_BUMPS (SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP | SENSOR_SIDE_BUMP)
+#define ALL_BUMPERS (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER)
+#define NUM_PASSES (sizeof (Passes) / sizeof (Passes[0]))
+#define NOTIFY_PASS 2 // and the one after it is the same run's other bumpers
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+/* one bumper's real state */
+typedef struct {
+    uint8_t Bit; // on the port
+    uint8_t Channel; // SENSOR_* bit
+    uint8_t Pressed;
+    uint32_t Next; // ms of the next transition
+    uint32_t BounceEnd;
+    uint32_t Contact; // ms of the transition not yet reported, 0 if none
+    uint8_t Unwatched; // RobotHSM stopped watching since the contact
+} Bumper_t;
+
+typedef struct {
+    const char *Name;
+    uint8_t Interrupt;
+    uint8_t Fast; // RobotSensors_Attend() Fast channels
+    uint8_t Scored; // port bits of the bumpers it counts
+    uint32_t Transitions;
+    uint32_t Missed;
+    uint32_t Unwatched;
+    uint32_t Extra;
+    uint32_t NumLatencies;
+    uint16_t *Latencies;
+} Pass_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t RandomState;
+static uint32_t WatchedAgain; // ms the bumper group is back after RobotHSM
+static uint8_t Reported; // bumper levels RobotHSM has been given
+static Bumper_t Bumpers[NUM_BUMPERS] = {
+    {FRONT_RIGHT_BUMPER, SENSOR_RIGHT_BUMP},
+    {FRONT_LEFT_BUMPER, SENSOR_LEFT_BUMP},
+    {SIDE_BUMPER, SENSOR_SIDE_BUMP},
+};
+
+static Pass_t Passes[] = {
+    {"polled 5 ms", FALSE, SENSOR_BUMPS, ALL_BUMPERS},
+    {"polled 10 ms", FALSE, 0, ALL_BUMPERS},
+    {"change notify", TRUE, 0, BUMPER_NOTIFY_PINS},
+    {"side, polled", TRUE, 0, ALL_BUMPERS & ~BUMPER_NOTIFY_PINS},
+};
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint32_t Between(uint32_t Low, uint32_t High)
+{
+    return Low + NextRandom() % (High - Low + 1);
+}
+
+/* the bumper port for the ms starting at Now, with the transitions counted */
+static void StepBumpers(uint32_t Now)
+{
+    Bumper_t *pBumper;
+    uint8_t Port = 0, Level, i;
+
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        pBumper = &Bumpers[i];
+        if (Now >= pBumper->Next) {
+            pBumper->Pressed = !pBumper->Pressed;
+            pBumper->Next = Now + (pBumper->Pressed ? Between(MIN_PRESS_MS, MAX_PRESS_MS)
+                    : Between(MIN_GAP_MS, MAX_GAP_MS));
+            pBumper->BounceEnd = Now + Between(0, MAX_BOUNCE_MS);
+            pBumper->Contact = Now;
+            // one that leaves RobotHSM where it already is, because the
+            // last was unwatched, has nothing to report
+            pBumper->Unwatched = (Now < WatchedAgain)
+                    || (((Reported & pBumper->Channel) != 0) == pBumper->Pressed);
+        }
+        Level = pBumper->Pressed;
+        if (Now < pBumper->BounceEnd) {
+            Level = NextRandom() & 1;
+        } else if ((NextRandom() % GLITCH_ODDS) == 0) {
+            Level = !Level;
+        }
+        Port |= Level ? pBumper->Bit : 0;
+    }
+    Sim_SetBumpers(Port);
+}
+
+/* the edges RobotHSM got this ms, against the transitions waiting for one */
+static void Score(Pass_t *pPass, uint8_t Changed, uint8_t Levels, uint32_t Now)
+{
+    Bumper_t *pBumper;
+    uint8_t i;
+
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        pBumper = &Bumpers[i];
+        if (!(pPass->Scored & pBumper->Bit)) {
+            continue;
+        }
+        if ((Changed & pBumper->Channel) && pBumper->Contact
+                && (((Levels & pBumper->Channel) != 0) == pBumper->Pressed)) {
+            if (pBumper->Unwatched) {
+                pPass->Unwatched++;
+            } else {
+                pPass->Latencies[pPass->NumLatencies++] = Now - pBumper->Contact;
+            }
+            pBumper->Contact = 0;
+        } else if (Changed & pBumper->Channel) {
+            pPass->Extra++;
+        } else if (pBumper->Contact && (Now - pBumper->Contact > LATE_MS)) {
+            if (pBumper->Unwatched) {
+                pPass->Unwatched++;
+            } else {
+                pPass->Missed++;
+            }
+            pBumper->Contact = 0;
+        }
+    }
+}
+
+/* RobotHSM has stopped watching the bumpers: whatever is waiting, and
+ * whatever comes before the group is run again, is unwatched */
+static void Unwatch(uint32_t Now)
+{
+    uint8_t i;
+
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        Bumpers[i].Unwatched = TRUE;
+    }
+    WatchedAgain = Now + RESYNC_MS;
+}
+
+static int CompareLatency(const void *pA, const void *pB)
+{
+    return (int) *(const uint16_t *) pA - (int) *(const uint16_t *) pB;
+}
+
+static uint16_t Percentile(const Pass_t *pPass, uint8_t Percent)
+{
+    if (pPass->NumLatencies == 0) {
+        return 0;
+    }
+    return pPass->Latencies[(pPass->NumLatencies - 1) * Percent / 100];
+}
+
+static int RunPass(Pass_t *pPass, uint32_t RunS)
+{
+    uint32_t Now;
+    uint8_t Levels, i;
+
+    RandomState = RANDOM_SEED;
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        Bumpers[i].Pressed = FALSE;
+        Bumpers[i].Next = Between(MIN_GAP_MS, MAX_GAP_MS);
+        Bumpers[i].BounceEnd = 0;
+        Bumpers[i].Contact = 0;
+    }
+    WatchedAgain = 0;
+    Reported = 0;
+    pPass->Latencies = malloc(RunS * 1000 / MIN_PRESS_MS * NUM_BUMPERS * sizeof (uint16_t));
+    if ((pPass->Latencies == NULL) || (Sim_Init() != SUCCESS)) {
+        fprintf(stderr, "bench_cnbump: init failed\n");
+        return 1;
+    }
+    if (!pPass->Interrupt) {
+        Sim_SetBumperHook((SimBumperHook_t) 0);
+    }
+    for (Now = 1; Now <= RunS * 1000; Now++) {
+        StepBumpers(Now);
+        Sim_Tick();
+        Sim_Drain();
+        if ((RobotSensors_GetWatched() & SENSOR_BUMPS) != SENSOR_BUMPS) {
+            Unwatch(Now);
+        }
+        RobotSensors_Attend(SENSOR_ALL, pPass->Fast);
+        Levels = SensorDelta_GetLevels() & SENSOR_BUMPS;
+        Score(pPass, Levels ^ Reported, Levels, Now);
+        Reported = Levels;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    Pass_t *pPass;
+    uint32_t RunS = DEFAULT_RUN_S;
+    uint8_t Failed, i;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (RunS == 0) {
+        fprintf(stderr, "bench_cnbump: bad run length\n");
+        return 1;
+    }
+    printf("bench_cnbump: %u s of bumping, presses %u-%u ms bouncing up to %u ms,"
+            " contact to RobotHSM in ms\n", RunS, MIN_PRESS_MS, MAX_PRESS_MS, MAX_BOUNCE_MS);
+    printf("  path           transitions unwatched   p50   p90   p99  worst  missed  extra\n");
+    for (i = 0; i < NUM_PASSES; i++) {
+        pPass = &Passes[i];
+        if (RunPass(pPass, RunS)) {
+            return 1;
+        }
+        qsort(pPass->Latencies, pPass->NumLatencies, sizeof (uint16_t), CompareLatency);
+        pPass->Transitions = pPass->NumLatencies + pPass->Missed + pPass->Unwatched;
+        printf("  %-14s %11u %9u %5u %5u %5u %6u %7u %6u\n", pPass->Name, pPass->Transitions,
+                pPass->Unwatched, Percentile(pPass, 50), Percentile(pPass, 90),
+                Percentile(pPass, 99), Percentile(pPass, 100), pPass->Missed, pPass->Extra);
+    }
+    pPass = &Passes[NOTIFY_PASS];
+    Failed = pPass->Missed || pPass->Extra || pPass[1].Missed || pPass[1].Extra
+            || (Percentile(pPass, 99) >= Percentile(&Passes[0], 99));
+    if (Failed) {
+        printf("  FAILED\n");
+    }
+    for (i = 0; i < NUM_PASSES; i++) {
+        free(Passes[i].Latencies);
+    }
+    return Failed;
+}
@@ -0,0 +1,161 @@
+/*
+ * File: bench_coalesce.c
+ *
+ * Queue-pressure test for the SensorDelta post path. The robot is run in
+ * virtual time while a tick hook drives the tape, bumper, beacon and track
+ * wire inputs, and afterwards the test checks that no edge was dropped on
+ * the way to RobotHSM:
+ *
+ *   aligned - every 180 ms, a whole number of every sensor period, every
+ *             input flips at once, so each channel group sees all of its
+ *             channels change on the same acquisition
+ *   random  - inputs change at pseudo-random times, so edges also pile up
+ *             on a channel before RobotHSM has taken the last one
+ *
+ * Each pass prints the edges RobotSensors saw against the SensorDelta
+ * events that carried them; before coalescing every edge was its own event.
+ *
+ * usage: bench_coalesce [virtual ms per pass]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "RobotSensors.h"
+#include "SensorDelta.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_MS 180000
+#define ALIGNED_PERIOD 180 // lcm of the bumper, tape, track wire and beacon periods
+#define RANDOM_SEED 118
+#define ROBOT_HSM_SERVICE 2
+
+// AD readings either side of RobotSensors' thresholds
+#define AD_LOW 100
+#define AD_MID 512
+#define AD_HIGH 900
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t RandomState = RANDOM_SEED;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+/* every tape, beacon and track wire channel active or inactive */
+static void SetAnalogInputs(uint8_t Active)
+{
+    Sim_SetADPin(AD_PORTV6, Active ? AD_LOW : AD_MID); // cannon tape
+    Sim_SetADPin(AD_PORTV4, Active ? AD_HIGH : AD_MID); // right tape
+    Sim_SetADPin(AD_PORTV3, Active ? AD_LOW : AD_MID); // left tape
+    Sim_SetADPin(AD_PORTW6, Active ? AD_LOW : AD_MID); // beacon
+    Sim_SetADPin(AD_PORTW7, Active ? AD_HIGH : AD_MID); // track wire
+    Sim_SetADPin(AD_PORTW8, Active ? AD_HIGH : AD_MID);
+}
+
+static void AlignedHook(uint32_t Now)
+{
+    uint8_t Active;
+
+    if ((Now % ALIGNED_PERIOD) != 0) {
+        return;
+    }
+    // swapping right for side gives RobotSensors two bumper edges on the one
+    // reading
+    Active = (Now / ALIGNED_PERIOD) & 1;
+    SetAnalogInputs(Active);
+    Sim_SetBumpers(Active ? FRONT_RIGHT_BUMPER : SIDE_BUMPER);
+}
+
+static void RandomHook(uint32_t Now)
+{
+    static const unsigned int Pins[] = {
+        AD_PORTV6, AD_PORTV4, AD_PORTV3, AD_PORTW6, AD_PORTW7, AD_PORTW8
+    };
+    static const uint16_t Levels[] = {AD_LOW, AD_MID, AD_HIGH};
+    uint32_t Pick;
+
+    if (NextRandom() % 4) {
+        return;
+    }
+    Pick = NextRandom();
+    if ((Pick % 8) < 6) {
+        Sim_SetADPin(Pins[Pick % 8], Levels[(Pick >> 3) % 3]);
+    } else {
+        Sim_SetBumpers((Pick >> 3) & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+static int RunPass(const char *Name, SimTickHook_t Hook, uint32_t RunMs)
+{
+    SensorDeltaStats_t Stats;
+    ES_QueueStats_t Queue;
+    SensorDelta_t Left;
+    int Failed;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_coalesce: init failed\n");
+        return 1;
+    }
+    // the inputs sit either side of the fixed thresholds
+    RobotSensors_Calibrate(FALSE);
+    SetAnalogInputs(FALSE);
+    Sim_SetBumpers(0);
+    Sim_SetTickHook(Hook);
+    Sim_RunFor(RunMs);
+    Sim_SetTickHook((SimTickHook_t) 0);
+
+    SensorDelta_GetStats(&Stats);
+    ES_GetQueueStats(ROBOT_HSM_SERVICE, &Queue);
+    Failed = (Stats.Drops != 0) || (Queue.QueueOverflows != 0)
+            || (Queue.RingOverflows != 0) || (SensorDelta_Take(&Left) == TRUE);
+    printf("  %-8s %u edges in %u SensorDelta events (%.2f per event), dropped %u,"
+            " RobotHSM queue high-water %u/%u overflows %u, %.3f dispatches/ms%s\n",
+            Name, Stats.Edges, Stats.Posts,
+            Stats.Posts ? (double) Stats.Edges / Stats.Posts : 0.0, Stats.Drops,
+            Queue.QueueHighWater, SERV_2_QUEUE_SIZE, Queue.QueueOverflows,
+            (double) SimStats.Dispatches / RunMs, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunMs = DEFAULT_RUN_MS;
+    int Failed = 0;
+
+    if (argc > 1) {
+        RunMs = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+
+    printf("bench_coalesce: sensor edges to RobotHSM, %u ms virtual time per pass\n", RunMs);
+    Failed |= RunPass("aligned", AlignedHook, RunMs);
+    Failed |= RunPass("random", RandomHook, RunMs);
+    return Failed;
+}
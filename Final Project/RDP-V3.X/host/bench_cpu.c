@@ -0,0 +1,282 @@
+/*
+ * File: bench_cpu.c
+ *
+ * CPU cost of running the robot. The whole firmware loop (A/D scan and timer
+ * interrupts, ES dispatch, services and state machines) is run in virtual
+ * time and the process CPU time it takes is divided by the virtual seconds
+ * covered, next to the service dispatches (context switches) per second:
+ *
+ *   idle    inputs never change, so the cost is the sensor polling alone
+ *   random  inputs change at random every few ms, with the edges going on
+ *           to RobotHSM and the motors
+ *
+ * Each scenario is timed several times and the fastest run kept.
+ *
+ * Then a field (tape going by, the beacon coming and going, the track wire
+ * and the bumpers) is run twice and the CPU time, dispatches and sensor edges
+ * are split by the RobotHSM state they happened in: once with the sensor
+ * groups following the state (RobotSensors_Attend) and once with every group
+ * run at its old rate whatever the state. The two runs take different paths
+ * through the states, and the time column is the second's; the CPU times
+ * include the simulated hardware, which costs the same in both.
+ *
+ * usage: bench_cpu [virtual seconds per run]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "RobotHSM.h"
+#include "RobotSensors.h"
+#include "SensorDelta.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 300
+#define RUNS 5
+#define RANDOM_SEED 118
+#define MAX_STATES 8
+
+// the field
+#define FLOOR_READING 500 // tape sensors over the floor
+#define TAPE_LOW 150 // and over tape, where the right one reads high
+#define TAPE_HIGH 850
+#define TAPE_CHANGE 40 // chance in 10000 each ms
+#define BEACON_HEARD 150 // the beacon board's output, low while it hears it
+#define BEACON_QUIET 800
+#define BEACON_CHANGE 1
+#define TRACK_LOW 400
+#define TRACK_HIGH 950
+#define TRACK_CHANGE 10
+#define BUMP_CHANGE 20
+
+// the rates before RobotSensors_Attend: every group watched, bumpers every tick
+#define OLD_FAST (SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP | SENSOR_SIDE_BUMP)
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    uint64_t Ns;
+    uint32_t Ms;
+    uint32_t Dispatches;
+    uint32_t Edges;
+} StateLoad_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t RandomState;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void RandomInputs(uint32_t Now)
+{
+    static const unsigned int Pins[] = {
+        AD_PORTV6, AD_PORTV4, AD_PORTV3, AD_PORTW6, AD_PORTW7, AD_PORTW8
+    };
+    uint32_t Pick;
+
+    if (NextRandom() % 8) {
+        return;
+    }
+    Pick = NextRandom();
+    if ((Pick % 8) < 6) {
+        Sim_SetADPin(Pins[Pick % 8], NextRandom() % (AD_MAX_VALUE + 1));
+    } else {
+        Sim_SetBumpers((Pick >> 3) & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+static void FieldInputs(uint32_t Now)
+{
+    static const unsigned int TapePins[] = {AD_PORTV6, AD_PORTV4, AD_PORTV3};
+    static const uint16_t TapeReadings[] = {TAPE_LOW, TAPE_HIGH, TAPE_LOW};
+    static const unsigned int TrackPins[] = {AD_PORTW7, AD_PORTW8};
+    static uint16_t Track = TRACK_LOW;
+    uint8_t i;
+
+    if (Now == 1) {
+        Track = TRACK_LOW;
+        for (i = 0; i < 3; i++) {
+            Sim_SetADPin(TapePins[i], FLOOR_READING);
+        }
+        Sim_SetADPin(AD_PORTW6, BEACON_QUIET);
+        Sim_SetBumpers(0);
+    }
+    if ((NextRandom() % 10000) < TAPE_CHANGE) {
+        i = NextRandom() % 3;
+        Sim_SetADPin(TapePins[i], (NextRandom() & 1) ? TapeReadings[i] : FLOOR_READING);
+    }
+    if ((NextRandom() % 10000) < BEACON_CHANGE) {
+        Sim_SetADPin(AD_PORTW6, (NextRandom() & 1) ? BEACON_HEARD : BEACON_QUIET);
+    }
+    if ((NextRandom() % 10000) < TRACK_CHANGE) {
+        Track = (Track == TRACK_LOW) ? TRACK_HIGH : TRACK_LOW;
+    }
+    for (i = 0; i < 2; i++) {
+        Sim_SetADPin(TrackPins[i], Track);
+    }
+    if ((NextRandom() % 10000) < BUMP_CHANGE) {
+        Sim_SetBumpers(NextRandom() & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+/* one field run, its load added up by RobotHSM state */
+static void RunField(uint8_t Attend, uint32_t RunS, StateLoad_t *Loads)
+{
+    SensorDeltaStats_t Delta;
+    uint64_t Start, Now;
+    uint32_t Ms, Since = 0, Dispatches = 0, Edges = 0;
+    uint8_t State, NewState;
+
+    RandomState = RANDOM_SEED;
+    Sim_Init();
+    SensorDelta_GetStats(&Delta);
+    Edges = Delta.Edges;
+    Sim_SetTickHook(FieldInputs);
+    State = HSM_GetState(&RobotHSMMachine);
+    Start = CpuNs();
+    for (Ms = 1; Ms <= RunS * 1000; Ms++) {
+        Sim_Tick();
+        Sim_Drain();
+        if (!Attend) {
+            // undo whatever RobotHSM asked for in this ms
+            RobotSensors_Attend(SENSOR_ALL, OLD_FAST);
+        }
+        NewState = HSM_GetState(&RobotHSMMachine);
+        if ((NewState == State) && (Ms < RunS * 1000)) {
+            continue;
+        }
+        Now = CpuNs();
+        SensorDelta_GetStats(&Delta);
+        Loads[State].Ns += Now - Start;
+        Loads[State].Ms += Ms - Since;
+        Loads[State].Dispatches += SimStats.Dispatches - Dispatches;
+        Loads[State].Edges += Delta.Edges - Edges;
+        Start = Now;
+        Since = Ms;
+        Dispatches = SimStats.Dispatches;
+        Edges = Delta.Edges;
+        State = NewState;
+    }
+    Sim_SetTickHook((SimTickHook_t) 0);
+}
+
+static void RunStates(uint32_t RunS)
+{
+    StateLoad_t Loads[2][MAX_STATES], Run[MAX_STATES];
+    uint8_t Attend, i, s;
+
+    printf("  field, by RobotHSM state  %29s   %29s\n", "every group at its old rate",
+            "groups following the state");
+    printf("  %-8s %6s  %9s %9s %9s   %9s %9s %9s\n", "state", "time", "us CPU/s",
+            "disp/s", "edges/s", "us CPU/s", "disp/s", "edges/s");
+    for (Attend = 0; Attend < 2; Attend++) {
+        for (i = 0; i < RUNS; i++) {
+            memset(Run, 0, sizeof (Run));
+            RunField(Attend, RunS, Run);
+            for (s = 0; s < RobotHSMMachine.NumStates; s++) {
+                if ((i == 0) || (Run[s].Ns < Loads[Attend][s].Ns)) {
+                    Loads[Attend][s] = Run[s];
+                }
+            }
+        }
+    }
+    for (s = 0; s < RobotHSMMachine.NumStates; s++) {
+        printf("  %-8s %5.1f%%", RobotHSMMachine.States[s].Name,
+                100.0 * Loads[1][s].Ms / (RunS * 1000));
+        for (Attend = 0; Attend < 2; Attend++) {
+            const StateLoad_t *pLoad = &Loads[Attend][s];
+            double Seconds = pLoad->Ms / 1000.0;
+
+            if (pLoad->Ms == 0) {
+                printf("  %9s %9s %9s ", "-", "-", "-");
+                continue;
+            }
+            printf("  %9.1f %9.1f %9.2f ", pLoad->Ns / Seconds / 1000, pLoad->Dispatches / Seconds,
+                    pLoad->Edges / Seconds);
+        }
+        printf("\n");
+    }
+}
+
+static void RunScenario(const char *Name, SimTickHook_t Hook, uint32_t RunS)
+{
+    uint64_t Start, Best = UINT64_MAX;
+    uint32_t Dispatches = 0;
+    uint8_t i;
+
+    for (i = 0; i < RUNS; i++) {
+        RandomState = RANDOM_SEED;
+        Sim_Init();
+        Sim_SetTickHook(Hook);
+        Start = CpuNs();
+        Sim_RunFor(RunS * 1000);
+        Start = CpuNs() - Start;
+        Sim_SetTickHook((SimTickHook_t) 0);
+        if (Start < Best) {
+            Best = Start;
+        }
+        Dispatches = SimStats.Dispatches;
+    }
+    printf("  %-7s %2d services  %7.1f us CPU per second  %6.1f dispatches per second\n",
+            Name, NUM_SERVICES, (double) Best / RunS / 1000, (double) Dispatches / RunS);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunS = DEFAULT_RUN_S;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (RunS == 0) {
+        fprintf(stderr, "bench_cpu: bad run length\n");
+        return 1;
+    }
+
+    printf("bench_cpu: %u virtual s per run, best of %d\n", RunS, RUNS);
+    RunScenario("idle", (SimTickHook_t) 0, RunS);
+    RunScenario("random", RandomInputs, RunS);
+    RunStates(RunS);
+    return 0;
+}
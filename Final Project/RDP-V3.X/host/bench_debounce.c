@@ -0,0 +1,406 @@
+/*
+ * File: bench_debounce.c
+ *
+ * Test for the Debounce vertical counter against the ways the bumpers have
+ * been read before, all sampled on the 5 ms sensor tick:
+ *
+ *   reference  random inputs through the debouncer and through one plain
+ *              counter per bit, which must agree sample for sample
+ *   nested     RunRobotBumper: up to five port reads per tick in nested ifs,
+ *              one bumper per tick through the else-if chain, no debounce
+ *   one read   the same else-if chain on one read (RobotSensors until now)
+ *   vertical   one read through Debounce, all bumpers at once
+ *
+ * The bumpers are driven with presses of random length that bounce for a
+ * few ms on each transition, front hits that close both front bumpers
+ * together, and the odd 1 ms glitch. For each reader it counts the presses
+ * it never reported, the presses it reported that were bounce or glitches,
+ * the port reads and the time per tick.
+ *
+ * Fails if the debouncer disagrees with the reference, misses a press or
+ * reports an extra one.
+ *
+ * usage: bench_debounce [virtual seconds]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "Robot.h"
+#include "Debounce.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 3600
+#define REFERENCE_SAMPLES 1000000
+#define RANDOM_SEED 118
+
+#define TICK_MS 5
+#define NUM_BUMPERS 3
+#define BUMPER_MASK (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER)
+#define MIN_GAP_MS 200
+#define MAX_GAP_MS 3000
+#define MIN_PRESS_MS 40
+#define MAX_PRESS_MS 600
+#define MAX_BOUNCE_MS 10
+#define BOTH_FRONT_ODDS 3 // one front press in this many closes both
+#define MAX_SKEW_MS 10 // between the two front bumpers of a front hit
+#define GLITCH_ODDS 3000
+#define LATE_MS 40 // how long after a release a press may still be reported
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef uint8_t (*Reader_t)(void);
+
+/* one bumper's real state */
+typedef struct {
+    uint8_t Bit;
+    uint8_t Pressed;
+    uint32_t Start; // of the current press, or of the next one
+    uint32_t End; // of the current press, 0 once it has been scored
+    uint32_t BounceEnd;
+    uint32_t Presses;
+} Bumper_t;
+
+/* how one reader is doing */
+typedef struct {
+    const char *Name;
+    Reader_t Read;
+    uint8_t Levels;
+    uint8_t Seen[NUM_BUMPERS]; // current press has been reported
+    uint32_t Rises;
+    uint32_t Matched;
+    uint32_t Missed;
+    uint32_t PortReads;
+    uint64_t Ns;
+} Score_t;
+
+/*******************************************************************************
+ * PRIVATE FUNCTION PROTOTYPES                                                 *
+ ******************************************************************************/
+
+static uint8_t ReadNested(void);
+static uint8_t ReadOnce(void);
+static uint8_t ReadVertical(void);
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t RandomState;
+static Bumper_t Bumpers[NUM_BUMPERS] = {
+    {FRONT_RIGHT_BUMPER},
+    {FRONT_LEFT_BUMPER},
+    {SIDE_BUMPER},
+};
+static volatile uint8_t Port; // what a read of the bumper port returns
+static uint32_t PortReads;
+static Debouncer_t Vertical;
+static volatile uint8_t Sink; // keeps the timed reads from being optimized out
+
+static Score_t Scores[] = {
+    {"nested", ReadNested},
+    {"one read", ReadOnce},
+    {"vertical", ReadVertical},
+};
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint32_t Between(uint32_t Low, uint32_t High)
+{
+    return Low + NextRandom() % (High - Low + 1);
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint8_t ReadPort(void)
+{
+    PortReads++;
+    return Port;
+}
+
+/*
+ * One plain counter per bit, DEBOUNCE_SAMPLES disagreeing samples in a row to
+ * switch, checked against the vertical counter.
+ */
+static int RunReference(void)
+{
+    Debouncer_t Debouncer;
+    DebounceEdges_t Edges;
+    uint8_t Count[8] = {0}, State = 0, Changed, Sample, i;
+    uint32_t n, Mismatches = 0, Toggles = 0;
+
+    RandomState = RANDOM_SEED;
+    Debounce_Init(&Debouncer, 0);
+    Sample = 0;
+    for (n = 0; n < REFERENCE_SAMPLES; n++) {
+        // flip a bit now and then so runs of every length come up
+        Sample ^= (1 << (NextRandom() % 8)) & ((NextRandom() % 3) ? 0 : 0xFF);
+        Changed = 0;
+        for (i = 0; i < 8; i++) {
+            if (((Sample ^ State) >> i) & 1) {
+                if (++Count[i] == DEBOUNCE_SAMPLES) {
+                    Changed |= 1 << i;
+                    Count[i] = 0;
+                }
+            } else {
+                Count[i] = 0;
+            }
+        }
+        State ^= Changed;
+        Edges = Debounce_Update(&Debouncer, Sample);
+        Toggles += __builtin_popcount(Changed);
+        if ((Edges.Pressed != (Changed & State)) || (Edges.Released != (Changed & ~State))
+                || (Debounce_State(&Debouncer) != State)) {
+            Mismatches++;
+        }
+    }
+    printf("  reference %u samples, %u toggles, %u mismatches%s\n",
+            REFERENCE_SAMPLES, Toggles, Mismatches, Mismatches ? "  FAILED" : "");
+    return Mismatches != 0;
+}
+
+/* RunRobotBumper's nested reads, the reads of one tick all seeing one sample */
+static uint8_t ReadNested(void)
+{
+    if (ReadPort() & FRONT_RIGHT_BUMPER) {
+        if (ReadPort() & FRONT_RIGHT_BUMPER) {
+            if (ReadPort() & FRONT_RIGHT_BUMPER) {
+                return FRONT_RIGHT_BUMPER;
+            }
+        }
+    } else if (ReadPort() & FRONT_LEFT_BUMPER) {
+        if (ReadPort() & FRONT_LEFT_BUMPER) {
+            if (ReadPort() & FRONT_LEFT_BUMPER) {
+                return FRONT_LEFT_BUMPER;
+            }
+        }
+    } else if (ReadPort() & SIDE_BUMPER) {
+        if (ReadPort() & SIDE_BUMPER) {
+            if (ReadPort() & SIDE_BUMPER) {
+                if (ReadPort() & SIDE_BUMPER) {
+                    if (ReadPort() & SIDE_BUMPER) {
+                        return SIDE_BUMPER;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static uint8_t ReadOnce(void)
+{
+    uint8_t Sample = ReadPort();
+
+    if (Sample & FRONT_RIGHT_BUMPER) {
+        return FRONT_RIGHT_BUMPER;
+    } else if (Sample & FRONT_LEFT_BUMPER) {
+        return FRONT_LEFT_BUMPER;
+    } else if (Sample & SIDE_BUMPER) {
+        return SIDE_BUMPER;
+    }
+    return 0;
+}
+
+static uint8_t ReadVertical(void)
+{
+    Debounce_Update(&Vertical, ReadPort());
+    return Debounce_State(&Vertical);
+}
+
+/* start a press of pBumper at Now, and of the other front bumper with it sometimes */
+static void StartPress(Bumper_t *pBumper, uint32_t Now)
+{
+    Bumper_t *pOther;
+
+    pBumper->Start = Now;
+    pBumper->End = Now + Between(MIN_PRESS_MS, MAX_PRESS_MS);
+    if ((pBumper->Bit != SIDE_BUMPER) && ((NextRandom() % BOTH_FRONT_ODDS) == 0)) {
+        pOther = &Bumpers[(pBumper == &Bumpers[0]) ? 1 : 0];
+        if (!pOther->Pressed && (pOther->End == 0) && (pOther->Start > Now + MAX_SKEW_MS)) {
+            pOther->Start = Now + Between(0, MAX_SKEW_MS);
+        }
+    }
+}
+
+/* the bumper port at Now */
+static uint8_t StepBumpers(uint32_t Now)
+{
+    Bumper_t *pBumper;
+    uint8_t Sample = 0, Level, i;
+
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        pBumper = &Bumpers[i];
+        if (!pBumper->Pressed && (Now >= pBumper->Start)) {
+            StartPress(pBumper, Now);
+            pBumper->Pressed = TRUE;
+            pBumper->Presses++;
+            pBumper->BounceEnd = Now + Between(0, MAX_BOUNCE_MS);
+        } else if (pBumper->Pressed && (Now >= pBumper->End)) {
+            pBumper->Pressed = FALSE;
+            pBumper->Start = Now + Between(MIN_GAP_MS, MAX_GAP_MS);
+            pBumper->BounceEnd = Now + Between(0, MAX_BOUNCE_MS);
+        }
+        Level = pBumper->Pressed;
+        if ((Now < pBumper->BounceEnd) || ((NextRandom() % GLITCH_ODDS) == 0)) {
+            Level = (Now < pBumper->BounceEnd) ? (NextRandom() & 1) : !Level;
+        }
+        Sample |= Level ? pBumper->Bit : 0;
+    }
+    return Sample;
+}
+
+/* score a reader's levels for this tick against the real presses */
+static void ScoreTick(Score_t *pScore, uint8_t Levels, uint32_t Now)
+{
+    Bumper_t *pBumper;
+    uint8_t Rose = Levels & ~pScore->Levels & BUMPER_MASK, i;
+
+    pScore->Rises += __builtin_popcount(Rose);
+    pScore->Levels = Levels;
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        pBumper = &Bumpers[i];
+        if ((Rose & pBumper->Bit) && !pScore->Seen[i] && (pBumper->End != 0)) {
+            pScore->Seen[i] = TRUE;
+            pScore->Matched++;
+        }
+    }
+}
+
+/* close the presses that can no longer be reported */
+static void FinishPresses(uint32_t Now)
+{
+    Bumper_t *pBumper;
+    uint8_t i, j;
+
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        pBumper = &Bumpers[i];
+        if (pBumper->Pressed || (pBumper->End == 0) || (Now < pBumper->End + LATE_MS)) {
+            continue;
+        }
+        for (j = 0; j < sizeof (Scores) / sizeof (Scores[0]); j++) {
+            if (!Scores[j].Seen[i]) {
+                Scores[j].Missed++;
+            }
+            Scores[j].Seen[i] = FALSE;
+        }
+        pBumper->End = 0;
+    }
+}
+
+static int RunBumpers(uint32_t RunS)
+{
+    Score_t *pScore;
+    uint32_t Now, Ticks = RunS * 1000 / TICK_MS, Presses = 0;
+    uint64_t Start;
+    uint8_t *Samples, Levels[sizeof (Scores) / sizeof (Scores[0])], i;
+    uint8_t Failed = FALSE;
+
+    Samples = malloc(Ticks);
+    if (Samples == NULL) {
+        fprintf(stderr, "bench_debounce: out of memory\n");
+        return 1;
+    }
+    RandomState = RANDOM_SEED;
+    Debounce_Init(&Vertical, 0);
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        Bumpers[i].Start = Between(0, MAX_GAP_MS);
+    }
+    for (Now = 1; Now <= RunS * 1000; Now++) {
+        Port = StepBumpers(Now);
+        if ((Now % TICK_MS) != 0) {
+            continue;
+        }
+        Samples[Now / TICK_MS - 1] = Port;
+        PortReads = 0;
+        for (i = 0; i < sizeof (Scores) / sizeof (Scores[0]); i++) {
+            Levels[i] = Scores[i].Read();
+            Scores[i].PortReads += PortReads;
+            PortReads = 0;
+        }
+        for (i = 0; i < sizeof (Scores) / sizeof (Scores[0]); i++) {
+            ScoreTick(&Scores[i], Levels[i], Now);
+        }
+        FinishPresses(Now);
+    }
+    for (i = 0; i < NUM_BUMPERS; i++) {
+        Presses += Bumpers[i].Presses;
+    }
+
+    // the same ticks again with nothing but the reads, to time them
+    for (i = 0; i < sizeof (Scores) / sizeof (Scores[0]); i++) {
+        pScore = &Scores[i];
+        Debounce_Init(&Vertical, 0);
+        Start = CpuNs();
+        for (Now = 0; Now < Ticks; Now++) {
+            Port = Samples[Now];
+            Sink ^= pScore->Read();
+        }
+        pScore->Ns = CpuNs() - Start;
+    }
+    free(Samples);
+
+    printf("  %u s of bumping, %u presses\n", RunS, Presses);
+    for (i = 0; i < sizeof (Scores) / sizeof (Scores[0]); i++) {
+        pScore = &Scores[i];
+        printf("  %-9s %5u missed presses  %5u extra presses  %.2f reads per tick  %5.1f ns per tick\n",
+                pScore->Name, pScore->Missed, pScore->Rises - pScore->Matched,
+                (double) pScore->PortReads / Ticks,
+                (double) pScore->Ns / Ticks);
+    }
+    pScore = &Scores[2];
+    Failed = (pScore->Missed != 0) || (pScore->Rises != pScore->Matched);
+    if (Failed) {
+        printf("  vertical  FAILED\n");
+    }
+    return Failed;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunS = DEFAULT_RUN_S;
+    int Failed = 0;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (RunS == 0) {
+        fprintf(stderr, "bench_debounce: bad run length\n");
+        return 1;
+    }
+
+    printf("bench_debounce: %d ms tick, %d samples to switch\n", TICK_MS, DEBOUNCE_SAMPLES);
+    Failed |= RunReference();
+    Failed |= RunBumpers(RunS);
+    return Failed;
+}
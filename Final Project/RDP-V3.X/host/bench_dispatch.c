@@ -0,0 +1,199 @@
+/*
+ * File: bench_dispatch.c
+ *
+ * Dispatch-cost benchmark for the host build. Posts a fixed pseudo-random
+ * mix of sensor and timeout events to RobotHSM through ES_PostToService and
+ * times every run-to-completion step the ES loop takes to consume them.
+ *
+ * Every change of the motor outputs between steps is folded into a hash, so
+ * two builds of the state machines (see "make compare") can be checked for
+ * driving the robot identically on the same event stream.
+ *
+ * A second pass calls RunRobotHSM() directly with the same event stream,
+ * draining whatever it posts to itself outside the timed region, to give
+ * the state machine's own per-event cost without the ES queue around it.
+ *
+ * usage: bench_dispatch [number of posts]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "RobotHSM.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_POSTS 200000
+#define STEPS_PER_POST 4 // room for the events the HSMs post to themselves
+#define RANDOM_SEED 118
+#define CLOCK_CAL_LOOPS 100000
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+/* every event RobotHSM and its sub-machines react to, timeouts included */
+static const ES_Event EventMix[] = {
+    {Beacon_found, 0}, {No_Beacon_found, 0},
+    {Wall_found, 0}, {No_Wall_found, 0},
+    {FrontRightBump, 0}, {NoFrontRightBump, 0},
+    {FrontLeftBump, 0}, {NoFrontLeftBump, 0},
+    {SideBump, 0}, {NoSideBump, 0},
+    {FrontRightTape, 0}, {NoFrontRightTape, 0},
+    {FrontLeftTape, 0}, {NoFrontLeftTape, 0},
+    {CannonTape, 0}, {NoCannonTape, 0},
+    {ES_TIMEOUT, HSM_TIMER}, {ES_TIMEOUT, SEARCH_TIMER},
+    {ES_TIMEOUT, PURSUE_TIMER}, {ES_TIMEOUT, DESTROY_TIMER},
+    {ES_TIMEOUT, ESCAPE_TIMER},
+};
+
+static uint32_t Seed = RANDOM_SEED;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    Seed = Seed * 1664525u + 1013904223u;
+    return Seed >> 8;
+}
+
+static ES_Event NextEvent(void)
+{
+    return EventMix[NextRandom() % (sizeof (EventMix) / sizeof (EventMix[0]))];
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint32_t HashMotors(uint32_t Hash)
+{
+    static uint32_t LastOutputs = 0xFFFFFFFF;
+    uint32_t Outputs = ((uint32_t) (uint8_t) Sim_GetLeftMtr() << 16)
+            | ((uint32_t) (uint8_t) Sim_GetRightMtr() << 8)
+            | (uint8_t) Sim_GetCannonMtr();
+
+    // steps that leave the motors alone don't count
+    if (Outputs != LastOutputs) {
+        LastOutputs = Outputs;
+        Hash = (Hash ^ Outputs) * FNV_PRIME;
+    }
+    return Hash;
+}
+
+/* cost of the NowNs() pair around each sample, taken off the direct pass */
+static uint32_t ClockOverheadNs(void)
+{
+    uint64_t Start = NowNs();
+    uint32_t i;
+
+    for (i = 0; i < CLOCK_CAL_LOOPS; i++) {
+        (void) NowNs();
+    }
+    return (uint32_t) ((NowNs() - Start) / CLOCK_CAL_LOOPS);
+}
+
+static int CompareU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t NumPosts = DEFAULT_POSTS;
+    uint32_t MaxSteps, NumSteps = 0, Dropped = 0, i;
+    uint32_t *Samples;
+    uint32_t MotorHash = FNV_OFFSET;
+    uint64_t Start, Elapsed, t0, t1, DirectTotal = 0;
+    uint32_t Overhead;
+    ES_Event ThisEvent;
+
+    if (argc > 1) {
+        NumPosts = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    MaxSteps = NumPosts * STEPS_PER_POST;
+    Samples = malloc(MaxSteps * sizeof (uint32_t));
+    if ((Samples == NULL) || (Sim_Init() != SUCCESS)) {
+        fprintf(stderr, "bench_dispatch: init failed\n");
+        return 1;
+    }
+
+    Start = NowNs();
+    for (i = 0; i < NumPosts; i++) {
+        if (PostRobotHSM(NextEvent()) != TRUE) {
+            Dropped++;
+        }
+        while (NumSteps < MaxSteps) {
+            t0 = NowNs();
+            if (ES_RunStep() != TRUE) {
+                break;
+            }
+            t1 = NowNs();
+            Samples[NumSteps++] = (uint32_t) (t1 - t0);
+            MotorHash = HashMotors(MotorHash);
+        }
+    }
+    Elapsed = NowNs() - Start;
+
+    qsort(Samples, NumSteps, sizeof (uint32_t), CompareU32);
+    printf("bench_dispatch: %u posts, %u run-to-completion steps in %.4f s\n",
+            NumPosts, NumSteps, Elapsed / 1e9);
+    printf("  throughput    %.3f Mevents/s\n", NumSteps / (Elapsed / 1e3));
+    printf("  step p50      %u ns\n", Samples[NumSteps / 2]);
+    printf("  step p99      %u ns\n", Samples[(uint32_t) (NumSteps * 0.99)]);
+    printf("  step max      %u ns\n", Samples[NumSteps - 1]);
+    printf("  dropped posts %u\n", Dropped);
+    printf("  motor writes  %u\n", SimStats.MotorWrites);
+    printf("  motor hash    %08x\n", MotorHash);
+
+    // direct pass, same stream from a fresh start
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_dispatch: init failed\n");
+        return 1;
+    }
+    Seed = RANDOM_SEED;
+    Overhead = ClockOverheadNs();
+    for (i = 0; i < NumPosts; i++) {
+        ThisEvent = NextEvent();
+        t0 = NowNs();
+        RunRobotHSM(ThisEvent);
+        t1 = NowNs();
+        Samples[i] = (t1 - t0 > Overhead) ? (uint32_t) (t1 - t0 - Overhead) : 0;
+        DirectTotal += Samples[i];
+        Sim_Drain();
+    }
+    qsort(Samples, NumPosts, sizeof (uint32_t), CompareU32);
+    printf("  RunRobotHSM   p50 %u ns  p99 %u ns  mean %.1f ns"
+            " (clock overhead %u ns removed)\n",
+            Samples[NumPosts / 2], Samples[(uint32_t) (NumPosts * 0.99)],
+            (double) DirectTotal / NumPosts, Overhead);
+
+    free(Samples);
+    return 0;
+}
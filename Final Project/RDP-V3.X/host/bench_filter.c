@@ -0,0 +1,284 @@
+/*
+ * File: bench_filter.c
+ *
+ * Test for the ADFilter integer filters. Each filter configuration is fed
+ * full-scale-ish sine waves at a sweep of frequencies alongside a
+ * double-precision model of the same filter, with the same Q15
+ * coefficients:
+ *
+ *   error  largest difference between the two outputs on any sample, which
+ *          should be the output rounding and no more
+ *   gain   the filter's gain at each frequency, measured from its output,
+ *          against the exact response of the model
+ *
+ * and the cost of a sample is reported two ways: host time, and PIC32 cycles
+ * on the cost model below.
+ *
+ * Cost model (PIC32MX M4K at 80 MHz, single issue, code in prefetch cache):
+ * 1 cycle per ALU op, load, store and MULT/MADD issue, 1 more to read
+ * HI/LO, 2 per taken branch or jump counting its delay slot. The op counts
+ * per type were taken from ADFilter_Step() by hand and include the call from
+ * ADAcquire_ScanComplete(); wait states and interrupt entry are left out.
+ *
+ * Fails if any output is more than one count from the model or any gain is
+ * off by more than GAIN_TOLERANCE.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADFilter.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define SETTLE 2048 // samples before the gain is measured
+#define MEASURE 8192
+#define MID 512
+#define AMPLITUDE 400
+#define GAIN_TOLERANCE 0.005
+#define TIMED_SAMPLES 4000000
+#define CPU_MHZ 80
+#define NUM_FREQUENCIES (sizeof (Frequencies) / sizeof (Frequencies[0]))
+#define NUM_CONFIGS (sizeof (Configs) / sizeof (Configs[0]))
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    uint8_t Type;
+    int16_t Alpha;
+    uint8_t Length;
+    const int16_t *Taps;
+} Config_t;
+
+/* double-precision model of one filter */
+typedef struct {
+    const Config_t *pConfig;
+    double State;
+    double History[AD_FILTER_MAX_TAPS];
+    uint8_t Index;
+} Model_t;
+
+/* cycles on the cost model: Fixed + PerTap * Length */
+typedef struct {
+    uint8_t Fixed;
+    uint8_t PerTap;
+} Cost_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// Hamming-windowed sinc low passes, cut off at 0.1 and 0.05 of the scan rate
+static const int16_t Taps7[] = {442, 2571, 7893, 10956, 7893, 2571, 442};
+static const int16_t Taps15[] = {
+    144, 310, 789, 1620, 2698, 3784, 4593, 4892, 4593, 3784, 2698, 1620, 789, 310, 144
+};
+
+static const Config_t Configs[] = {
+    {"IIR 1/4", AD_FILTER_IIR, Q15(0.25), 1, NULL},
+    {"IIR 1/16", AD_FILTER_IIR, Q15(0.0625), 1, NULL},
+    {"average 4", AD_FILTER_AVERAGE, 0, 4, NULL},
+    {"average 8", AD_FILTER_AVERAGE, 0, 8, NULL},
+    {"FIR 7", AD_FILTER_FIR, 0, 7, Taps7},
+    {"FIR 15", AD_FILTER_FIR, 0, 15, Taps15},
+};
+
+// cycles per sample by ADFilterType_t
+static const Cost_t Costs[] = {
+    {9, 0}, // none: the FilteredPins test and the copy
+    {26, 0}, // IIR: 5 loads, 1 store, 11 ALU, MULT + MFHI/MFLO, 3 branches
+    {30, 0}, // average: 7 loads, 4 stores, 13 ALU, 3 branches
+    {28, 7}, // FIR: 6 loads, 2 stores, 12 ALU, 4 branches; per tap 2 loads, 2 ALU, MADD, the branch
+};
+
+// cycles per sample of the scan rate
+static const double Frequencies[] = {0.001, 0.01, 0.02, 0.05, 0.1, 0.2, 0.3, 0.45};
+
+static volatile uint16_t Sink; // keeps the timed filter from being optimized out
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int8_t InitFilter(ADFilter_t *pFilter, const Config_t *pConfig)
+{
+    switch (pConfig->Type) {
+    case AD_FILTER_IIR:
+        return ADFilter_InitIIR(pFilter, pConfig->Alpha);
+    case AD_FILTER_AVERAGE:
+        return ADFilter_InitAverage(pFilter, pConfig->Length);
+    case AD_FILTER_FIR:
+        return ADFilter_InitFIR(pFilter, pConfig->Taps, pConfig->Length);
+    default:
+        ADFilter_InitNone(pFilter);
+        return SUCCESS;
+    }
+}
+
+static void InitModel(Model_t *pModel, const Config_t *pConfig, double First)
+{
+    uint8_t i;
+
+    pModel->pConfig = pConfig;
+    pModel->State = First;
+    for (i = 0; i < AD_FILTER_MAX_TAPS; i++) {
+        pModel->History[i] = First;
+    }
+    pModel->Index = 0;
+}
+
+static double StepModel(Model_t *pModel, double Sample)
+{
+    const Config_t *pConfig = pModel->pConfig;
+    double Sum = 0;
+    uint8_t i;
+
+    pModel->History[pModel->Index] = Sample;
+    for (i = 0; i < pConfig->Length; i++) {
+        Sum += pModel->History[(pModel->Index - i) & (AD_FILTER_MAX_TAPS - 1)]
+                * ((pConfig->Type == AD_FILTER_FIR) ? pConfig->Taps[i] / 32768.0
+                : 1.0 / pConfig->Length);
+    }
+    pModel->Index = (pModel->Index + 1) & (AD_FILTER_MAX_TAPS - 1);
+    if (pConfig->Type == AD_FILTER_IIR) {
+        pModel->State += (Sample - pModel->State) * (pConfig->Alpha / 32768.0);
+        return pModel->State;
+    }
+    return Sum;
+}
+
+/* exact gain of the model at Frequency (cycles per sample) */
+static double ModelGain(const Config_t *pConfig, double Frequency)
+{
+    double w = 2 * M_PI * Frequency, a = pConfig->Alpha / 32768.0, Re = 0, Im = 0, h;
+    uint8_t i;
+
+    if (pConfig->Type == AD_FILTER_IIR) {
+        // a / (1 - (1 - a) e^-jw)
+        Re = 1 - (1 - a) * cos(w);
+        Im = (1 - a) * sin(w);
+        return a / sqrt(Re * Re + Im * Im);
+    }
+    for (i = 0; i < pConfig->Length; i++) {
+        h = (pConfig->Type == AD_FILTER_FIR) ? pConfig->Taps[i] / 32768.0 : 1.0 / pConfig->Length;
+        Re += h * cos(w * i);
+        Im -= h * sin(w * i);
+    }
+    return sqrt(Re * Re + Im * Im);
+}
+
+/* one configuration through the sweep; returns TRUE if it failed */
+static uint8_t RunConfig(const Config_t *pConfig)
+{
+    ADFilter_t Filter;
+    Model_t Model;
+    double Sin, Cos, Mean, Gain, Expected, WorstGain = 0, WorstError = 0, Error, Phase;
+    double Frequency;
+    uint16_t Sample, Out;
+    uint32_t n;
+    uint8_t f;
+
+    printf("  %-10s", pConfig->Name);
+    for (f = 0; f < NUM_FREQUENCIES; f++) {
+        InitFilter(&Filter, pConfig);
+        InitModel(&Model, pConfig, MID);
+        Sin = 0;
+        Cos = 0;
+        Mean = 0;
+        // a whole number of cycles in the measuring window
+        Frequency = round(Frequencies[f] * MEASURE) / MEASURE;
+        for (n = 0; n < SETTLE + MEASURE; n++) {
+            Phase = 2 * M_PI * Frequency * n;
+            Sample = (uint16_t) lround(MID + AMPLITUDE * sin(Phase));
+            Out = ADFilter_Step(&Filter, Sample);
+            Error = fabs(Out - StepModel(&Model, Sample));
+            if (Error > WorstError) {
+                WorstError = Error;
+            }
+            if (n >= SETTLE) {
+                Sin += Out * sin(Phase);
+                Cos += Out * cos(Phase);
+                Mean += Out;
+            }
+        }
+        // take out the leakage of the DC level into the two sums
+        Mean /= MEASURE;
+        for (n = SETTLE; n < SETTLE + MEASURE; n++) {
+            Phase = 2 * M_PI * Frequency * n;
+            Sin -= Mean * sin(Phase);
+            Cos -= Mean * cos(Phase);
+        }
+        Gain = 2 * sqrt(Sin * Sin + Cos * Cos) / MEASURE / AMPLITUDE;
+        Expected = ModelGain(pConfig, Frequency);
+        if (fabs(Gain - Expected) > WorstGain) {
+            WorstGain = fabs(Gain - Expected);
+        }
+        printf(" %6.1f", 20 * log10(Gain));
+    }
+    printf("  %5.3f %4.2f%s\n", WorstGain, WorstError,
+            ((WorstGain > GAIN_TOLERANCE) || (WorstError > 1.0)) ? "  FAILED" : "");
+    return (WorstGain > GAIN_TOLERANCE) || (WorstError > 1.0);
+}
+
+static void RunCost(const Config_t *pConfig)
+{
+    ADFilter_t Filter;
+    const Cost_t *pCost = &Costs[pConfig->Type];
+    uint64_t Start;
+    uint32_t n, Cycles;
+
+    InitFilter(&Filter, pConfig);
+    Start = CpuNs();
+    for (n = 0; n < TIMED_SAMPLES; n++) {
+        Sink = ADFilter_Step(&Filter, (uint16_t) (MID + (n & 0xFF)));
+    }
+    Start = CpuNs() - Start;
+    Cycles = pCost->Fixed + pCost->PerTap * ((pConfig->Type == AD_FILTER_FIR) ? pConfig->Length : 0);
+    printf("  %-10s %5.1f ns per sample on the host  %4u cycles (%5.2f us) on the PIC32\n",
+            pConfig->Name, (double) Start / TIMED_SAMPLES, Cycles, (double) Cycles / CPU_MHZ);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(void)
+{
+    uint8_t i, f, Failed = FALSE;
+
+    printf("bench_filter: gain in dB at each frequency (cycles per sample), worst gain\n"
+            "  and output error against the double-precision model\n  %-10s", "");
+    for (f = 0; f < NUM_FREQUENCIES; f++) {
+        printf(" %6.3f", Frequencies[f]);
+    }
+    printf("  gain  error\n");
+    for (i = 0; i < NUM_CONFIGS; i++) {
+        Failed |= RunConfig(&Configs[i]);
+    }
+    for (i = 0; i < NUM_CONFIGS; i++) {
+        RunCost(&Configs[i]);
+    }
+    return Failed;
+}
@@ -0,0 +1,330 @@
+/*
+ * File: bench_goertzel.c
+ *
+ * Test bench for the Goertzel beacon detector, set up as RobotSensors sets it
+ * up (250 Hz tone, 1 kHz samples, 40-sample blocks), fed synthetic signals:
+ *
+ *   magnitude  clean tones on and off the tone bin, to check the magnitude
+ *              the detector reports against the amplitude put in
+ *   detect     blocks of tone plus noise at a sweep of tone amplitudes, over
+ *              a DC level that wanders across the whole range as a detector
+ *              front end drifting with range and ambient light would, and
+ *              the odd impulse; for each amplitude the fraction of blocks
+ *              that pass and of the time the beacon is found, next to the
+ *              old single-sample "below 300 every 20 ms" threshold on the
+ *              same signal
+ *   on/off     the tone switched on and off at random, counting the times
+ *              it was missed or found while off, and the found and lost
+ *              latencies
+ *
+ * Cost is reported as operations per block: the per-sample filter loop and
+ * the end-of-block magnitudes and decision, counted off Goertzel_Step() by
+ * hand (a MULT and its MFLO/MFHI counted as one operation each), and as host
+ * time per block.
+ *
+ * Fails if a magnitude is off by more than MAGNITUDE_TOLERANCE, if a tone of
+ * RELIABLE_AMPLITUDE or more is found less than RELIABLE_FOUND of the time,
+ * if no tone is ever found, or if the on/off pass misses a tone or finds one
+ * that is not there.
+ *
+ * usage: bench_goertzel [blocks per amplitude]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Goertzel.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define TONE_HZ 250
+#define SAMPLE_HZ 1000
+#define BLOCK 40
+#define MIN_MAGNITUDE 20
+
+#define DEFAULT_BLOCKS 5000
+#define RANDOM_SEED 118
+#define NOISE 25 // each of four uniform terms, about 29 counts rms in all
+#define IMPULSE_ODDS 200
+#define IMPULSE 400
+#define OLD_THRESHOLD 300
+#define OLD_PERIOD_MS 20
+
+#define MAGNITUDE_TOLERANCE 0.03
+#define RELIABLE_AMPLITUDE 40
+#define RELIABLE_FOUND 0.99
+
+#define ONOFF_MS 600000
+#define ONOFF_AMPLITUDE 60
+#define MIN_SEGMENT_MS 400
+#define MAX_SEGMENT_MS 3000
+
+#define TIMED_BLOCKS 200000
+
+// operations, counted off Goertzel_Step()
+#define OPS_PER_SAMPLE (4 + GOERTZEL_BINS * 9) // offset, count; per bin MULT, MFLO, MFHI, shifts, add, sub, 2 moves
+#define OPS_SQRT 230 // 32 passes of compare, subtract, shift, branch
+#define OPS_PER_BIN (12 + OPS_SQRT + 4) // 3 MULTs and reads, 3 adds, shift; root; scale, divide, clear
+#define OPS_DECISION 14
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const uint16_t Amplitudes[] = {0, 10, 20, 30, 40, 60, 100};
+
+static uint32_t RandomState;
+static double Offset; // the wandering DC level
+static uint32_t Time; // samples so far
+static volatile uint16_t Sink; // keeps the timed blocks from being optimized out
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static int32_t Between(int32_t Low, int32_t High)
+{
+    return Low + (int32_t) (NextRandom() % (uint32_t) (High - Low + 1));
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* the next sample of the beacon channel */
+static uint16_t NextSample(uint16_t Amplitude)
+{
+    double Sample;
+
+    // a slow random walk over most of the range
+    Offset += (NextRandom() % 2) ? 0.5 : -0.5;
+    if (Offset < 150) {
+        Offset = 150;
+    } else if (Offset > 870) {
+        Offset = 870;
+    }
+    Sample = Offset + Amplitude * sin(2 * M_PI * TONE_HZ * Time / SAMPLE_HZ)
+            + Between(-NOISE, NOISE) + Between(-NOISE, NOISE)
+            + Between(-NOISE, NOISE) + Between(-NOISE, NOISE);
+    if ((NextRandom() % IMPULSE_ODDS) == 0) {
+        Sample += (NextRandom() & 1) ? IMPULSE : -IMPULSE;
+    }
+    Time++;
+    return (Sample < 0) ? 0 : (Sample > AD_MAX_VALUE) ? AD_MAX_VALUE : lround(Sample);
+}
+
+static int RunMagnitude(void)
+{
+    static const double Tones[] = {TONE_HZ, TONE_HZ - 75, TONE_HZ + 75, TONE_HZ + 12.5};
+    static const uint16_t Levels[] = {25, 100, 400};
+    Goertzel_t Detector;
+    double Expected, Error, Worst = 0;
+    uint32_t n;
+    uint16_t Magnitude, Sample;
+    uint8_t t, a, Failed = FALSE;
+
+    printf("  magnitude");
+    for (t = 0; t < sizeof (Tones) / sizeof (Tones[0]); t++) {
+        for (a = 0; a < sizeof (Levels) / sizeof (Levels[0]); a++) {
+            Goertzel_Init(&Detector, TONE_HZ, SAMPLE_HZ, BLOCK, MIN_MAGNITUDE);
+            for (n = 0; n < BLOCK; n++) {
+                Sample = lround(512 + Levels[a] * sin(2 * M_PI * Tones[t] * n / SAMPLE_HZ + 0.3));
+                Goertzel_Step(&Detector, Sample);
+            }
+            Magnitude = Goertzel_Magnitude(&Detector);
+            // on the bin it reads the amplitude, on the guard bins nothing,
+            // and half a bin off the sinc of the block
+            if (Tones[t] == TONE_HZ) {
+                Expected = Levels[a];
+            } else if (fabs(Tones[t] - TONE_HZ) > 50) {
+                Expected = 0;
+            } else {
+                Expected = Levels[a] * fabs(sin(M_PI * 0.5) / (BLOCK * sin(M_PI * 0.5 / BLOCK)));
+            }
+            Error = fabs(Magnitude - Expected) / Levels[a];
+            if (Error > Worst) {
+                Worst = Error;
+            }
+            printf(" %3.0f Hz/%u:%u", Tones[t], Levels[a], Magnitude);
+        }
+    }
+    Failed = Worst > MAGNITUDE_TOLERANCE;
+    printf("\n  worst magnitude error %.3f of the amplitude%s\n", Worst, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+static int RunDetect(uint32_t Blocks)
+{
+    Goertzel_t Detector;
+    uint32_t b, n, Passes, FoundBlocks, OldFound, OldLooks;
+    uint16_t Sample;
+    uint8_t a, Failed = FALSE, Below;
+
+    printf("  detect    noise %.0f rms, DC wandering 150-870, impulses of %d in 1 sample in %d\n",
+            NOISE * 2 / sqrt(3.0), IMPULSE, IMPULSE_ODDS);
+    printf("            amplitude  blocks passing  found  old threshold found\n");
+    for (a = 0; a < sizeof (Amplitudes) / sizeof (Amplitudes[0]); a++) {
+        RandomState = RANDOM_SEED + a;
+        Offset = 512;
+        Time = 0;
+        Goertzel_Init(&Detector, TONE_HZ, SAMPLE_HZ, BLOCK, MIN_MAGNITUDE);
+        Passes = 0;
+        FoundBlocks = 0;
+        OldFound = 0;
+        OldLooks = 0;
+        for (b = 0; b < Blocks; b++) {
+            for (n = 0; n < BLOCK; n++) {
+                Sample = NextSample(Amplitudes[a]);
+                if ((Time % OLD_PERIOD_MS) == 0) {
+                    Below = Sample < OLD_THRESHOLD;
+                    OldFound += Below;
+                    OldLooks++;
+                }
+                Goertzel_Step(&Detector, Sample);
+            }
+            Passes += (Detector.Magnitude[0] >= MIN_MAGNITUDE)
+                    && (Detector.Magnitude[0] >= GOERTZEL_RATIO * Detector.Magnitude[1])
+                    && (Detector.Magnitude[0] >= GOERTZEL_RATIO * Detector.Magnitude[2]);
+            FoundBlocks += Goertzel_Found(&Detector);
+        }
+        printf("            %9u  %13.1f%%  %4.1f%%  %18.1f%%",
+                Amplitudes[a], 100.0 * Passes / Blocks, 100.0 * FoundBlocks / Blocks,
+                100.0 * OldFound / OldLooks);
+        if (((Amplitudes[a] >= RELIABLE_AMPLITUDE) && (FoundBlocks < RELIABLE_FOUND * Blocks))
+                || ((Amplitudes[a] == 0) && (FoundBlocks != 0))) {
+            printf("  FAILED");
+            Failed = TRUE;
+        }
+        printf("\n");
+    }
+    return Failed;
+}
+
+static int RunOnOff(void)
+{
+    Goertzel_t Detector;
+    uint32_t SegmentEnd = 0, OnStart = 0, Grace = 0, Segments = 0, Missed = 0, False = 0;
+    uint32_t FoundSum = 0, FoundMax = 0, LostSum = 0, LostMax = 0, Found = 0, Lost = 0;
+    uint32_t OffStart = 0, Latency;
+    uint8_t On = FALSE, Seen = TRUE, Was = FALSE, Now;
+
+    RandomState = RANDOM_SEED;
+    Offset = 512;
+    Time = 0;
+    Goertzel_Init(&Detector, TONE_HZ, SAMPLE_HZ, BLOCK, MIN_MAGNITUDE);
+    while (Time < ONOFF_MS) {
+        if (Time >= SegmentEnd) {
+            On = !On;
+            if (On) {
+                Missed += !Seen;
+                Seen = FALSE;
+                OnStart = Time;
+                Segments++;
+            } else {
+                // a tone found in the first blocks after it stopped still counts
+                OffStart = Time;
+                Grace = Time + (GOERTZEL_CONFIDENCE + 1) * BLOCK;
+            }
+            SegmentEnd = Time + Between(MIN_SEGMENT_MS, MAX_SEGMENT_MS);
+        }
+        if (!Goertzel_Step(&Detector, NextSample(On ? ONOFF_AMPLITUDE : 0))) {
+            continue;
+        }
+        Now = Goertzel_Found(&Detector);
+        if (Now && !Was) {
+            if (!Seen && (On || (Time < Grace))) {
+                Seen = TRUE;
+                Found++;
+                Latency = Time - OnStart;
+                FoundSum += Latency;
+                FoundMax = (Latency > FoundMax) ? Latency : FoundMax;
+            } else if (!On) {
+                False++;
+            }
+        } else if (!Now && Was && !On) {
+            Lost++;
+            Latency = Time - OffStart;
+            LostSum += Latency;
+            LostMax = (Latency > LostMax) ? Latency : LostMax;
+        }
+        Was = Now;
+    }
+    Missed += On && !Seen;
+    printf("  on/off    %u tones of %d: %u missed, %u found while off, found after %.0f ms"
+            " (max %u), lost after %.0f ms (max %u)%s\n",
+            Segments, ONOFF_AMPLITUDE, Missed, False, Found ? (double) FoundSum / Found : 0.0,
+            FoundMax, Lost ? (double) LostSum / Lost : 0.0, LostMax,
+            (Missed || False) ? "  FAILED" : "");
+    return Missed || False;
+}
+
+static void RunCost(void)
+{
+    Goertzel_t Detector;
+    uint64_t Start;
+    uint32_t b, n;
+
+    Goertzel_Init(&Detector, TONE_HZ, SAMPLE_HZ, BLOCK, MIN_MAGNITUDE);
+    RandomState = RANDOM_SEED;
+    Start = CpuNs();
+    for (b = 0; b < TIMED_BLOCKS; b++) {
+        for (n = 0; n < BLOCK; n++) {
+            Goertzel_Step(&Detector, 512 + (NextRandom() & 0xFF));
+        }
+        Sink = Goertzel_Magnitude(&Detector);
+    }
+    Start = CpuNs() - Start;
+    printf("  cost      %d ops per sample, %d per block end: %d ops per %d-sample block"
+            " (%.1f per sample); %.0f ns per block on the host\n",
+            OPS_PER_SAMPLE, GOERTZEL_BINS * OPS_PER_BIN + OPS_DECISION,
+            BLOCK * OPS_PER_SAMPLE + GOERTZEL_BINS * OPS_PER_BIN + OPS_DECISION, BLOCK,
+            (double) (BLOCK * OPS_PER_SAMPLE + GOERTZEL_BINS * OPS_PER_BIN + OPS_DECISION) / BLOCK,
+            (double) Start / TIMED_BLOCKS);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t Blocks = DEFAULT_BLOCKS;
+    int Failed = 0;
+
+    if (argc > 1) {
+        Blocks = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (Blocks == 0) {
+        fprintf(stderr, "bench_goertzel: bad block count\n");
+        return 1;
+    }
+
+    printf("bench_goertzel: %d Hz tone, %d Hz samples, %d-sample blocks, bins %d apart\n",
+            TONE_HZ, SAMPLE_HZ, BLOCK, GOERTZEL_GUARD_BINS * SAMPLE_HZ / BLOCK);
+    Failed |= RunMagnitude();
+    Failed |= RunDetect(Blocks);
+    Failed |= RunOnOff();
+    RunCost();
+    return Failed;
+}
@@ -0,0 +1,395 @@
+/*
+ * File: bench_hsmstats.c
+ *
+ * Test for the HSM timing statistics. The robot is run in virtual time with
+ * a tick hook playing the field of bench_record at it, and noting which of
+ * RobotHSM's states it is in at every ms. Then:
+ *
+ *   totals   each RobotHSM state's time in HSMStats, over its stays and the
+ *            one it is still in, against the ms it was seen in; they may
+ *            differ by a ms a stay, where the hook looks between them
+ *   rows     every RobotHSM row leaves its state, so the rows taken have
+ *            to add up to the stays ended
+ *   active   the machines in the middle of a stay have to be the ones on
+ *            RobotHSM's active path, in the states it has them in; a
+ *            sub-state machine started while its parent state is not
+ *            active is not in a stay
+ *   dump     a dump, collected from the UART with the robot running on, has
+ *            to be the size of HSMStats_t, and each of its counts no less
+ *            than just before HSMStats_Dump() and no more than after the
+ *            last byte
+ *   latency  the field run's latencies come out 0, the core timer stand-in
+ *            in host/xc.h stepping once a ms and RobotHSM running its
+ *            events in the ms they are posted in; so an event is posted to
+ *            RobotHSM and the core timer moved on by a set delay
+ *            (Sim_AddCoreTicks()) before ES_RunStep() runs it, and the one
+ *            more event handled, its bin and the worst latency have to come
+ *            out at that delay
+ *
+ * Then the cost of a transition, on the host and on the PIC32 cost model
+ * below, is timed on the hooks HSM runs for a row out of a state with no
+ * sub-state machine: HSMStats_Row(), HSMStats_Exit(), HSMStats_Entry().
+ *
+ * Cost model (PIC32MX M4K at 80 MHz, as bench_record has it): 1 cycle per
+ * ALU op, load and store, 2 per taken branch, jump or call counting its
+ * delay slot. By hand, each hook's call and return 4, the test of the last
+ * machine's slot 3 and the one for none 1; then HSMStats_Row() the state's
+ * slot 4, the base of the tables 2, the row's count 5 and the tally 5;
+ * HSMStats_Exit() clearing In 1, the state's slot 4, the stamp 3, the base
+ * 2, the total 6, the bin 6 and its clamp 3, the dwell count 4 and the tally
+ * 5; HSMStats_Entry() the stamp and In 4. A sub-state machine left and
+ * re-entered with its parent's state adds an exit and an entry.
+ *
+ * Writes the dump to the file named on the command line, if there is one,
+ * for host/hsmstats. Fails if a check does not hold or a machine was lost.
+ *
+ * usage: bench_hsmstats [dump]
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "HSMStats.h"
+#include "RobotHSM.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define RUN_MS 60000
+#define MAX_DUMP_MS 1000
+#define RANDOM_SEED 118
+
+// the field, as bench_record plays it
+#define FLOOR_READING 500 // tape sensors over the floor
+#define TAPE_LOW 150 // and over tape, where the right one reads high
+#define TAPE_HIGH 850
+#define NOISE 8
+#define MIN_TAPE_MS 60
+#define MAX_TAPE_MS 300
+#define MIN_FLOOR_MS 200
+#define MAX_FLOOR_MS 3000
+#define BEACON_HEARD 150 // the beacon board's output, low while it hears it
+#define BEACON_QUIET 800
+#define BEACON_CHANGE 1 // chance in 1000 each ms
+#define TRACK_LOW 400
+#define TRACK_HIGH 950
+#define TRACK_CHANGE 1
+#define BUMP_CHANGE 2
+
+#define TIMED_TRANSITIONS 10000000
+#define CPU_MHZ 80
+#define CYCLES_ROW 24
+#define CYCLES_EXIT 42
+#define CYCLES_ENTRY 12
+#define BUDGET_CYCLES 80 // 1 us
+
+#define TICKS_PER_MS (HSMSTATS_TICKS_PER_US * 1000)
+#define MAX_TOP_STATES 8
+
+#define NUM_DELAYS (sizeof (DelaysUs) / sizeof (DelaysUs[0]))
+
+#define NUM_TAPES (sizeof (TapePins) / sizeof (TapePins[0]))
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const unsigned int TapePins[] = {AD_PORTV6, AD_PORTV4, AD_PORTV3};
+static const uint16_t TapeReadings[] = {TAPE_LOW, TAPE_HIGH, TAPE_LOW};
+static const unsigned int TrackPins[] = {AD_PORTW7, AD_PORTW8};
+
+// injected between post and run, rising so each is the worst yet
+static const uint32_t DelaysUs[] = {10, 100, 1000, 20000};
+
+static uint32_t RandomState = RANDOM_SEED;
+static uint32_t TapeEnd[NUM_TAPES];
+static uint8_t OnTape[NUM_TAPES];
+static uint16_t Track = TRACK_LOW;
+
+static uint32_t Seen[MAX_TOP_STATES]; // ms RobotHSM was seen in each state
+
+static uint8_t Sent[sizeof (HSMStats_t) + 1];
+static uint32_t SentSize;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static int32_t Between(int32_t Low, int32_t High)
+{
+    return Low + (int32_t) (NextRandom() % (uint32_t) (High - Low + 1));
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void Field(uint32_t Now)
+{
+    uint8_t State = HSM_GetState(&RobotHSMMachine);
+    uint8_t i;
+
+    if (State < MAX_TOP_STATES) {
+        Seen[State]++;
+    }
+    for (i = 0; i < NUM_TAPES; i++) {
+        if (Now >= TapeEnd[i]) {
+            OnTape[i] = !OnTape[i];
+            TapeEnd[i] = Now + (OnTape[i] ? Between(MIN_TAPE_MS, MAX_TAPE_MS)
+                    : Between(MIN_FLOOR_MS, MAX_FLOOR_MS));
+        }
+        Sim_SetADPin(TapePins[i], (OnTape[i] ? TapeReadings[i] : FLOOR_READING)
+                + Between(-NOISE, NOISE));
+    }
+    if (Between(0, 999) < BEACON_CHANGE) {
+        Sim_SetADPin(AD_PORTW6, Between(0, 1) ? BEACON_HEARD : BEACON_QUIET);
+    }
+    if (Between(0, 999) < TRACK_CHANGE) {
+        Track = (Track == TRACK_LOW) ? TRACK_HIGH : TRACK_LOW;
+    }
+    for (i = 0; i < 2; i++) {
+        Sim_SetADPin(TrackPins[i], Track + Between(-NOISE, NOISE));
+    }
+    if (Between(0, 999) < BUMP_CHANGE) {
+        Sim_SetBumpers(Between(0, FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+static void Collect(char ch)
+{
+    if (SentSize < sizeof (Sent)) {
+        Sent[SentSize] = (uint8_t) ch;
+    }
+    SentSize++;
+}
+
+static const HSMStatsMachine_t *FindMachine(const HSMStats_t *pStats, const char *pName)
+{
+    uint8_t i;
+
+    for (i = 0; i < pStats->NumMachines; i++) {
+        if (strcmp(pStats->Machines[i].Name, pName) == 0) {
+            return &pStats->Machines[i];
+        }
+    }
+    return NULL;
+}
+
+/* every count of pMiddle no less than pBefore's and no more than pAfter's */
+static uint8_t InOrder(const HSMStats_t *pBefore, const HSMStats_t *pMiddle,
+        const HSMStats_t *pAfter)
+{
+    uint32_t i, j;
+
+#define IN_ORDER(Field) ((pBefore->Field <= pMiddle->Field) && (pMiddle->Field <= pAfter->Field))
+    for (i = 0; i < HSMSTATS_MAX_STATES; i++) {
+        if (!IN_ORDER(Total[i])) {
+            return FALSE;
+        }
+        for (j = 0; j < HSMSTATS_BINS; j++) {
+            if (!IN_ORDER(Dwell[i][j])) {
+                return FALSE;
+            }
+        }
+    }
+    for (i = 0; i < HSMSTATS_MAX_ROWS; i++) {
+        if (!IN_ORDER(Taken[i])) {
+            return FALSE;
+        }
+    }
+    for (i = 0; i < HSMSTATS_BINS; i++) {
+        if (!IN_ORDER(Latency[i])) {
+            return FALSE;
+        }
+    }
+    return IN_ORDER(Handled) && IN_ORDER(WorstLatency)
+            && (memcmp(pMiddle->FirstRow, pAfter->FirstRow, sizeof (pAfter->FirstRow)) == 0);
+#undef IN_ORDER
+}
+
+/* the latency bin Ticks falls in, worked out a bit at a time */
+static uint8_t LatencyBin(uint32_t Ticks)
+{
+    uint8_t Bin = 0;
+
+    for (Ticks >>= HSMSTATS_LATENCY_SHIFT; Ticks; Ticks >>= 1) {
+        Bin++;
+    }
+    return (Bin < HSMSTATS_BINS) ? Bin : HSMSTATS_BINS - 1;
+}
+
+static uint8_t RunLatency(void)
+{
+    static HSMStats_t Before, After;
+    ES_Event ThisEvent;
+    uint32_t Ticks, i;
+    uint8_t Bin, Bad, Failed = FALSE;
+
+    ThisEvent.EventType = ES_KEYINPUT;
+    ThisEvent.EventParam = 0;
+    for (i = 0; i < NUM_DELAYS; i++) {
+        Ticks = DelaysUs[i] * HSMSTATS_TICKS_PER_US;
+        Bin = LatencyBin(Ticks);
+        HSMStats_Get(&Before);
+        PostRobotHSM(ThisEvent);
+        Sim_AddCoreTicks(Ticks);
+        while (ES_RunStep() == TRUE) {
+            ;
+        }
+        HSMStats_Get(&After);
+        Bad = (After.Handled != Before.Handled + 1) || (After.WorstLatency != Ticks)
+                || (After.Latency[Bin] != Before.Latency[Bin] + 1);
+        Failed |= Bad;
+        printf("  latency %5u us injected, %7.1f us reported, bin %u%s\n", DelaysUs[i],
+                (double) After.WorstLatency / HSMSTATS_TICKS_PER_US, Bin, Bad ? "  FAILED" : "");
+    }
+    return Failed;
+}
+
+static void RunCost(void)
+{
+    uint64_t Start;
+    uint32_t n;
+
+    Start = CpuNs();
+    for (n = 0; n < TIMED_TRANSITIONS; n++) {
+        HSMStats_Row(&RobotHSMMachine, 0);
+        HSMStats_Exit(&RobotHSMMachine);
+        HSMStats_Entry(&RobotHSMMachine);
+    }
+    Start = CpuNs() - Start;
+    printf("  transition %5.1f ns on the host  %u cycles (%4.2f us) on the PIC32, budget %u;"
+            " %u more a sub-state machine\n", (double) Start / TIMED_TRANSITIONS,
+            CYCLES_ROW + CYCLES_EXIT + CYCLES_ENTRY,
+            (double) (CYCLES_ROW + CYCLES_EXIT + CYCLES_ENTRY) / CPU_MHZ, BUDGET_CYCLES,
+            CYCLES_EXIT + CYCLES_ENTRY);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static HSMStats_t Before, Dumped, After;
+    const HSMStatsMachine_t *pRobot, *pStats;
+    const HSM_Machine_t *pMachine;
+    uint32_t Stays, Ended = 0, Rows = 0, Ms, Off, Slack, i, j;
+    uint32_t Began, Path = 0, InStay = 0;
+    uint8_t Failed = FALSE, Bad;
+    FILE *pFile;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_hsmstats: init failed\n");
+        return 1;
+    }
+    Began = ES_Timer_GetTime();
+    Sim_SetTickHook(Field);
+    Sim_RunFor(RUN_MS);
+    HSMStats_Get(&Before);
+
+    printf("bench_hsmstats: %u s of field run, %u machines, %u states, %u rows, %u lost\n",
+            RUN_MS / 1000, Before.NumMachines, Before.NumStates, Before.NumRows, Before.Lost);
+    Failed |= (Before.Lost != 0);
+    pRobot = FindMachine(&Before, RobotHSMMachine.Name);
+    if ((pRobot == NULL) || (pRobot->NumStates != RobotHSMMachine.NumStates)
+            || (pRobot->NumStates > MAX_TOP_STATES)) {
+        printf("  FAILED: no RobotHSM in the tables\n");
+        return 1;
+    }
+    printf("  state       stays  ms in stats  ms seen\n");
+    for (i = 0; i < pRobot->NumStates; i++) {
+        Stays = 0;
+        for (j = 0; j < HSMSTATS_BINS; j++) {
+            Stays += Before.Dwell[pRobot->FirstState + i][j];
+        }
+        Ms = (uint32_t) (((uint64_t) Before.Total[pRobot->FirstState + i]
+                + ((pRobot->State == i) ? pRobot->Stayed : 0)) * (1 << HSMSTATS_TOTAL_SHIFT)
+                / TICKS_PER_MS);
+        Off = (Ms > Seen[i]) ? Ms - Seen[i] : Seen[i] - Ms;
+        Slack = Stays + 1 + Began;
+        Bad = (Off > Slack);
+        Failed |= Bad;
+        printf("  %-10s %6u %12u %8u%s\n", RobotHSMMachine.States[i].Name, Stays, Ms, Seen[i],
+                Bad ? "  FAILED" : "");
+        Ended += Stays;
+        for (j = 0; j < RobotHSMMachine.States[i].NumRows; j++) {
+            Rows += Before.Taken[Before.FirstRow[pRobot->FirstState + i] + j];
+        }
+    }
+    Bad = (Rows != Ended);
+    Failed |= Bad;
+    printf("  %u RobotHSM rows taken, %u stays ended%s\n", Rows, Ended, Bad ? "  FAILED" : "");
+
+    Bad = FALSE;
+    for (pMachine = &RobotHSMMachine;
+            pMachine && (HSM_GetState(pMachine) != HSM_NOT_STARTED);
+            pMachine = pMachine->States[HSM_GetState(pMachine)].Child) {
+        pStats = FindMachine(&Before, pMachine->Name);
+        Bad |= (pStats == NULL) || (pStats->State != HSM_GetState(pMachine));
+        Path++;
+    }
+    for (i = 0; i < Before.NumMachines; i++) {
+        InStay += (Before.Machines[i].State != HSM_NOT_STARTED);
+    }
+    Bad |= (InStay != Path);
+    Failed |= Bad;
+    printf("  %u machines in a stay, %u on the active path%s\n", InStay, Path,
+            Bad ? "  FAILED" : "");
+
+    SentSize = 0;
+    Sim_SetSerialSink(Collect);
+    HSMStats_Get(&Before);
+    HSMStats_Dump();
+    for (i = 0; (i < MAX_DUMP_MS) && (SentSize < sizeof (HSMStats_t)); i++) {
+        Sim_RunFor(1);
+    }
+    Sim_SetSerialSink((SimSerialSink_t) 0);
+    HSMStats_Get(&After);
+    memcpy(&Dumped, Sent, sizeof (Dumped));
+    Bad = (SentSize != sizeof (HSMStats_t))
+            || memcmp(Dumped.Magic, HSMSTATS_MAGIC, sizeof (Dumped.Magic))
+            || (Dumped.Version != HSMSTATS_VERSION) || !InOrder(&Before, &Dumped, &After);
+    Failed |= Bad;
+    printf("  dump of %u bytes in %u ms, %u events' latency, worst %.1f us%s\n", SentSize, i,
+            Dumped.Handled, (double) Dumped.WorstLatency / HSMSTATS_TICKS_PER_US,
+            Bad ? "  FAILED" : "");
+    Sim_SetTickHook((SimTickHook_t) 0);
+    Failed |= RunLatency();
+    RunCost();
+
+    if ((argc > 1) && (SentSize == sizeof (HSMStats_t))) {
+        pFile = fopen(argv[1], "wb");
+        if ((pFile == NULL) || (fwrite(Sent, 1, SentSize, pFile) != SentSize)) {
+            fprintf(stderr, "bench_hsmstats: cannot write %s\n", argv[1]);
+            return 1;
+        }
+        fclose(pFile);
+    }
+    return Failed;
+}
@@ -0,0 +1,337 @@
+/*
+ * File: bench_hysteresis.c
+ *
+ * Test for the Comparator bank and for what it does to the analog sensor
+ * edges RobotSensors posts:
+ *
+ *   bank       random banks fed random inputs, mostly close to the bands,
+ *              checked step by step against one plain if/else comparator per
+ *              channel
+ *   waveforms  RobotSensors in virtual time with every analog pin driven by
+ *              a noisy recorded-style signal: long dwells either side of the
+ *              threshold joined by slow ramps, gaussian-ish noise on top and
+ *              the odd spike. The edges it posts are counted next to the
+ *              edges of the clean signal and of the single compare against
+ *              the threshold that the services did before, sampled on the
+ *              same group schedule.
+ *
+ * Fails if the bank and the reference ever disagree or if the hysteresis
+ * posts as many edges as the single compare did.
+ *
+ * usage: bench_hysteresis [virtual seconds]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Comparator.h"
+#include "SensorDelta.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "RobotSensors.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 600
+#define BANK_STEPS 1000000
+#define BANK_CHANNELS 8
+#define RANDOM_SEED 118
+
+#define TICK_MS 5 // RobotSensors tick
+#define MIN_DWELL_MS 100
+#define MAX_DWELL_MS 1500
+#define MIN_RAMP_MS 10
+#define MAX_RAMP_MS 400
+#define MIN_OFFSET 15 // how far a dwell sits from the threshold
+#define MAX_OFFSET 150
+#define NOISE 10 // each of four uniform terms, about 11.5 counts rms in all
+#define SPIKE_ODDS 500
+#define MIN_SPIKE 100
+#define MAX_SPIKE 250
+
+#define NUM_ANALOG 6
+#define FRONT_TRACK 4
+#define REAR_TRACK 5
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    unsigned int Pin;
+    uint16_t Threshold;
+    uint8_t ActiveLow;
+    uint8_t Sensor; // SENSOR_* bit the channel feeds
+    uint8_t Period; // ticks between evaluations of the channel's group
+} Channel_t;
+
+/* the clean signal on one pin */
+typedef struct {
+    int16_t From;
+    int16_t To;
+    uint32_t RampStart;
+    uint32_t RampEnd;
+    uint32_t DwellEnd;
+    uint8_t Above;
+} Signal_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// RobotSensors' channels, with the thresholds it has always used
+static const Channel_t Channels[NUM_ANALOG] = {
+    {AD_PORTV6, 300, TRUE, SENSOR_CANNON_TAPE, 9},
+    {AD_PORTV4, 700, FALSE, SENSOR_RIGHT_TAPE, 9},
+    {AD_PORTV3, 300, TRUE, SENSOR_LEFT_TAPE, 9},
+    {AD_PORTW6, 300, TRUE, SENSOR_BEACON, 4},
+    {AD_PORTW7, 850, FALSE, SENSOR_TRACK_WIRE, 3},
+    {AD_PORTW8, 850, FALSE, SENSOR_TRACK_WIRE, 3},
+};
+
+static uint32_t RandomState;
+static Signal_t Signals[NUM_ANALOG];
+static int16_t Clean[NUM_ANALOG];
+static int16_t Noisy[NUM_ANALOG];
+static uint8_t CleanSensors, OldSensors;
+static uint32_t CleanEdges, OldEdges;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static int32_t Between(int32_t Low, int32_t High)
+{
+    return Low + (int32_t) (NextRandom() % (uint32_t) (High - Low + 1));
+}
+
+static uint16_t Clamp(int32_t Value)
+{
+    return (Value < 0) ? 0 : (Value > AD_MAX_VALUE) ? AD_MAX_VALUE : Value;
+}
+
+/*
+ * Plain per-channel comparator the bank is checked against.
+ */
+static uint8_t ReferenceUpdate(uint8_t *pHigh, const uint16_t *Thresholds,
+        const uint16_t *Hysteresis, const uint16_t *Inputs)
+{
+    uint8_t Last = *pHigh, i;
+    int32_t Rise, Fall;
+
+    for (i = 0; i < BANK_CHANNELS; i++) {
+        Rise = Thresholds[i] + Hysteresis[i];
+        Fall = Thresholds[i] - Hysteresis[i];
+        if (Rise > UINT16_MAX) {
+            Rise = UINT16_MAX;
+        }
+        if (Inputs[i] > Rise) {
+            *pHigh |= 1 << i;
+        } else if (Inputs[i] < Fall) {
+            *pHigh &= ~(1 << i);
+        }
+    }
+    return *pHigh ^ Last;
+}
+
+static int RunBank(void)
+{
+    ComparatorBank_t Bank;
+    uint16_t Thresholds[BANK_CHANNELS], Hysteresis[BANK_CHANNELS], Inputs[BANK_CHANNELS];
+    uint32_t Step, Mismatches = 0, Edges = 0;
+    uint8_t ActiveLow = 0, High = 0, Changed, i;
+
+    RandomState = RANDOM_SEED;
+    for (Step = 0; Step < BANK_STEPS; Step++) {
+        // a fresh bank now and then, with some bands at the ends of the range
+        if ((Step % 10000) == 0) {
+            Comparator_Init(&Bank, BANK_CHANNELS);
+            ActiveLow = (uint8_t) NextRandom();
+            High = ActiveLow;
+            for (i = 0; i < BANK_CHANNELS; i++) {
+                Thresholds[i] = (NextRandom() % 8) ? Between(0, AD_MAX_VALUE)
+                        : (NextRandom() & 1) ? 0 : UINT16_MAX;
+                Hysteresis[i] = Between(0, 60);
+                Comparator_SetChannel(&Bank, i, Thresholds[i], Hysteresis[i],
+                        (ActiveLow >> i) & 1);
+            }
+        }
+        for (i = 0; i < BANK_CHANNELS; i++) {
+            Inputs[i] = (NextRandom() % 4) ? Clamp(Thresholds[i] + Between(-80, 80))
+                    : (uint16_t) NextRandom();
+        }
+        Changed = Comparator_Update(&Bank, Inputs);
+        Edges += __builtin_popcount(Changed);
+        if ((Changed != ReferenceUpdate(&High, Thresholds, Hysteresis, Inputs))
+                || (Comparator_Active(&Bank) != (High ^ ActiveLow))) {
+            Mismatches++;
+        }
+    }
+    printf("  bank       %u steps of %d channels, %u edges, %u mismatches%s\n",
+            BANK_STEPS, BANK_CHANNELS, Edges, Mismatches, Mismatches ? "  FAILED" : "");
+    return Mismatches != 0;
+}
+
+/* start the next dwell on the other side of the threshold */
+static void NextLevel(uint8_t i, uint32_t Now)
+{
+    Signal_t *pSignal = &Signals[i];
+    int32_t Offset = Between(MIN_OFFSET, MAX_OFFSET);
+
+    pSignal->Above = !pSignal->Above;
+    pSignal->From = Clean[i];
+    pSignal->To = Clamp(Channels[i].Threshold + (pSignal->Above ? Offset : -Offset));
+    pSignal->RampStart = Now;
+    pSignal->RampEnd = Now + Between(MIN_RAMP_MS, MAX_RAMP_MS);
+    pSignal->DwellEnd = pSignal->RampEnd + Between(MIN_DWELL_MS, MAX_DWELL_MS);
+}
+
+/* SENSOR_* bits for one set of readings, compared straight to the thresholds */
+static uint8_t SensorLevels(const int16_t *Values)
+{
+    uint8_t Levels = 0, Coils = 0, Active, i;
+
+    for (i = 0; i < NUM_ANALOG; i++) {
+        Active = Channels[i].ActiveLow ? (Values[i] < Channels[i].Threshold)
+                : (Values[i] > Channels[i].Threshold);
+        if (Active) {
+            if (Channels[i].Sensor == SENSOR_TRACK_WIRE) {
+                Coils++;
+            } else {
+                Levels |= Channels[i].Sensor;
+            }
+        }
+    }
+    return (Coils == 2) ? (Levels | SENSOR_TRACK_WIRE) : Levels;
+}
+
+/* edges of the sensors whose group is due on this tick */
+static uint32_t GroupEdges(uint8_t *pLevels, uint8_t NewLevels, uint32_t Tick)
+{
+    uint8_t Due = 0, Changed, i;
+
+    for (i = 0; i < NUM_ANALOG; i++) {
+        if (((Tick - 1) % Channels[i].Period) == 0) {
+            Due |= Channels[i].Sensor;
+        }
+    }
+    Changed = (NewLevels ^ *pLevels) & Due;
+    *pLevels ^= Changed;
+    return __builtin_popcount(Changed);
+}
+
+static void Waveforms(uint32_t Now)
+{
+    Signal_t *pSignal;
+    int32_t Value;
+    uint8_t i;
+
+    for (i = 0; i < NUM_ANALOG; i++) {
+        pSignal = &Signals[i];
+        if (i == REAR_TRACK) {
+            // both coils see the same wire
+            Clean[i] = Clean[FRONT_TRACK];
+        } else {
+            if (Now >= pSignal->DwellEnd) {
+                NextLevel(i, Now);
+            }
+            if (Now >= pSignal->RampEnd) {
+                Clean[i] = pSignal->To;
+            } else {
+                Clean[i] = pSignal->From + (pSignal->To - pSignal->From)
+                        * (int32_t) (Now - pSignal->RampStart)
+                        / (int32_t) (pSignal->RampEnd - pSignal->RampStart);
+            }
+        }
+        Value = Clean[i] + Between(-NOISE, NOISE) + Between(-NOISE, NOISE)
+                + Between(-NOISE, NOISE) + Between(-NOISE, NOISE);
+        if ((NextRandom() % SPIKE_ODDS) == 0) {
+            Value += (NextRandom() & 1) ? Between(MIN_SPIKE, MAX_SPIKE)
+                    : -Between(MIN_SPIKE, MAX_SPIKE);
+        }
+        Noisy[i] = Clamp(Value);
+        Sim_SetADPin(Channels[i].Pin, Noisy[i]);
+    }
+    // RobotSensors takes the scan that follows this hook on every fifth ms
+    if ((Now % TICK_MS) == 0) {
+        CleanEdges += GroupEdges(&CleanSensors, SensorLevels(Clean), Now / TICK_MS);
+        OldEdges += GroupEdges(&OldSensors, SensorLevels(Noisy), Now / TICK_MS);
+    }
+}
+
+static int RunWaveforms(uint32_t RunS)
+{
+    SensorDeltaStats_t Stats;
+    uint8_t i, Failed;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_hysteresis: init failed\n");
+        return 1;
+    }
+    // the waveforms sit about the fixed thresholds, so RobotHSM's startup
+    // calibration is turned off again
+    RobotSensors_Calibrate(FALSE);
+    RandomState = RANDOM_SEED;
+    for (i = 0; i < NUM_ANALOG; i++) {
+        // start inactive, the way the services come up
+        Signals[i].Above = Channels[i].ActiveLow;
+        Clean[i] = Channels[i].Threshold + (Signals[i].Above ? MAX_OFFSET : -MAX_OFFSET);
+        Signals[i].DwellEnd = Between(0, MAX_DWELL_MS);
+        Signals[i].RampStart = 0;
+        Signals[i].RampEnd = 0;
+        Signals[i].To = Clean[i];
+        Sim_SetADPin(Channels[i].Pin, Clean[i]);
+    }
+    CleanSensors = 0;
+    OldSensors = 0;
+    CleanEdges = 0;
+    OldEdges = 0;
+    Sim_SetTickHook(Waveforms);
+    Sim_RunFor(RunS * 1000);
+    Sim_SetTickHook((SimTickHook_t) 0);
+    SensorDelta_GetStats(&Stats);
+
+    Failed = (Stats.Edges >= OldEdges);
+    printf("  waveforms  %u s: %u clean edges, %u with a single compare, %u with hysteresis%s\n",
+            RunS, CleanEdges, OldEdges, Stats.Edges, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunS = DEFAULT_RUN_S;
+    int Failed = 0;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (RunS == 0) {
+        fprintf(stderr, "bench_hysteresis: bad run length\n");
+        return 1;
+    }
+
+    printf("bench_hysteresis\n");
+    Failed |= RunBank();
+    Failed |= RunWaveforms(RunS);
+    return Failed;
+}
@@ -0,0 +1,199 @@
+/*
+ * File: bench_motion.c
+ *
+ * Slip in the timed moves of the state machines, stepped as they used to be
+ * and as Motion primitives. Each move is run on the simulated robot's drive
+ * model (Sim_SetTraction()) over a sweep of floor tractions, a few times at
+ * each since a slipping tyre grips unevenly:
+ *
+ *   step       both motors set to the move's speeds, and stopped Ms later
+ *   primitive  Motion_Arc() with the move's speeds and Ms, to its MotionDone
+ *
+ * and how far the faster wheel got and where the robot ended up pointing
+ * are set against the same run with a traction that never slips. Reported
+ * for each move and way, over all the runs: the mean and spread of the
+ * travel error, in ms of the move at its speed, the spread of the heading
+ * error in degrees, and the ms the motors ran.
+ *
+ * Fails if a move's travel spreads as widely as a primitive as stepped.
+ *
+ * usage: bench_motion [runs at each traction]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Actuators.h"
+#include "HSM.h"
+#include "Motion.h"
+#include "Odometry.h"
+#include "RobotHSM.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUNS 5
+#define NO_SLIP 1000.0f
+#define SETTLE_MS 1000 // for the wheels to stop after the motors do
+#define MAX_MOVE_MS 10000
+#define MAX_RUNS 100
+
+#define STEP 0
+#define PRIMITIVE 1
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    int8_t Left;
+    int8_t Right;
+    uint16_t Ms;
+} Move_t;
+
+typedef struct {
+    float Travel; // mm, the faster wheel
+    float Heading; // radians
+    uint32_t RunMs; // the motors were on
+} Result_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+// timed moves from the Pursue, Search and Escape machines
+static const Move_t Moves[] = {
+    {"TapeBackR", -100, -100, 100},
+    {"RightTape", -100, 0, 600},
+    {"Straight", 85, 85, 500},
+    {"BackR", -100, -100, 750},
+    {"FRT1", -90, 0, 900},
+    {"Escape1", 85, -85, 1500},
+};
+
+static const float Tractions[] = {0.6f, 0.8f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f};
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static Result_t RunMove(const Move_t *pMove, uint8_t Way, float Traction)
+{
+    SimPose_t Start, End;
+    Result_t Result;
+    uint32_t Began;
+
+    Sim_SetTraction(Traction);
+    Sim_GetPose(&Start);
+    Began = ES_Timer_GetTime();
+    if (Way == STEP) {
+        Actuators_Drive(pMove->Left, pMove->Right);
+        Sim_RunFor(pMove->Ms);
+        Actuators_Drive(0, 0);
+    } else {
+        Motion_Arc(pMove->Left, pMove->Right, pMove->Ms);
+        while (Motion_IsMoving() && (ES_Timer_GetTime() - Began < MAX_MOVE_MS)) {
+            Sim_RunFor(1);
+        }
+    }
+    Result.RunMs = ES_Timer_GetTime() - Began;
+    Sim_RunFor(SETTLE_MS);
+    Sim_GetPose(&End);
+    if (abs(pMove->Left) >= abs(pMove->Right)) {
+        Result.Travel = End.LeftMm - Start.LeftMm;
+    } else {
+        Result.Travel = End.RightMm - Start.RightMm;
+    }
+    Result.Heading = End.Heading - Start.Heading;
+    return Result;
+}
+
+static void Spread(const float *pValues, uint32_t Count, float *pMean, float *pSd)
+{
+    double Sum = 0, Squares = 0;
+    uint32_t i;
+
+    for (i = 0; i < Count; i++) {
+        Sum += pValues[i];
+    }
+    *pMean = Sum / Count;
+    for (i = 0; i < Count; i++) {
+        Squares += (pValues[i] - *pMean) * (pValues[i] - *pMean);
+    }
+    *pSd = sqrt(Squares / Count);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static float TravelErr[2][MAX_RUNS], HeadingErr[2][MAX_RUNS];
+    uint32_t Runs = DEFAULT_RUNS, Count, i, t, r;
+    float Mean[2], Sd[2], HeadingMean, HeadingSd[2];
+    Result_t Ideal, Slip;
+    uint32_t RunMs[2];
+    uint8_t Way, Failed = FALSE;
+
+    if (argc > 1) {
+        Runs = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if ((Runs == 0) || (Runs * (sizeof (Tractions) / sizeof (Tractions[0])) > MAX_RUNS)
+            || (Sim_Init() != SUCCESS)) {
+        fprintf(stderr, "bench_motion: init failed\n");
+        return 1;
+    }
+    // Lookout with its spin target dropped, which only the moves drive
+    Odometry_Turn(0, PostRobotHSM);
+    Motion_Arc(0, 0, 0);
+    Sim_RunFor(SETTLE_MS);
+
+    printf("bench_motion: traction %.1f-%.1f a ms, %u runs at each; travel error in ms of the move\n",
+            Tractions[0], Tractions[sizeof (Tractions) / sizeof (Tractions[0]) - 1], Runs);
+    printf("                        step                             primitive\n");
+    printf("  move        ms   mean    sd  heading sd  ran     mean    sd  heading sd  ran\n");
+    for (i = 0; i < sizeof (Moves) / sizeof (Moves[0]); i++) {
+        for (Way = STEP; Way <= PRIMITIVE; Way++) {
+            Ideal = RunMove(&Moves[i], Way, NO_SLIP);
+            RunMs[Way] = Ideal.RunMs;
+            Count = 0;
+            for (t = 0; t < sizeof (Tractions) / sizeof (Tractions[0]); t++) {
+                for (r = 0; r < Runs; r++) {
+                    Slip = RunMove(&Moves[i], Way, Tractions[t]);
+                    TravelErr[Way][Count] = (Slip.Travel - Ideal.Travel) / Ideal.Travel * Moves[i].Ms;
+                    HeadingErr[Way][Count] = (Slip.Heading - Ideal.Heading) * 180 / M_PI;
+                    Count++;
+                }
+            }
+            Spread(TravelErr[Way], Count, &Mean[Way], &Sd[Way]);
+            Spread(HeadingErr[Way], Count, &HeadingMean, &HeadingSd[Way]);
+        }
+        if (Sd[PRIMITIVE] >= Sd[STEP]) {
+            Failed = TRUE;
+        }
+        printf("  %-10s %4u %6.1f %5.1f %7.2f deg %5u   %6.1f %5.1f %7.2f deg %5u%s\n",
+                Moves[i].Name, Moves[i].Ms,
+                Mean[STEP], Sd[STEP], HeadingSd[STEP], RunMs[STEP],
+                Mean[PRIMITIVE], Sd[PRIMITIVE], HeadingSd[PRIMITIVE], RunMs[PRIMITIVE],
+                (Sd[PRIMITIVE] >= Sd[STEP]) ? "  FAILED" : "");
+    }
+    if (strcmp(HSM_GetStateName(&RobotHSMMachine), "Lookout") != 0) {
+        printf("  the robot left Lookout\n");
+        Failed = TRUE;
+    }
+    return Failed;
+}
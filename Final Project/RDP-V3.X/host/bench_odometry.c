@@ -0,0 +1,185 @@
+/*
+ * File: bench_odometry.c
+ *
+ * Turns and backups of the state machines ended on a timer, as they used to
+ * be, and on Odometry, on a charged battery and on one run down to 80%
+ * (Sim_SetBattery()), where the motors turn a fifth slower:
+ *
+ *   timed     Motion holds the move's speeds, stopped Ms later
+ *   odometry  Motion holds the move's speeds until Odometry_Turn() or
+ *             Odometry_Distance() posts that the robot has got there
+ *
+ * Each move ends where its state would hand on to the next one. Reported
+ * for each move, battery and way: how far the simulated robot had turned, in
+ * degrees, or backed, in mm, off the move's target at that moment, and the
+ * ms it took.
+ *
+ * Fails if on the run down battery a move ends further off its target on
+ * Odometry than on its timer.
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "Motion.h"
+#include "Odometry.h"
+#include "RobotHSM.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define SETTLE_MS 1000 // for the wheels to stop, and the battery to be read
+#define MAX_MOVE_MS 20000
+
+#define TIMED 0
+#define ODOMETRY 1
+
+#define TURN 0
+#define DISTANCE 1
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    int8_t Left;
+    int8_t Right;
+    uint16_t Ms; // the timer it used to end on
+    uint8_t Kind;
+    uint16_t Target; // degrees or mm
+} Move_t;
+
+typedef struct {
+    float Error; // degrees or mm past the target, short of it negative
+    uint32_t Ms;
+} Result_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const Move_t Moves[] = {
+    {"Lookout", 90, -90, 8500, TURN, 360},
+    {"FRT1", -90, 0, 900, TURN, 19},
+    {"Escape1", 85, -85, 1500, TURN, 60},
+    {"BackR", -100, -100, 750, DISTANCE, 77},
+    {"TankRight", -50, -50, 2000, DISTANCE, 103},
+};
+
+static const uint8_t Batteries[] = {100, 80};
+
+static uint8_t Reached;
+static uint32_t ReachedAt; // ms
+static SimPose_t ReachedPose;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* stands in for the state's PostRobotHSM, and takes where the robot is the
+ * moment the target is posted */
+static uint8_t PostReached(ES_Event ThisEvent)
+{
+    Reached = TRUE;
+    ReachedAt = ES_Timer_GetTime();
+    Sim_GetPose(&ReachedPose);
+    return TRUE;
+}
+
+static Result_t RunMove(const Move_t *pMove, uint8_t Way)
+{
+    SimPose_t Start, End;
+    Result_t Result;
+    uint32_t Began;
+    float Moved;
+
+    Sim_GetPose(&Start);
+    Began = ES_Timer_GetTime();
+    Motion_Arc(pMove->Left, pMove->Right, 0);
+    if (Way == TIMED) {
+        Sim_RunFor(pMove->Ms);
+        Sim_GetPose(&End);
+        Result.Ms = pMove->Ms;
+    } else {
+        Reached = FALSE;
+        if (pMove->Kind == TURN) {
+            Odometry_Turn(pMove->Target, PostReached);
+        } else {
+            Odometry_Distance(pMove->Target, PostReached);
+        }
+        while (!Reached && (ES_Timer_GetTime() - Began < MAX_MOVE_MS)) {
+            Sim_RunFor(1);
+        }
+        End = ReachedPose;
+        Result.Ms = ReachedAt - Began;
+    }
+    Motion_Arc(0, 0, 0);
+    Sim_RunFor(SETTLE_MS);
+    if (pMove->Kind == TURN) {
+        Moved = fabs(End.Heading - Start.Heading) * 180 / M_PI;
+    } else {
+        Moved = fabs((End.LeftMm - Start.LeftMm) + (End.RightMm - Start.RightMm)) / 2;
+    }
+    Result.Error = Moved - pMove->Target;
+    return Result;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(void)
+{
+    Result_t Results[2];
+    uint8_t Way, b, Worse, Failed = FALSE;
+    uint32_t i;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_odometry: init failed\n");
+        return 1;
+    }
+    // Lookout with its spin target dropped, which only the moves drive
+    Odometry_Turn(0, PostRobotHSM);
+    Motion_Arc(0, 0, 0);
+    Sim_RunFor(SETTLE_MS);
+
+    printf("bench_odometry: off the target where the state hands on, degrees or mm\n");
+    printf("                                      timed           odometry\n");
+    printf("  move        target  battery     error    ms      error    ms\n");
+    for (i = 0; i < sizeof (Moves) / sizeof (Moves[0]); i++) {
+        for (b = 0; b < sizeof (Batteries); b++) {
+            Sim_SetBattery(Batteries[b]);
+            Sim_RunFor(SETTLE_MS);
+            for (Way = TIMED; Way <= ODOMETRY; Way++) {
+                Results[Way] = RunMove(&Moves[i], Way);
+            }
+            Worse = (Batteries[b] < 100)
+                    && (fabs(Results[ODOMETRY].Error) >= fabs(Results[TIMED].Error));
+            Failed |= Worse;
+            printf("  %-10s %4u %-3s %6u%%   %7.1f %5u    %7.1f %5u%s\n",
+                    Moves[i].Name, Moves[i].Target, (Moves[i].Kind == TURN) ? "deg" : "mm",
+                    Batteries[b], Results[TIMED].Error, Results[TIMED].Ms,
+                    Results[ODOMETRY].Error, Results[ODOMETRY].Ms,
+                    Worse ? "  FAILED" : "");
+        }
+    }
+    Sim_SetBattery(100);
+    if (strcmp(HSM_GetStateName(&RobotHSMMachine), "Lookout") != 0) {
+        printf("  the robot left Lookout\n");
+        Failed = TRUE;
+    }
+    return Failed;
+}
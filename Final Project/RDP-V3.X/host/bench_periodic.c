@@ -0,0 +1,244 @@
+/*
+ * File: bench_periodic.c
+ *
+ * Period-jitter measurement for the sensor services' timers. The ES loop is
+ * run in virtual time with a main loop that now and then stays busy for a
+ * few ms (as it does in StartEscape's delay loop), so timeouts wait in the
+ * queue before their owner gets to them. The instant each acquisition
+ * is handled is recorded, and for every channel the test prints the
+ * spread of periods and the drift: how far the last acquisition has
+ * slipped from the grid the first one started.
+ *
+ *   re-arm    four timers at the sensor periods, each re-armed with
+ *             ES_Timer_InitTimer() by its handler, as the services did
+ *   periodic  the same four with ES_Timer_InitPeriodic()
+ *   robot     the RobotSensors tick, driven by the ADAcquire scan wakeup,
+ *             which counts the scans the busy loop missed, and seen
+ *             through its one bumper read per tick
+ *
+ * usage: bench_periodic [virtual ms per pass]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_MS 60000
+#define NUM_CHANNELS 4
+#define MAX_PENDING 64
+#define BUSY_ODDS 16 // the loop goes busy after one drain in this many
+#define MAX_BUSY_MS 4
+#define RANDOM_SEED 118
+
+#define SENSOR_TICK_MS 5
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    const char *Name;
+    uint32_t Period;
+    uint32_t Count;
+    uint32_t First;
+    uint32_t Last;
+    uint32_t MinPeriod;
+    uint32_t MaxPeriod;
+    double SumSq;
+} Channel_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static Channel_t Channels[NUM_CHANNELS] = {
+    {"bumper", 5}, {"tape", 45}, {"track wire", 15}, {"beacon", 20}
+};
+static Channel_t SensorTick = {"sensors", SENSOR_TICK_MS};
+static uint16_t TimerNums[NUM_CHANNELS];
+static uint8_t Rearm;
+
+// timeouts waiting for the busy main loop, by channel
+static uint8_t Pending[MAX_PENDING];
+static uint8_t NumPending;
+
+static uint32_t RandomState = RANDOM_SEED;
+static uint8_t Busy;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static void ResetChannel(Channel_t *pChannel)
+{
+    pChannel->Count = 0;
+    pChannel->MinPeriod = UINT32_MAX;
+    pChannel->MaxPeriod = 0;
+    pChannel->SumSq = 0;
+}
+
+static void Acquired(Channel_t *pChannel, uint32_t Now)
+{
+    uint32_t Period;
+
+    if (pChannel->Count == 0) {
+        pChannel->First = Now;
+    } else {
+        Period = Now - pChannel->Last;
+        if (Period < pChannel->MinPeriod) {
+            pChannel->MinPeriod = Period;
+        }
+        if (Period > pChannel->MaxPeriod) {
+            pChannel->MaxPeriod = Period;
+        }
+        pChannel->SumSq += (double) ((int32_t) Period - (int32_t) pChannel->Period)
+                * ((int32_t) Period - (int32_t) pChannel->Period);
+    }
+    pChannel->Last = Now;
+    pChannel->Count++;
+}
+
+/* the main loop's next move: TRUE to drain, FALSE while it's held up */
+static uint8_t LoopIsFree(void)
+{
+    if (Busy) {
+        Busy--;
+        return FALSE;
+    }
+    if ((NextRandom() % BUSY_ODDS) == 0) {
+        Busy = 1 + NextRandom() % MAX_BUSY_MS;
+    }
+    return TRUE;
+}
+
+static void PrintChannel(const char *Pass, const Channel_t *pChannel)
+{
+    int32_t Drift;
+
+    if (pChannel->Count < 2) {
+        return;
+    }
+    Drift = (int32_t) (pChannel->Last - pChannel->First)
+            - (int32_t) ((pChannel->Count - 1) * pChannel->Period);
+    printf("  %-9s %-10s %2u ms  %6u passes  period %2u..%2u ms  jitter %5.2f ms rms"
+            "  drift %+6d ms\n", Pass, pChannel->Name, pChannel->Period,
+            pChannel->Count, pChannel->MinPeriod, pChannel->MaxPeriod,
+            sqrt(pChannel->SumSq / (pChannel->Count - 1)), Drift);
+}
+
+static uint8_t PostPending(ES_Event ThisEvent)
+{
+    uint8_t i;
+
+    if ((ThisEvent.EventType != ES_TIMEOUT) || (NumPending == MAX_PENDING)) {
+        return TRUE;
+    }
+    for (i = 0; i < NUM_CHANNELS; i++) {
+        if (TimerNums[i] == ThisEvent.EventParam) {
+            Pending[NumPending++] = i;
+        }
+    }
+    return TRUE;
+}
+
+static void RunTimers(const char *Pass, uint8_t UseRearm, uint32_t RunMs)
+{
+    uint32_t Now;
+    uint8_t i;
+
+    ES_Timer_Init();
+    for (i = 0; i < NUM_CHANNELS; i++) {
+        ResetChannel(&Channels[i]);
+    }
+    RandomState = RANDOM_SEED;
+    Busy = 0;
+    NumPending = 0;
+    Rearm = UseRearm;
+    for (i = 0; i < NUM_CHANNELS; i++) {
+        ES_Timer_Alloc(PostPending, &TimerNums[i]);
+        if (Rearm) {
+            ES_Timer_InitTimer(TimerNums[i], Channels[i].Period);
+        } else {
+            ES_Timer_InitPeriodic(TimerNums[i], Channels[i].Period, 0);
+        }
+    }
+    while (ES_Timer_GetTime() < RunMs) {
+        ES_Timer_Tick();
+        Now = ES_Timer_GetTime();
+        if (LoopIsFree()) {
+            for (i = 0; i < NumPending; i++) {
+                Acquired(&Channels[Pending[i]], Now);
+                if (Rearm) {
+                    ES_Timer_InitTimer(TimerNums[Pending[i]], Channels[Pending[i]].Period);
+                }
+            }
+            NumPending = 0;
+        }
+    }
+    for (i = 0; i < NUM_CHANNELS; i++) {
+        PrintChannel(Pass, &Channels[i]);
+    }
+}
+
+static void RunRobot(const char *Pass, uint32_t RunMs)
+{
+    uint32_t Reads = 0, Now;
+
+    ResetChannel(&SensorTick);
+    RandomState = RANDOM_SEED;
+    Busy = 0;
+    Sim_Init();
+    while (ES_Timer_GetTime() < RunMs) {
+        Sim_Tick();
+        if (!LoopIsFree()) {
+            continue;
+        }
+        Sim_Drain();
+        Now = ES_Timer_GetTime();
+        // RobotSensors reads the bumpers once a tick
+        for (; Reads < SimStats.BumperReads; Reads++) {
+            Acquired(&SensorTick, Now);
+        }
+    }
+    PrintChannel(Pass, &SensorTick);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunMs = DEFAULT_RUN_MS;
+
+    if (argc > 1) {
+        RunMs = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+
+    printf("bench_periodic: %u ms per pass, main loop busy 1-%d ms after 1 drain in %d\n",
+            RunMs, MAX_BUSY_MS, BUSY_ODDS);
+    RunTimers("re-arm", TRUE, RunMs);
+    RunTimers("periodic", FALSE, RunMs);
+    RunRobot("robot", RunMs);
+    return 0;
+}
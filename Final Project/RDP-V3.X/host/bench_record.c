@@ -0,0 +1,226 @@
+/*
+ * File: bench_record.c
+ *
+ * Test for the flight recorder. The robot is run in virtual time with the
+ * recorder on from startup and a tick hook playing a field at it: noisy
+ * ambient light under the tape sensors with tape going by at random, the
+ * beacon coming and going, the track wire rising and falling and the
+ * bumpers hit now and then. What the recorder sends out of the UART is
+ * collected as the robot would send it, and reported as:
+ *
+ *   records, bytes     what went through the ring, and bytes a record
+ *   rate               bytes a second, against what a 115200 baud UART
+ *                      carries
+ *   high-water         most bytes the ring held before a drain
+ *   dropped            records the ring had no room for
+ *
+ * then the cost of a record, on the host and on the PIC32 cost model below,
+ * is timed on REC_AD records of a noisy input, the common record.
+ *
+ * Cost model (PIC32MX M4K at 80 MHz, as bench_filter has it): 1 cycle per
+ * ALU op, load and store, 2 per taken branch, jump or call counting its
+ * delay slot. By hand from Recorder_AD(): the call and the Recording test 6,
+ * the pin number and difference 7, Begin() with its room, gap and time
+ * checks and the ES_Timer_GetTime() call 24, the tag 5, the zigzag 3, each
+ * varint byte 7, and storing the sample, Head and the count 6.
+ *
+ * Writes the recording to the file named on the command line, if there is
+ * one, for host/replay. Fails if a record is dropped or the recording needs
+ * more than the UART carries.
+ *
+ * usage: bench_record [recording]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "Recorder.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define RUN_MS 60000
+#define RANDOM_SEED 118
+#define UART_BYTES_PER_S (115200 / 10) // 8N1
+
+// the field
+#define FLOOR_READING 500 // tape sensors over the floor
+#define TAPE_LOW 150 // and over tape, where the right one reads high
+#define TAPE_HIGH 850
+#define NOISE 8
+#define MIN_TAPE_MS 60
+#define MAX_TAPE_MS 300
+#define MIN_FLOOR_MS 200
+#define MAX_FLOOR_MS 3000
+#define BEACON_HEARD 150 // the beacon board's output, low while it hears it
+#define BEACON_QUIET 800
+#define BEACON_CHANGE 1 // chance in 1000 each ms
+#define TRACK_LOW 400
+#define TRACK_HIGH 950
+#define TRACK_CHANGE 1
+#define BUMP_CHANGE 2
+
+#define TIMED_RECORDS 4000000
+#define CPU_MHZ 80
+#define CYCLES_ONE_BYTE 51 // REC_AD with a one-byte varint
+#define VARINT_BYTE_CYCLES 7
+
+#define NUM_TAPES (sizeof (TapePins) / sizeof (TapePins[0]))
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const unsigned int TapePins[] = {AD_PORTV6, AD_PORTV4, AD_PORTV3};
+static const uint16_t TapeReadings[] = {TAPE_LOW, TAPE_HIGH, TAPE_LOW};
+static const unsigned int TrackPins[] = {AD_PORTW7, AD_PORTW8};
+
+static uint32_t RandomState = RANDOM_SEED;
+static uint32_t TapeEnd[NUM_TAPES];
+static uint8_t OnTape[NUM_TAPES];
+static uint16_t Track = TRACK_LOW;
+
+static uint8_t *Sent;
+static uint32_t SentSize;
+
+static volatile uint16_t Sink; // keeps the timed loop from being optimized out
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static int32_t Between(int32_t Low, int32_t High)
+{
+    return Low + (int32_t) (NextRandom() % (uint32_t) (High - Low + 1));
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void Field(uint32_t Now)
+{
+    uint8_t i;
+
+    for (i = 0; i < NUM_TAPES; i++) {
+        if (Now >= TapeEnd[i]) {
+            OnTape[i] = !OnTape[i];
+            TapeEnd[i] = Now + (OnTape[i] ? Between(MIN_TAPE_MS, MAX_TAPE_MS)
+                    : Between(MIN_FLOOR_MS, MAX_FLOOR_MS));
+        }
+        Sim_SetADPin(TapePins[i], (OnTape[i] ? TapeReadings[i] : FLOOR_READING)
+                + Between(-NOISE, NOISE));
+    }
+    if (Between(0, 999) < BEACON_CHANGE) {
+        Sim_SetADPin(AD_PORTW6, Between(0, 1) ? BEACON_HEARD : BEACON_QUIET);
+    }
+    if (Between(0, 999) < TRACK_CHANGE) {
+        Track = (Track == TRACK_LOW) ? TRACK_HIGH : TRACK_LOW;
+    }
+    for (i = 0; i < 2; i++) {
+        Sim_SetADPin(TrackPins[i], Track + Between(-NOISE, NOISE));
+    }
+    if (Between(0, 999) < BUMP_CHANGE) {
+        Sim_SetBumpers(Between(0, FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+static void Collect(char ch)
+{
+    Sent[SentSize++] = (uint8_t) ch;
+}
+
+static void RunCost(void)
+{
+    uint8_t Buffer[RECORDER_SIZE];
+    uint64_t Start;
+    uint32_t n;
+    uint16_t Sample = FLOOR_READING;
+
+    Recorder_Start();
+    Start = CpuNs();
+    for (n = 0; n < TIMED_RECORDS; n++) {
+        Sample = FLOOR_READING + (n * 7 & 0xF);
+        Recorder_AD(AD_PORTV4, Sample);
+        if ((n & 0xFF) == 0xFF) {
+            Sink = Recorder_Read(Buffer, sizeof (Buffer));
+        }
+    }
+    Start = CpuNs() - Start;
+    Recorder_Stop();
+    printf("  REC_AD     %5.1f ns per record on the host  %u-%u cycles (%4.2f-%4.2f us) on the"
+            " PIC32\n", (double) Start / TIMED_RECORDS, CYCLES_ONE_BYTE,
+            CYCLES_ONE_BYTE + VARINT_BYTE_CYCLES, (double) CYCLES_ONE_BYTE / CPU_MHZ,
+            (double) (CYCLES_ONE_BYTE + VARINT_BYTE_CYCLES) / CPU_MHZ);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    RecorderStats_t Stats;
+    FILE *pFile;
+    double Rate;
+    uint8_t Failed;
+
+    Sent = malloc(RUN_MS * 64);
+    SentSize = 0;
+    // as RECORD_FIELD_RUN does it, from before the services start
+    Recorder_Start();
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_record: init failed\n");
+        return 1;
+    }
+    Sim_SetSerialSink(Collect);
+    Sim_SetTickHook(Field);
+    Sim_RunFor(RUN_MS);
+    Sim_SetTickHook((SimTickHook_t) 0);
+    Recorder_Stop();
+    SentSize += Recorder_Read(&Sent[SentSize], RECORDER_SIZE);
+    Sim_SetSerialSink((SimSerialSink_t) 0);
+    Recorder_GetStats(&Stats);
+
+    Rate = (double) Stats.Bytes * 1000 / RUN_MS;
+    Failed = (Stats.Dropped != 0) || (Rate > UART_BYTES_PER_S) || (SentSize != Stats.Bytes);
+    printf("bench_record: %u s of field run recorded\n", RUN_MS / 1000);
+    printf("  %u records, %u bytes (%.2f a record), %.0f bytes/s (%.0f%% of 115200 baud),"
+            " high-water %u/%u, dropped %u%s\n", Stats.Records, Stats.Bytes,
+            (double) Stats.Bytes / Stats.Records, Rate, 100 * Rate / UART_BYTES_PER_S,
+            Stats.HighWater, RECORDER_SIZE, Stats.Dropped, Failed ? "  FAILED" : "");
+    RunCost();
+
+    if (argc > 1) {
+        pFile = fopen(argv[1], "wb");
+        if ((pFile == NULL) || (fwrite(Sent, 1, SentSize, pFile) != SentSize)) {
+            fprintf(stderr, "bench_record: cannot write %s\n", argv[1]);
+            return 1;
+        }
+        fclose(pFile);
+    }
+    return Failed;
+}
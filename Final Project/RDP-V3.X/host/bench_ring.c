@@ -0,0 +1,231 @@
+/*
+ * File: bench_ring.c
+ *
+ * Two-thread stress test for the ES_Ring ISR post path. One thread plays the
+ * timer ISR and posts sequence-numbered events, the other plays the run loop
+ * and drains them. Two passes are made:
+ *
+ *   lossless - the producer retries when the ring is full, the consumer
+ *              checks every sequence number arrives exactly once, in order
+ *   isr      - the producer never waits on a full ring (an ISR can't) but
+ *              posts at most once every ISR_PERIOD_NS, as a timer interrupt
+ *              would; the consumer checks ordering, that received +
+ *              Overflows == posted, and that at least MIN_DELIVERED_PCT of
+ *              the posts got through
+ *
+ * With two or more CPUs the threads are pinned one to a CPU, so Head and
+ * Tail really are written at the same time. On one CPU they only interleave
+ * where the scheduler preempts them, which the pass says in its line.
+ *
+ * Afterwards the robot is run for a while in virtual time and the per-service
+ * queue/ring counters are printed.
+ *
+ * usage: bench_ring [events per pass] [ring size]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#define _GNU_SOURCE // pthread_attr_setaffinity_np()
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Ring.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_EVENTS 2000000
+#define DEFAULT_RING_SIZE 16
+#define MAX_RING_SIZE 4096
+#define SIM_RUN_MS 60000
+
+// the isr pass: one post per period, 1 MHz, faster than any of the robot's
+// interrupts; the consumer keeps up with it unless the ring logic is wrong
+#define ISR_PERIOD_NS 1000
+#define ISR_EVENTS_DIVIDE 10 // of the events per pass, 0.2 s of posts
+#define MIN_DELIVERED_PCT 99
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    ES_Ring_t Ring;
+    uint32_t NumEvents;
+    uint8_t Lossless;
+    volatile uint8_t Done;
+    uint32_t Received;
+    uint32_t OrderErrors;
+} RingTest_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static ES_Event RingMem[MAX_RING_SIZE];
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void *Producer(void *Arg)
+{
+    RingTest_t *pTest = Arg;
+    ES_Event ThisEvent = {ES_TIMEOUT, 0};
+    uint64_t Now, Next = NowNs();
+    uint32_t i;
+
+    // 32-bit sequence number split across the type and param fields
+    for (i = 0; i < pTest->NumEvents; i++) {
+        if (!pTest->Lossless) {
+            // wait for the next interrupt; one that is late fires once, not
+            // once for every period it missed
+            while ((Now = NowNs()) < Next) {
+                sched_yield();
+            }
+            Next = ((Now - Next < ISR_PERIOD_NS) ? Next : Now) + ISR_PERIOD_NS;
+        }
+        ThisEvent.EventType = (ES_EventTyp_t) (i >> 16);
+        ThisEvent.EventParam = (uint16_t) i;
+        // yield rather than spin so the test also finishes on a single core
+        while ((ES_Ring_Put(&pTest->Ring, ThisEvent) == FALSE) && pTest->Lossless) {
+            sched_yield();
+        }
+    }
+    __atomic_store_n(&pTest->Done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void *Consumer(void *Arg)
+{
+    RingTest_t *pTest = Arg;
+    ES_Event ThisEvent;
+    uint32_t Seq, Expected = 0;
+
+    while (1) {
+        if (ES_Ring_Get(&pTest->Ring, &ThisEvent) == TRUE) {
+            // lossless: exact sequence; isr: gaps allowed, never backwards
+            Seq = ((uint32_t) ThisEvent.EventType << 16) | ThisEvent.EventParam;
+            if (pTest->Lossless ? (Seq != Expected) : (Seq < Expected)) {
+                pTest->OrderErrors++;
+            }
+            Expected = Seq + 1;
+            pTest->Received++;
+        } else if (__atomic_load_n(&pTest->Done, __ATOMIC_ACQUIRE)
+                && ES_Ring_IsEmpty(&pTest->Ring)) {
+            break;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static int RunPass(const char *Name, uint32_t NumEvents, uint16_t RingSize, uint8_t Lossless)
+{
+    RingTest_t Test = {.NumEvents = NumEvents, .Lossless = Lossless};
+    pthread_attr_t ProdAttr, ConsAttr;
+    pthread_t Prod, Cons;
+    cpu_set_t Cpus;
+    uint64_t Start, Elapsed;
+    uint8_t Pinned = (sysconf(_SC_NPROCESSORS_ONLN) >= 2);
+    int Failed;
+
+    pthread_attr_init(&ProdAttr);
+    pthread_attr_init(&ConsAttr);
+    if (Pinned) {
+        CPU_ZERO(&Cpus);
+        CPU_SET(0, &Cpus);
+        pthread_attr_setaffinity_np(&ConsAttr, sizeof (Cpus), &Cpus);
+        CPU_ZERO(&Cpus);
+        CPU_SET(1, &Cpus);
+        pthread_attr_setaffinity_np(&ProdAttr, sizeof (Cpus), &Cpus);
+    }
+    ES_Ring_Init(&Test.Ring, RingMem, RingSize);
+    Start = NowNs();
+    pthread_create(&Cons, &ConsAttr, Consumer, &Test);
+    pthread_create(&Prod, &ProdAttr, Producer, &Test);
+    pthread_join(Prod, NULL);
+    pthread_join(Cons, NULL);
+    Elapsed = NowNs() - Start;
+    pthread_attr_destroy(&ProdAttr);
+    pthread_attr_destroy(&ConsAttr);
+
+    // in the lossless pass Overflows counts the producer's retries
+    Failed = (Test.OrderErrors != 0) || (Lossless ? (Test.Received != NumEvents)
+            : ((Test.Received + Test.Ring.Overflows != NumEvents)
+            || ((uint64_t) Test.Received * 100 < (uint64_t) NumEvents * MIN_DELIVERED_PCT)));
+    printf("  %-8s %u posts in %.3f s, %.2f Mposts/s, received %u (%.2f%%), %s %u,"
+            " high-water %u/%u, order errors %u, %s%s\n",
+            Name, NumEvents, Elapsed / 1e9, NumEvents / (Elapsed / 1e3),
+            Test.Received, 100.0 * Test.Received / NumEvents,
+            Lossless ? "full retries" : "dropped",
+            Test.Ring.Overflows, Test.Ring.HighWater, RingSize, Test.OrderErrors,
+            Pinned ? "threads on CPUs 0 and 1" : "threads share the one CPU",
+            Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t NumEvents = DEFAULT_EVENTS;
+    uint32_t RingSize = DEFAULT_RING_SIZE;
+    ES_QueueStats_t Stats;
+    int Failed = 0;
+    uint8_t i;
+
+    if (argc > 1) {
+        NumEvents = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        RingSize = (uint32_t) strtoul(argv[2], NULL, 0);
+    }
+    if ((RingSize == 0) || (RingSize > MAX_RING_SIZE) || (RingSize & (RingSize - 1))) {
+        fprintf(stderr, "bench_ring: ring size must be a power of two <= %d\n", MAX_RING_SIZE);
+        return 1;
+    }
+
+    printf("bench_ring: SPSC ring, %u slots, producer and consumer threads\n", RingSize);
+    Failed |= RunPass("lossless", NumEvents, RingSize, TRUE);
+    Failed |= RunPass("isr", NumEvents / ISR_EVENTS_DIVIDE, RingSize, FALSE);
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_ring: init failed\n");
+        return 1;
+    }
+    Sim_RunFor(SIM_RUN_MS);
+    printf("  robot, %d ms virtual time (queue depth / ring depth %d):\n",
+            SIM_RUN_MS, ES_ISR_RING_SIZE);
+    for (i = 0; i < NUM_SERVICES; i++) {
+        ES_GetQueueStats(i, &Stats);
+        printf("    service %u  queue high-water %u overflows %u"
+                "  ring high-water %u overflows %u\n", i,
+                Stats.QueueHighWater, Stats.QueueOverflows,
+                Stats.RingHighWater, Stats.RingOverflows);
+    }
+    return Failed;
+}
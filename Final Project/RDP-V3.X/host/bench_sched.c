@@ -0,0 +1,143 @@
+/*
+ * File: bench_sched.c
+ *
+ * Scheduling-cost benchmark for the ES_Framework ready bitmap. Built once
+ * per service count (see SCHED_SIZES in the Makefile) against the
+ * do-nothing services in sched_bench/, so only framework overhead is timed:
+ *
+ *   post+step  one ES_PostToService() plus the ES_RunStep() that consumes
+ *              it, to the lowest (1) and highest (N-1) priority service
+ *   isr        the same through the ISR ring
+ *   pick       choosing the highest ready service on its own, with the old
+ *              linear scan and with clz, for the scan's worst case
+ *
+ * usage: bench_sched_<N> [iterations]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "SchedBench.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_ITERATIONS 2000000
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t Dispatches;
+static volatile uint32_t Sink;
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static double TimePostStep(uint8_t WhichService, uint8_t FromISR, uint32_t Iterations)
+{
+    ES_Event ThisEvent = {BENCH_EVENT, 0};
+    uint64_t Start = NowNs();
+    uint32_t i;
+
+    for (i = 0; i < Iterations; i++) {
+        if (FromISR) {
+            ES_ISR_Enter();
+        }
+        ES_PostToService(WhichService, ThisEvent);
+        if (FromISR) {
+            ES_ISR_Exit();
+        }
+        ES_RunStep();
+    }
+    return (double) (NowNs() - Start) / Iterations;
+}
+
+/* the priority scan ES_RunStep used before the ready bitmap */
+static uint8_t LinearPick(uint32_t Ready)
+{
+    int8_t HighestPrior;
+
+    for (HighestPrior = NUM_SERVICES - 1; HighestPrior > 0; HighestPrior--) {
+        if (Ready & ((uint32_t) 1 << HighestPrior)) {
+            break;
+        }
+    }
+    return HighestPrior;
+}
+
+static double TimePick(uint8_t UseClz, uint32_t Iterations)
+{
+    uint64_t Start = NowNs();
+    uint32_t i;
+
+    for (i = 0; i < Iterations; i++) {
+        // worst case for the scan: only service 1 ready
+        Sink = (uint32_t) 2 | (Sink & 1);
+        Sink = UseClz ? ES_HighestBit(Sink) : LinearPick(Sink);
+    }
+    return (double) (NowNs() - Start) / Iterations;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+uint8_t InitSchedBench(uint8_t Priority)
+{
+    return TRUE;
+}
+
+ES_Event RunSchedBench(ES_Event ThisEvent)
+{
+    Dispatches++;
+    return NO_EVENT;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t Iterations = DEFAULT_ITERATIONS;
+
+    if (argc > 1) {
+        Iterations = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (ES_Initialize() != Success) {
+        fprintf(stderr, "bench_sched: init failed\n");
+        return 1;
+    }
+
+    printf("bench_sched: %2d services  post+step low %5.1f ns  high %5.1f ns"
+            "  isr %5.1f ns  pick linear %5.2f ns  clz %5.2f ns\n",
+            NUM_SERVICES,
+            TimePostStep(1, FALSE, Iterations),
+            TimePostStep(NUM_SERVICES - 1, FALSE, Iterations),
+            TimePostStep(1, TRUE, Iterations),
+            TimePick(FALSE, Iterations),
+            TimePick(TRUE, Iterations));
+    if (Dispatches != 3 * Iterations) {
+        fprintf(stderr, "bench_sched: %u dispatches, expected %u\n",
+                Dispatches, 3 * Iterations);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * File: bench_sequencer.c
+ *
+ * Event latency around the Destroy fire. The robot is run in virtual time
+ * with the bumpers going at random, and is walked round the attack by
+ * posting RobotHSM what each state waits for (the beacon in Lookout and
+ * Search, the wall in Pursue, the cannon tape coming and going in Destroy);
+ * the timers do the rest, through the fire and the escape and back to
+ * Lookout. The events of every ms are run as the robot would, one
+ * run-to-completion step after another, and each event's latency is the
+ * wall-clock time from the end of the ms's interrupts to the start of the
+ * step that runs it, so an event queued behind a long step waits for all of
+ * it. Reported are the p50, p99 and worst latency, the longest step, and
+ * the virtual ms from the end of the shot to Ball_deposit.
+ *
+ * "make latency" builds it a second time as bench_sequencer_ref, against
+ * RobotHSM and SubHSM_Destroy from before the Sequencer took their waits
+ * over (SEQ_REF), unoptimized as MPLAB builds them, so the busy-wait loops
+ * are still there to time.
+ *
+ * Fails if the robot never fires or a post is dropped.
+ *
+ * usage: bench_sequencer [virtual seconds]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BOARD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "RobotHSM.h"
+#include "SubHSM_Destroy.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_RUN_S 600
+#define RANDOM_SEED 118
+#define BUMP_ODDS 200 // the bumpers change one ms in this many
+#define MAX_EVENTS_PER_MS 16
+#define SHOOT_MS 4250 // SubHSM_Destroy's SHOOT_TIMER
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+/* what the driver posts in a state, and how long after entering it */
+typedef struct {
+    const char *Machine;
+    const char *State;
+    ES_EventTyp_t EventType;
+    uint16_t MinMs;
+    uint16_t MaxMs;
+} Cue_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const Cue_t Cues[] = {
+    {"RobotHSM", "Lookout", Beacon_found, 300, 1500},
+    {"RobotHSM", "Search", Beacon_found, 300, 1500},
+    {"RobotHSM", "Pursue", Wall_found, 500, 2000},
+    {"Destroy", "Forward", CannonTape, 100, 800},
+    {"Destroy", "Lineup", NoCannonTape, 50, 300},
+};
+
+static uint32_t RandomState = RANDOM_SEED;
+static const Cue_t *pCue; // waiting to be posted
+static uint32_t CueTime;
+static const char *LastState; // RobotHSM's, or Destroy's while in Destroy
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static const char *CurrentState(void)
+{
+    const char *State = HSM_GetStateName(&RobotHSMMachine);
+
+    return strcmp(State, "Destroy") ? State : HSM_GetStateName(&SubHSM_DestroyMachine);
+}
+
+/* the ms starting at Now: bumpers at random, and the cue of the state */
+static void Drive(uint32_t Now)
+{
+    const char *State = CurrentState();
+    ES_Event ThisEvent;
+    uint8_t i;
+
+    if ((NextRandom() % BUMP_ODDS) == 0) {
+        Sim_SetBumpers(NextRandom() & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+    if (State != LastState) {
+        LastState = State;
+        pCue = NULL;
+        for (i = 0; i < sizeof (Cues) / sizeof (Cues[0]); i++) {
+            if (strcmp(State, Cues[i].State) == 0) {
+                pCue = &Cues[i];
+                CueTime = Now + pCue->MinMs + NextRandom() % (pCue->MaxMs - pCue->MinMs + 1);
+            }
+        }
+    }
+    if (pCue && (Now >= CueTime)) {
+        ThisEvent.EventType = pCue->EventType;
+        ThisEvent.EventParam = 0;
+        PostRobotHSM(ThisEvent);
+        pCue = NULL;
+    }
+}
+
+static int CompareU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t RunS = DEFAULT_RUN_S, Ms, NumWaits = 0, MaxWaits, MaxStepNs = 0;
+    uint32_t Fires = 0, FireEntered = 0, SpinDownMs = 0, Dropped;
+    uint32_t *Waits;
+    uint64_t TickEnd, StepStart, StepNs;
+    const char *State, *Before;
+    uint8_t Failed;
+
+    if (argc > 1) {
+        RunS = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    MaxWaits = RunS * 1000 * MAX_EVENTS_PER_MS;
+    Waits = malloc(MaxWaits * sizeof (uint32_t));
+    if ((RunS == 0) || (Waits == NULL) || (Sim_Init() != SUCCESS)) {
+        fprintf(stderr, "bench_sequencer: init failed\n");
+        return 1;
+    }
+    Sim_SetTickHook(Drive);
+    for (Ms = 0; Ms < RunS * 1000; Ms++) {
+        Before = CurrentState();
+        Sim_Tick();
+        TickEnd = NowNs();
+        for (;;) {
+            StepStart = NowNs();
+            if (ES_RunStep() != TRUE) {
+                break;
+            }
+            StepNs = NowNs() - StepStart;
+            if (StepNs > MaxStepNs) {
+                MaxStepNs = (uint32_t) StepNs;
+            }
+            if (NumWaits < MaxWaits) {
+                Waits[NumWaits++] = (uint32_t) (StepStart - TickEnd);
+            }
+        }
+        State = CurrentState();
+        if ((State != Before) && (strcmp(State, "Fire") == 0)) {
+            FireEntered = ES_Timer_GetTime();
+        } else if ((State != Before) && (strcmp(Before, "Fire") == 0)) {
+            Fires++;
+            SpinDownMs += ES_Timer_GetTime() - FireEntered - SHOOT_MS;
+        }
+    }
+    Sim_SetTickHook((SimTickHook_t) 0);
+    Dropped = ES_GetDroppedPosts();
+
+    qsort(Waits, NumWaits, sizeof (uint32_t), CompareU32);
+    printf("bench_sequencer: %u s, %u events, %u fires\n", RunS, NumWaits, Fires);
+    printf("  latency       p50 %.1f us  p99 %.1f us  worst %.1f us\n",
+            Waits[NumWaits / 2] / 1e3, Waits[(uint32_t) (NumWaits * 0.99)] / 1e3,
+            Waits[NumWaits - 1] / 1e3);
+    printf("  longest step  %.1f us\n", MaxStepNs / 1e3);
+    printf("  shot to Ball_deposit %.1f virtual ms\n", Fires ? (double) SpinDownMs / Fires : 0.0);
+    printf("  dropped posts %u\n", Dropped);
+    Failed = (Fires == 0) || Dropped;
+    if (Failed) {
+        printf("  FAILED\n");
+    }
+    free(Waits);
+    return Failed;
+}
@@ -0,0 +1,331 @@
+/*
+ * File: bench_snapshot.c
+ *
+ * Test for the SensorSnapshot store. A writer thread plays RobotSensors and
+ * publishes snapshots whose every field is worked out from its Time, as fast
+ * as it can, while reader threads play the services and read them back; a
+ * snapshot whose fields don't all agree with its Time is torn. Two passes:
+ *
+ *   plain    one shared struct, written and read field by field, the way a
+ *            service would read another's variables; shows the test finds
+ *            torn reads when there are any
+ *   double   SensorSnapshot_Publish() and SensorSnapshot_Read(): no read
+ *            may be torn or older than one the same reader had before
+ *
+ * Then RobotSensors is run in virtual time with inputs changing at random
+ * and every channel watched, and the snapshot read after every ms: it has to
+ * move on one tick at a time, carry the levels RobotHSM was given, and cost
+ * no AD_ReadADPin() calls past the one per pin per scan that ADAcquire takes.
+ * Last, the cost of a publish and of a read.
+ *
+ * usage: bench_snapshot [publishes per pass]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "Robot.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "RobotSensors.h"
+#include "SensorDelta.h"
+#include "SensorSnapshot.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_PUBLISHES 4000000
+#define NUM_READERS 2
+#define YIELD_ODDS 4096 // the writer lets the readers in after one publish in this many
+#define SIM_RUN_MS 60000
+#define SENSOR_TICK_MS 5
+#define TIMED_CALLS 10000000
+#define RANDOM_SEED 118
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    uint8_t Plain;
+    uint32_t Reads;
+    uint32_t Torn;
+    uint32_t Stale; // older than the reader's last
+    uint32_t Copies;
+    uint8_t MostCopies;
+} Reader_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t NumPublishes;
+static volatile uint8_t WriterDone;
+static volatile SensorSnapshot_t Shared; // the plain pass's store
+static uint32_t RandomState = RANDOM_SEED;
+static volatile uint16_t Sink; // keeps the timed loops from being optimized out
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint64_t CpuNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* snapshot n, every field from n */
+static void MakeSnapshot(uint32_t n, SensorSnapshot_t *pSnapshot)
+{
+    uint8_t i;
+
+    pSnapshot->Time = n;
+    for (i = 0; i < SNAPSHOT_ANALOG; i++) {
+        pSnapshot->Analog[i] = (uint16_t) (n * (i + 3));
+    }
+    pSnapshot->Beacon = (uint16_t) ((n >> 16) ^ n);
+    pSnapshot->Bumpers = (uint8_t) (n * 5);
+    pSnapshot->Levels = (uint8_t) (n >> 8);
+}
+
+static uint8_t IsWhole(const SensorSnapshot_t *pSnapshot)
+{
+    SensorSnapshot_t Expected;
+    uint8_t i;
+
+    MakeSnapshot(pSnapshot->Time, &Expected);
+    for (i = 0; i < SNAPSHOT_ANALOG; i++) {
+        if (pSnapshot->Analog[i] != Expected.Analog[i]) {
+            return FALSE;
+        }
+    }
+    return (pSnapshot->Beacon == Expected.Beacon)
+            && (pSnapshot->Bumpers == Expected.Bumpers) && (pSnapshot->Levels == Expected.Levels);
+}
+
+static void *Writer(void *Arg)
+{
+    SensorSnapshot_t Snapshot;
+    uint8_t Plain = *(uint8_t *) Arg;
+    uint32_t Seed = RANDOM_SEED, n, i;
+
+    for (n = 1; n <= NumPublishes; n++) {
+        MakeSnapshot(n, &Snapshot);
+        if (Plain) {
+            Shared.Time = Snapshot.Time;
+            for (i = 0; i < SNAPSHOT_ANALOG; i++) {
+                Shared.Analog[i] = Snapshot.Analog[i];
+            }
+            Shared.Beacon = Snapshot.Beacon;
+            Shared.Bumpers = Snapshot.Bumpers;
+            Shared.Levels = Snapshot.Levels;
+        } else {
+            SensorSnapshot_Publish(&Snapshot);
+        }
+        Seed = Seed * 1103515245 + 12345;
+        if (((Seed >> 16) % YIELD_ODDS) == 0) {
+            sched_yield();
+        }
+    }
+    WriterDone = TRUE;
+    return NULL;
+}
+
+static void *Read(void *Arg)
+{
+    Reader_t *pReader = Arg;
+    SensorSnapshot_t Snapshot;
+    uint32_t Last = 0, i;
+    uint8_t Copies;
+
+    while (!WriterDone) {
+        if (pReader->Plain) {
+            Snapshot.Time = Shared.Time;
+            for (i = 0; i < SNAPSHOT_ANALOG; i++) {
+                Snapshot.Analog[i] = Shared.Analog[i];
+            }
+            Snapshot.Beacon = Shared.Beacon;
+            Snapshot.Bumpers = Shared.Bumpers;
+            Snapshot.Levels = Shared.Levels;
+            Copies = 1;
+        } else if ((Copies = SensorSnapshot_Read(&Snapshot)) == 0) {
+            continue;
+        }
+        pReader->Reads++;
+        pReader->Copies += Copies;
+        if (Copies > pReader->MostCopies) {
+            pReader->MostCopies = Copies;
+        }
+        if (!IsWhole(&Snapshot)) {
+            pReader->Torn++;
+        } else if (Snapshot.Time < Last) {
+            pReader->Stale++;
+        } else {
+            Last = Snapshot.Time;
+        }
+    }
+    return NULL;
+}
+
+static int RunThreads(const char *Name, uint8_t Plain)
+{
+    pthread_t WriterThread, ReaderThreads[NUM_READERS];
+    Reader_t Readers[NUM_READERS] = {{0}}, Total = {0};
+    uint8_t Failed, i;
+
+    SensorSnapshot_Init();
+    Shared = (SensorSnapshot_t) {0};
+    WriterDone = FALSE;
+    for (i = 0; i < NUM_READERS; i++) {
+        Readers[i].Plain = Plain;
+        pthread_create(&ReaderThreads[i], NULL, Read, &Readers[i]);
+    }
+    pthread_create(&WriterThread, NULL, Writer, &Plain);
+    pthread_join(WriterThread, NULL);
+    for (i = 0; i < NUM_READERS; i++) {
+        pthread_join(ReaderThreads[i], NULL);
+        Total.Reads += Readers[i].Reads;
+        Total.Torn += Readers[i].Torn;
+        Total.Stale += Readers[i].Stale;
+        Total.Copies += Readers[i].Copies;
+        if (Readers[i].MostCopies > Total.MostCopies) {
+            Total.MostCopies = Readers[i].MostCopies;
+        }
+    }
+    Failed = !Plain && (Total.Torn || Total.Stale || (Total.Reads == 0));
+    printf("  %-7s %u published, %u read, %u torn, %u stale, %u copied again (most %u)%s\n",
+            Name, NumPublishes, Total.Reads, Total.Torn, Total.Stale,
+            Total.Copies - Total.Reads, Total.MostCopies, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+static void RandomInputs(uint32_t Now)
+{
+    static const unsigned int Pins[] = {
+        AD_PORTV6, AD_PORTV4, AD_PORTV3, AD_PORTW6, AD_PORTW7, AD_PORTW8
+    };
+
+    if ((NextRandom() % 8) == 0) {
+        Sim_SetADPin(Pins[NextRandom() % 6], NextRandom() % (AD_MAX_VALUE + 1));
+    }
+    if ((NextRandom() % 500) == 0) {
+        Sim_SetBumpers(NextRandom() & (FRONT_LEFT_BUMPER | FRONT_RIGHT_BUMPER | SIDE_BUMPER));
+    }
+}
+
+static int RunRobot(void)
+{
+    SensorSnapshot_t Snapshot;
+    uint32_t Ms, Ticks = 0, BadSteps = 0, BadLevels = 0, Last = 0, ScanReads;
+    uint8_t Failed, Unwatched, Resynced = 0, Differ;
+
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "bench_snapshot: init failed\n");
+        return 1;
+    }
+    Sim_SetTickHook(RandomInputs);
+    for (Ms = 0; Ms < SIM_RUN_MS; Ms++) {
+        Sim_Tick();
+        Sim_Drain();
+        // a state change RobotHSM took ahead of the tick can have left a
+        // group out of it; watched again, that group takes its levels
+        // without edges on its next tick, so from then its channels are not
+        // held to RobotHSM's until the two agree again
+        Unwatched = ~RobotSensors_GetWatched();
+        RobotSensors_Attend(SENSOR_ALL, SENSOR_ALL);
+        if ((SensorSnapshot_Read(&Snapshot) == 0) || (Snapshot.Time == Last)) {
+            Resynced |= Unwatched;
+            continue;
+        }
+        if (Ticks++ && (Snapshot.Time - Last != SENSOR_TICK_MS)) {
+            BadSteps++;
+        }
+        // a settled bumper change can be posted after the tick
+        Differ = (Snapshot.Levels ^ SensorDelta_GetLevels())
+                & ~(SENSOR_RIGHT_BUMP | SENSOR_LEFT_BUMP | SENSOR_SIDE_BUMP);
+        Resynced &= Differ;
+        if (Differ & ~Resynced) {
+            BadLevels++;
+        }
+        Resynced |= Unwatched;
+        Last = Snapshot.Time;
+    }
+    Sim_SetTickHook((SimTickHook_t) 0);
+    ScanReads = SIM_RUN_MS * __builtin_popcount(AD_ActivePins());
+    Failed = BadSteps || BadLevels || (SimStats.ADReads != ScanReads)
+            || (Ticks != SIM_RUN_MS / SENSOR_TICK_MS);
+    printf("  robot   %u snapshots in %u ms, %u not one tick on, %u with other levels,"
+            " %u AD_ReadADPin() calls for %u%s\n", Ticks, SIM_RUN_MS, BadSteps, BadLevels,
+            SimStats.ADReads, ScanReads, Failed ? "  FAILED" : "");
+    return Failed;
+}
+
+static void RunCost(void)
+{
+    SensorSnapshot_t Snapshot;
+    uint64_t Start, PublishNs, ReadNs;
+    uint32_t n;
+
+    SensorSnapshot_Init();
+    MakeSnapshot(1, &Snapshot);
+    Start = CpuNs();
+    for (n = 0; n < TIMED_CALLS; n++) {
+        Snapshot.Time = n;
+        SensorSnapshot_Publish(&Snapshot);
+    }
+    PublishNs = CpuNs() - Start;
+    Start = CpuNs();
+    for (n = 0; n < TIMED_CALLS; n++) {
+        SensorSnapshot_Read(&Snapshot);
+        Sink ^= Snapshot.Analog[0];
+    }
+    ReadNs = CpuNs() - Start;
+    printf("  cost    %.1f ns a publish, %.1f ns a read, %u-byte snapshot\n",
+            (double) PublishNs / TIMED_CALLS, (double) ReadNs / TIMED_CALLS,
+            (unsigned) sizeof (SensorSnapshot_t));
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    int Failed = 0;
+
+    NumPublishes = DEFAULT_PUBLISHES;
+    if (argc > 1) {
+        NumPublishes = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (NumPublishes == 0) {
+        fprintf(stderr, "bench_snapshot: bad publish count\n");
+        return 1;
+    }
+    printf("bench_snapshot: %u readers against one writer\n", NUM_READERS);
+    Failed |= RunThreads("plain", TRUE);
+    Failed |= RunThreads("double", FALSE);
+    Failed |= RunRobot();
+    RunCost();
+    return Failed;
+}
@@ -0,0 +1,294 @@
+/*
+ * File: bench_timers.c
+ *
+ * Tick-cost benchmark for the ES_Timers timing wheel. Built with room for
+ * 256 timers from ES_Timer_Alloc() (see the Makefile), none of the robot's
+ * services are started; every timer posts to a counting response function
+ * that re-arms it with its own period, so the number armed stays constant.
+ *
+ *   check  random InitTimer/StopTimer/SetTimer traffic on every handle,
+ *          with timeouts from 1 ms to well past the wheel's top level, each
+ *          checked to fire exactly once on the tick it is due
+ *   tick   ES_Timer_Tick() with 10, 64 and 256 armed timers, periods
+ *          5 ms to 2 s, against the sixteen-slot down-counter scan it
+ *          replaced widened to the same number of slots
+ *
+ * usage: bench_timers [ticks per measurement]
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define DEFAULT_TICKS 1000000
+#define CHECK_TICKS 2000000
+#define MAX_ARMED (ES_NUM_TIMERS - ES_NUM_FIXED_TIMERS)
+#define MIN_PERIOD 5
+#define MAX_PERIOD 2000
+#define CLOCK_CAL_LOOPS 100000
+#define RANDOM_SEED 118
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static uint32_t RandomState = RANDOM_SEED;
+static uint32_t Period[ES_NUM_TIMERS];
+static uint32_t Due[ES_NUM_TIMERS]; // expected expiry in the check pass, 0 if stopped
+static uint8_t Rearm;
+static uint32_t Fired;
+static uint32_t Errors;
+
+// the down-counter scan, widened to MAX_ARMED slots
+static uint32_t ScanCounters[MAX_ARMED];
+static uint8_t ScanActive[MAX_ARMED];
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    RandomState = RandomState * 1103515245 + 12345;
+    return RandomState >> 16;
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint32_t ClockOverheadNs(void)
+{
+    uint64_t Start = NowNs();
+    uint32_t i;
+
+    for (i = 0; i < CLOCK_CAL_LOOPS; i++) {
+        NowNs();
+    }
+    return (uint32_t) ((NowNs() - Start) / CLOCK_CAL_LOOPS);
+}
+
+static int CompareU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* per-mille point of sorted samples, less the clock overhead */
+static uint32_t Percentile(const uint32_t *Samples, uint32_t Count, uint16_t PerMille,
+        uint32_t Overhead)
+{
+    uint32_t Sample = Samples[(uint64_t) Count * PerMille / 1000];
+
+    return (Sample > Overhead) ? Sample - Overhead : 0;
+}
+
+static uint8_t PostTimeout(ES_Event ThisEvent)
+{
+    if (ThisEvent.EventType != ES_TIMEOUT) {
+        return TRUE;
+    }
+    Fired++;
+    if (Rearm) {
+        ES_Timer_InitTimer(ThisEvent.EventParam, Period[ThisEvent.EventParam]);
+    } else {
+        if (Due[ThisEvent.EventParam] != ES_Timer_GetTime()) {
+            Errors++;
+        }
+        Due[ThisEvent.EventParam] = 0;
+    }
+    return TRUE;
+}
+
+static uint8_t ScanPost(uint16_t Num)
+{
+    Fired++;
+    ScanCounters[Num] = Period[Num + ES_NUM_FIXED_TIMERS];
+    ScanActive[Num] = TRUE;
+    return TRUE;
+}
+
+/* the old ES_Timer_Tick() loop over NumSlots counters */
+static void ScanTick(uint16_t NumSlots)
+{
+    uint16_t i;
+
+    for (i = 0; i < NumSlots; i++) {
+        if (ScanActive[i] && (--ScanCounters[i] == 0)) {
+            ScanActive[i] = FALSE;
+            ScanPost(i);
+        }
+    }
+}
+
+static uint16_t AllocAll(void)
+{
+    uint16_t Num, Count = 0;
+
+    ES_Timer_Init();
+    while (ES_Timer_Alloc(PostTimeout, &Num) == ES_Timer_OK) {
+        Count++;
+    }
+    return Count;
+}
+
+static int RunCheck(void)
+{
+    uint32_t Tick, Time, Now, Missed = 0;
+    uint16_t Num, Count = AllocAll();
+
+    Rearm = FALSE;
+    Fired = 0;
+    Errors = 0;
+    for (Num = 0; Num < ES_NUM_TIMERS; Num++) {
+        Due[Num] = 0;
+    }
+    for (Tick = 0; Tick < CHECK_TICKS; Tick++) {
+        Now = ES_Timer_GetTime();
+        Num = ES_NUM_FIXED_TIMERS + NextRandom() % Count;
+        switch (NextRandom() % 8) {
+        case 0:
+            ES_Timer_StopTimer(Num);
+            Due[Num] = 0;
+            break;
+        case 1:
+            // far past the top level now and then
+            Time = 1 + ((NextRandom() << 8) | (NextRandom() & 0xFF)) % 200000;
+            ES_Timer_InitTimer(Num, Time);
+            Due[Num] = Now + Time;
+            break;
+        case 2:
+            if (Due[Num]) {
+                Time = 1 + NextRandom() % 3000;
+                ES_Timer_SetTimer(Num, Time);
+                Due[Num] = Now + Time;
+            }
+            break;
+        default:
+            Time = 1 + NextRandom() % 1500;
+            ES_Timer_InitTimer(Num, Time);
+            Due[Num] = Now + Time;
+            break;
+        }
+        ES_Timer_Tick();
+    }
+    Now = ES_Timer_GetTime();
+    for (Num = 0; Num < ES_NUM_TIMERS; Num++) {
+        if (Due[Num] && (Due[Num] <= Now)) {
+            Missed++;
+        }
+    }
+    printf("  check  %u ticks, %u handles, %u timeouts, %u early/late, %u missed%s\n",
+            CHECK_TICKS, Count, Fired, Errors, Missed,
+            (Errors || Missed) ? "  FAILED" : "");
+    return (Errors != 0) || (Missed != 0);
+}
+
+static void ArmTimers(uint16_t NumArmed)
+{
+    uint16_t i, Num;
+
+    AllocAll();
+    Rearm = TRUE;
+    for (i = 0; i < MAX_ARMED; i++) {
+        Num = ES_NUM_FIXED_TIMERS + i;
+        Period[Num] = MIN_PERIOD + NextRandom() % (MAX_PERIOD - MIN_PERIOD + 1);
+        ScanActive[i] = (i < NumArmed);
+        ScanCounters[i] = Period[Num];
+        if (i < NumArmed) {
+            ES_Timer_InitTimer(Num, Period[Num]);
+        }
+    }
+}
+
+static void TimeTicks(uint16_t NumArmed, uint32_t Ticks, uint32_t *Samples, uint32_t Overhead)
+{
+    uint64_t Start, Wheel, Scan;
+    uint32_t i, WheelFired, ScanFired;
+    uint16_t ScanSlots = (NumArmed > ES_NUM_FIXED_TIMERS) ? NumArmed : ES_NUM_FIXED_TIMERS;
+
+    ArmTimers(NumArmed);
+    Fired = 0;
+    Start = NowNs();
+    for (i = 0; i < Ticks; i++) {
+        ES_Timer_Tick();
+    }
+    Wheel = NowNs() - Start;
+    WheelFired = Fired;
+
+    for (i = 0; i < Ticks; i++) {
+        Start = NowNs();
+        ES_Timer_Tick();
+        Samples[i] = (uint32_t) (NowNs() - Start);
+    }
+    qsort(Samples, Ticks, sizeof (Samples[0]), CompareU32);
+
+    Fired = 0;
+    Start = NowNs();
+    for (i = 0; i < Ticks; i++) {
+        ScanTick(ScanSlots);
+    }
+    Scan = NowNs() - Start;
+    ScanFired = Fired;
+
+    // the cascades come every 32 ticks, so p99.9 is the tick that moves timers
+    printf("  tick   %3u armed  wheel mean %6.1f ns  p99 %5u ns  p99.9 %5u ns"
+            "  | %3u-slot scan mean %6.1f ns  (%.3f vs %.3f timeouts/tick)\n",
+            NumArmed, (double) Wheel / Ticks,
+            Percentile(Samples, Ticks, 990, Overhead),
+            Percentile(Samples, Ticks, 999, Overhead),
+            ScanSlots, (double) Scan / Ticks,
+            (double) WheelFired / Ticks, (double) ScanFired / Ticks);
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static const uint16_t Armed[] = {10, 64, 256};
+    uint32_t Ticks = DEFAULT_TICKS;
+    uint32_t *Samples;
+    uint32_t Overhead;
+    uint8_t i;
+    int Failed;
+
+    if (argc > 1) {
+        Ticks = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    Samples = malloc(Ticks * sizeof (Samples[0]));
+    if ((Samples == NULL) || (Ticks == 0)) {
+        fprintf(stderr, "bench_timers: bad tick count\n");
+        return 1;
+    }
+
+    printf("bench_timers: %u timers, %u of them allocatable\n", ES_NUM_TIMERS, MAX_ARMED);
+    Failed = RunCheck();
+    Overhead = ClockOverheadNs();
+    for (i = 0; i < sizeof (Armed) / sizeof (Armed[0]); i++) {
+        if (Armed[i] <= MAX_ARMED) {
+            TimeTicks(Armed[i], Ticks, Samples, Overhead);
+        }
+    }
+    free(Samples);
+    return Failed;
+}
@@ -0,0 +1,211 @@
+/*
+ * File: hsmstats.c
+ *
+ * Prints a dump of the HSM timing statistics (HSMStats.h) taken off the
+ * robot's UART. The dump is HSMStats_t as it lay in the PIC32's RAM, which
+ * is laid out the same here. Each machine in it is matched by name with the
+ * one this build links, for its state and row names; for each state it has
+ * been in it prints how many stays it had, the time over them and the mean,
+ * and the stays in each dwell bin that has any, then the rows taken, and
+ * at the end how long RobotHSM took to run its events after they were
+ * posted.
+ *
+ * usage: hsmstats dump
+ *
+ * Created on 18/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "BOARD.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HSM.h"
+#include "HSMStats.h"
+#include "RobotHSM.h"
+#include "SubHSM_Destroy.h"
+#include "SubHSM_Escape.h"
+#include "SubHSM_Flank.h"
+#include "SubHSM_Lookout.h"
+#include "SubHSM_Pursue.h"
+#include "SubHSM_Search.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define NUM_EVENT_NAMES (sizeof (EventNames) / sizeof (EventNames[0]))
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static const HSM_Machine_t * const Machines[] = {
+    &RobotHSMMachine, &SubHSM_LookoutMachine, &SubHSM_SearchMachine, &SubHSM_PursueMachine,
+    &SubHSM_DestroyMachine, &SubHSM_EscapeMachine, &SubHSM_FlankMachine,
+};
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+/* the machine this build has by the name, if its states and rows are as many
+ * as the dump has */
+static const HSM_Machine_t *Known(const HSMStats_t *pStats, uint8_t Number)
+{
+    const HSMStatsMachine_t *pMachine = &pStats->Machines[Number];
+    uint32_t i, State, Rows;
+
+    for (i = 0; i < sizeof (Machines) / sizeof (Machines[0]); i++) {
+        if (strncmp(Machines[i]->Name, pMachine->Name, HSMSTATS_NAME_SIZE - 1) != 0) {
+            continue;
+        }
+        if (Machines[i]->NumStates != pMachine->NumStates) {
+            return NULL;
+        }
+        for (State = 0; State < pMachine->NumStates; State++) {
+            Rows = ((pMachine->FirstState + State + 1 < pStats->NumStates)
+                    ? pStats->FirstRow[pMachine->FirstState + State + 1] : pStats->NumRows)
+                    - pStats->FirstRow[pMachine->FirstState + State];
+            if (Machines[i]->States[State].NumRows != Rows) {
+                return NULL;
+            }
+        }
+        return Machines[i];
+    }
+    return NULL;
+}
+
+/* a time in core ticks, in the units that suit it */
+static const char *Time(double Ticks)
+{
+    static char Buffers[4][16];
+    static uint8_t Next;
+    char *pBuffer = Buffers[Next++ & 3];
+    double Us = Ticks / HSMSTATS_TICKS_PER_US;
+
+    if (Us < 1000) {
+        snprintf(pBuffer, sizeof (Buffers[0]), "%.1fus", Us);
+    } else if (Us < 1000000) {
+        snprintf(pBuffer, sizeof (Buffers[0]), "%.1fms", Us / 1000);
+    } else {
+        snprintf(pBuffer, sizeof (Buffers[0]), "%.1fs", Us / 1000000);
+    }
+    return pBuffer;
+}
+
+/* the bins with any counts, by where each starts */
+static void PrintBins(const uint16_t *pBins, uint8_t Shift)
+{
+    uint8_t i;
+
+    printf("     ");
+    for (i = 0; i < HSMSTATS_BINS; i++) {
+        if (pBins[i] == 0) {
+            continue;
+        }
+        if (i == 0) {
+            printf(" <%s:%u", Time(1UL << Shift), pBins[i]);
+        } else {
+            printf(" %s%s:%u", (i == HSMSTATS_BINS - 1) ? ">=" : "",
+                    Time((double) (1UL << (Shift + i - 1))), pBins[i]);
+        }
+    }
+    printf("\n");
+}
+
+static void PrintMachine(const HSMStats_t *pStats, uint8_t Number)
+{
+    const HSMStatsMachine_t *pMachine = &pStats->Machines[Number];
+    const HSM_Machine_t *pKnown = Known(pStats, Number);
+    const HSM_Transition_t *pRow;
+    uint32_t Stays, State, Slot, Row, i;
+    double Ticks;
+
+    printf("%s, %u states%s\n", pMachine->Name, pMachine->NumStates,
+            pKnown ? "" : ", not as this build has it: states and rows by number");
+    for (State = 0; State < pMachine->NumStates; State++) {
+        Slot = pMachine->FirstState + State;
+        Stays = 0;
+        for (i = 0; i < HSMSTATS_BINS; i++) {
+            Stays += pStats->Dwell[Slot][i];
+        }
+        if ((Stays == 0) && (pMachine->State != State)) {
+            continue;
+        }
+        Ticks = (double) pStats->Total[Slot] * (1 << HSMSTATS_TOTAL_SHIFT);
+        if (pKnown) {
+            printf("  %-14s", pKnown->States[State].Name);
+        } else {
+            printf("  state %-8u", State);
+        }
+        printf(" %5u stays %9s, mean %9s", Stays, Time(Ticks), Stays ? Time(Ticks / Stays) : "-");
+        if (pMachine->State == State) {
+            printf(", in it %s", Time((double) pMachine->Stayed * (1 << HSMSTATS_TOTAL_SHIFT)));
+        }
+        printf("\n");
+        if (Stays) {
+            PrintBins(pStats->Dwell[Slot], HSMSTATS_DWELL_SHIFT);
+        }
+        for (Row = pStats->FirstRow[Slot]; Row < ((Slot + 1 < pStats->NumStates)
+                ? pStats->FirstRow[Slot + 1] : pStats->NumRows); Row++) {
+            if (pStats->Taken[Row] == 0) {
+                continue;
+            }
+            if (pKnown) {
+                pRow = &pKnown->States[State].Rows[Row - pStats->FirstRow[Slot]];
+                printf("      %-16s -> %-12s %5u\n",
+                        (pRow->Event < NUM_EVENT_NAMES) ? EventNames[pRow->Event] : "?",
+                        (pRow->Target == HSM_INTERNAL) ? "(internal)"
+                        : pKnown->States[pRow->Target].Name, pStats->Taken[Row]);
+            } else {
+                printf("      row %-3u %5u\n", Row - pStats->FirstRow[Slot], pStats->Taken[Row]);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static HSMStats_t Stats;
+    FILE *pFile;
+    size_t Size = 0;
+    uint8_t i;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: hsmstats dump\n");
+        return 2;
+    }
+    pFile = fopen(argv[1], "rb");
+    if (pFile != NULL) {
+        Size = fread(&Stats, 1, sizeof (Stats), pFile);
+        fclose(pFile);
+    }
+    if ((Size != sizeof (Stats)) || memcmp(Stats.Magic, HSMSTATS_MAGIC, sizeof (Stats.Magic))
+            || (Stats.Version != HSMSTATS_VERSION) || (Stats.NumMachines > HSMSTATS_MAX_MACHINES)
+            || (Stats.NumStates > HSMSTATS_MAX_STATES) || (Stats.NumRows > HSMSTATS_MAX_ROWS)) {
+        fprintf(stderr, "hsmstats: %s is not a version %d dump\n", argv[1], HSMSTATS_VERSION);
+        return 2;
+    }
+    printf("hsmstats: %s, dumped at %u ms, %u machines", argv[1], Stats.DumpedMs,
+            Stats.NumMachines);
+    if (Stats.Lost) {
+        printf(", %u entries of machines there was no room for", Stats.Lost);
+    }
+    printf("\n");
+    for (i = 0; i < Stats.NumMachines; i++) {
+        PrintMachine(&Stats, i);
+    }
+    printf("RobotHSM latency, post to run, %u events, worst %s\n", Stats.Handled,
+            Time(Stats.WorstLatency));
+    PrintBins(Stats.Latency, HSMSTATS_LATENCY_SHIFT);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * File: pwm.c
+ *
+ * Simulated PWM module. Duty cycles are latched per channel; every call that
+ * would write an output-compare register is counted in SimStats.PWMWrites.
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include "BOARD.h"
+#include "pwm.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define PWM_ALL_PINS ((1 << PWM_NUM_CHANNELS) - 1)
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static unsigned int DutyCycles[PWM_NUM_CHANNELS];
+static unsigned short int ActivePins;
+static unsigned int Frequency;
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+char PWM_Init(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < PWM_NUM_CHANNELS; i++) {
+        DutyCycles[i] = 0;
+    }
+    ActivePins = 0;
+    Frequency = PWM_1KHZ;
+    return SUCCESS;
+}
+
+char PWM_SetFrequency(unsigned int NewFrequency)
+{
+    if ((NewFrequency != PWM_1KHZ) && (NewFrequency != PWM_2KHZ)
+            && (NewFrequency != PWM_5KHZ) && (NewFrequency != PWM_10KHZ)) {
+        return ERROR;
+    }
+    Frequency = NewFrequency;
+    return SUCCESS;
+}
+
+unsigned int PWM_GetFrequency(void)
+{
+    return Frequency;
+}
+
+char PWM_AddPins(unsigned short int AddPins)
+{
+    if (AddPins & ~PWM_ALL_PINS) {
+        return ERROR;
+    }
+    SimStats.PWMWrites++;
+    ActivePins |= AddPins;
+    return SUCCESS;
+}
+
+char PWM_RemovePins(unsigned short int RemovePins)
+{
+    if (RemovePins & ~PWM_ALL_PINS) {
+        return ERROR;
+    }
+    SimStats.PWMWrites++;
+    ActivePins &= ~RemovePins;
+    return SUCCESS;
+}
+
+unsigned short int PWM_ListPins(void)
+{
+    return ActivePins;
+}
+
+char PWM_SetDutyCycle(unsigned char Channel, unsigned int Duty)
+{
+    if ((Channel == 0) || (Channel & ~PWM_ALL_PINS) || (Channel & (Channel - 1))
+            || !(ActivePins & Channel) || (Duty > MAX_PWM)) {
+        return ERROR;
+    }
+    SimStats.PWMWrites++;
+    DutyCycles[__builtin_ctz(Channel)] = Duty;
+    return SUCCESS;
+}
+
+unsigned int PWM_GetDutyCycle(char Channel)
+{
+    if ((Channel == 0) || (Channel & ~PWM_ALL_PINS) || (Channel & (Channel - 1))) {
+        return (unsigned int) ERROR;
+    }
+    return DutyCycles[__builtin_ctz((unsigned char) Channel)];
+}
+
+char PWM_End(void)
+{
+    ActivePins = 0;
+    return SUCCESS;
+}
@@ -0,0 +1,99 @@
+/*
+ * File: pwm.h
+ *
+ * Host stand-in for the CMPE118 PWM library. Duty cycles are stored per
+ * channel and every register-level write is counted for the benchmarks.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef PWM_H
+#define PWM_H
+
+/*******************************************************************************
+ * PUBLIC #INCLUDES                                                            *
+ ******************************************************************************/
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * PUBLIC #DEFINES                                                             *
+ ******************************************************************************/
+
+#define PWM_PORTZ06 (1 << 0)
+#define PWM_PORTY12 (1 << 1)
+#define PWM_PORTY10 (1 << 2)
+#define PWM_PORTY04 (1 << 3)
+#define PWM_PORTX11 (1 << 4)
+
+#define PWM_NUM_CHANNELS 5
+
+#define MIN_PWM 0
+#define MAX_PWM 1000
+
+#define PWM_1KHZ 1000
+#define PWM_2KHZ 2000
+#define PWM_5KHZ 5000
+#define PWM_10KHZ 10000
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function PWM_Init(void)
+ * @param None
+ * @return SUCCESS or ERROR
+ * @brief Clears every channel and sets the default 1 kHz frequency. */
+char PWM_Init(void);
+
+/**
+ * @Function PWM_SetFrequency(unsigned int NewFrequency)
+ * @param NewFrequency - one of the PWM_xKHZ values
+ * @return SUCCESS or ERROR */
+char PWM_SetFrequency(unsigned int NewFrequency);
+
+/**
+ * @Function PWM_GetFrequency(void)
+ * @param None
+ * @return the current PWM frequency in Hz */
+unsigned int PWM_GetFrequency(void);
+
+/**
+ * @Function PWM_AddPins(unsigned short int AddPins)
+ * @param AddPins - OR'd list of PWM_PORTxxx pins to enable
+ * @return SUCCESS or ERROR */
+char PWM_AddPins(unsigned short int AddPins);
+
+/**
+ * @Function PWM_RemovePins(unsigned short int RemovePins)
+ * @param RemovePins - OR'd list of PWM_PORTxxx pins to disable
+ * @return SUCCESS or ERROR */
+char PWM_RemovePins(unsigned short int RemovePins);
+
+/**
+ * @Function PWM_ListPins(void)
+ * @param None
+ * @return the OR'd list of enabled pins */
+unsigned short int PWM_ListPins(void);
+
+/**
+ * @Function PWM_SetDutyCycle(unsigned char Channel, unsigned int Duty)
+ * @param Channel - a single PWM_PORTxxx pin
+ * @param Duty - duty cycle from MIN_PWM to MAX_PWM
+ * @return SUCCESS or ERROR */
+char PWM_SetDutyCycle(unsigned char Channel, unsigned int Duty);
+
+/**
+ * @Function PWM_GetDutyCycle(char Channel)
+ * @param Channel - a single PWM_PORTxxx pin
+ * @return the duty cycle, or ERROR */
+unsigned int PWM_GetDutyCycle(char Channel);
+
+/**
+ * @Function PWM_End(void)
+ * @param None
+ * @return SUCCESS */
+char PWM_End(void);
+
+#endif /* PWM_H */
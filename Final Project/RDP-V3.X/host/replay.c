@@ -0,0 +1,358 @@
+/*
+ * File: replay.c
+ *
+ * Plays a flight recording (Recorder.h) back through RobotSensors and
+ * RobotHSM. Every NewADSamples and BumperEdge RobotSensors ran in the
+ * recording is posted to it again at the same ms, NewADSamples from the
+ * event checker as ADAcquire posted it and BumperEdge from interrupt context
+ * as the change notification interrupt posted it, with the samples it read
+ * queued in ADReplay and the bumper masks it read put on the simulated
+ * bumper port, so the services see what they saw on the field and the timers
+ * run on the same clock. The replay is recorded as it goes and has to come
+ * out the same, byte for byte, as the recording; the first record where it
+ * does not is printed with the records around it.
+ *
+ * usage: replay [-p] recording
+ *   -p  print the recording, one record a line, before playing it
+ *
+ * Created on 17/Oct/2026
+ */
+
+/*******************************************************************************
+ * MODULE #INCLUDE                                                             *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BOARD.h"
+#include "AD.h"
+#include "ADReplay.h"
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "Recorder.h"
+#include "Robot.h"
+#include "Sim.h"
+
+/*******************************************************************************
+ * MODULE #DEFINES                                                             *
+ ******************************************************************************/
+
+#define ROBOT_SENSORS_SERVICE 1
+#define HEADER_SIZE (sizeof (RECORDER_MAGIC) - 1 + 1)
+#define MAX_RECORDING (16 * 1024 * 1024)
+#define CONTEXT 3 // records printed either side of a difference
+#define NUM_EVENT_NAMES (sizeof (EventNames) / sizeof (EventNames[0]))
+
+/*******************************************************************************
+ * PRIVATE TYPEDEFS                                                            *
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t Offset; // of the tag in the stream
+    uint32_t Time;
+    uint8_t Type;
+    uint8_t Arg;
+    uint32_t Value; // absolute sample, event type, state or gap
+    uint16_t Param; // event param
+    const char *Name; // of a REC_MACHINE
+} Record_t;
+
+typedef struct {
+    const uint8_t *pBytes;
+    uint32_t Size;
+    Record_t *Records;
+    uint32_t NumRecords;
+    uint32_t Gaps;
+} Recording_t;
+
+/*******************************************************************************
+ * PRIVATE MODULE VARIABLES                                                    *
+ ******************************************************************************/
+
+static Recording_t Recorded, Replayed;
+static uint8_t *ReplayBytes;
+static uint32_t ReplaySize;
+static uint32_t Next; // next record of Recorded to play
+
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                           *
+ ******************************************************************************/
+
+static uint8_t GetVarint(const uint8_t *pBytes, uint32_t Size, uint32_t *pAt, uint32_t *pValue)
+{
+    uint32_t Value = 0;
+    uint8_t Shift;
+
+    for (Shift = 0; Shift < 35; Shift += 7) {
+        if (*pAt >= Size) {
+            return FALSE;
+        }
+        Value |= (uint32_t) (pBytes[*pAt] & 0x7F) << Shift;
+        if ((pBytes[(*pAt)++] & 0x80) == 0) {
+            *pValue = Value;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* splits a stream into records, undoing the differences; a record cut off at
+ * the end of the stream is left out */
+static uint8_t Decode(const uint8_t *pBytes, uint32_t Size, Recording_t *pRecording)
+{
+    uint16_t LastAD[AD_NUM_PINS] = {0};
+    uint32_t Time = 0, At = HEADER_SIZE, Value, Param;
+    Record_t Record;
+    uint8_t Complete;
+
+    pRecording->pBytes = pBytes;
+    pRecording->Size = Size;
+    pRecording->NumRecords = 0;
+    pRecording->Gaps = 0;
+    pRecording->Records = malloc((Size + 1) * sizeof (Record_t));
+    if ((Size < HEADER_SIZE) || memcmp(pBytes, RECORDER_MAGIC, HEADER_SIZE - 1)
+            || (pBytes[HEADER_SIZE - 1] != RECORDER_VERSION)) {
+        return FALSE;
+    }
+    while (At < Size) {
+        Record = (Record_t) {At, Time, REC_TYPE(pBytes[At]), REC_ARG(pBytes[At])};
+        At++;
+        Complete = TRUE;
+        switch (Record.Type) {
+        case REC_TIME:
+            Value = Record.Arg;
+            if (Record.Arg == REC_LONG_TIME) {
+                Complete = GetVarint(pBytes, Size, &At, &Value);
+                Value += REC_LONG_TIME;
+            }
+            Time += Value;
+            Record.Time = Time;
+            Record.Value = Value;
+            break;
+        case REC_AD:
+            if (Record.Arg >= AD_NUM_PINS) {
+                return FALSE;
+            }
+            Complete = GetVarint(pBytes, Size, &At, &Value);
+            LastAD[Record.Arg] += (uint16_t) ((Value >> 1) ^ -(Value & 1));
+            Record.Value = LastAD[Record.Arg];
+            break;
+        case REC_BUMPERS:
+            Record.Value = Record.Arg;
+            break;
+        case REC_EVENT:
+            Complete = GetVarint(pBytes, Size, &At, &Value)
+                    && GetVarint(pBytes, Size, &At, &Param);
+            Record.Value = Value;
+            Record.Param = Param;
+            break;
+        case REC_STATE:
+        case REC_GAP:
+            Complete = GetVarint(pBytes, Size, &At, &Value);
+            Record.Value = Value;
+            pRecording->Gaps += (Record.Type == REC_GAP);
+            break;
+        case REC_MACHINE:
+            Record.Name = (const char *) &pBytes[At];
+            while ((At < Size) && pBytes[At]) {
+                At++;
+            }
+            Complete = (At++ < Size);
+            break;
+        default:
+            return FALSE;
+        }
+        if (!Complete) {
+            break;
+        }
+        pRecording->Records[pRecording->NumRecords++] = Record;
+    }
+    return TRUE;
+}
+
+static const char *MachineName(const Recording_t *pRecording, uint8_t Number)
+{
+    uint32_t i;
+
+    for (i = 0; i < pRecording->NumRecords; i++) {
+        if ((pRecording->Records[i].Type == REC_MACHINE) && (pRecording->Records[i].Arg == Number)) {
+            return pRecording->Records[i].Name;
+        }
+    }
+    return "?";
+}
+
+static void PrintRecord(const Recording_t *pRecording, uint32_t Index)
+{
+    const Record_t *pRecord = &pRecording->Records[Index];
+
+    printf("  %7u  %8u ms  ", pRecord->Offset, pRecord->Time);
+    switch (pRecord->Type) {
+    case REC_TIME:
+        printf("time   +%u\n", pRecord->Value);
+        break;
+    case REC_AD:
+        printf("ad     pin %u = %u\n", pRecord->Arg, pRecord->Value);
+        break;
+    case REC_BUMPERS:
+        printf("bump   0x%02x\n", pRecord->Value);
+        break;
+    case REC_EVENT:
+        printf("event  service %u %s 0x%04x\n", pRecord->Arg,
+                (pRecord->Value < NUM_EVENT_NAMES) ? EventNames[pRecord->Value] : "?",
+                pRecord->Param);
+        break;
+    case REC_STATE:
+        printf("state  %s %u\n", MachineName(pRecording, pRecord->Arg), pRecord->Value);
+        break;
+    case REC_MACHINE:
+        printf("hsm    %u %s\n", pRecord->Arg, pRecord->Name);
+        break;
+    case REC_GAP:
+        printf("gap    %u records dropped\n", pRecord->Value);
+        break;
+    }
+}
+
+static void PrintAround(const Recording_t *pRecording, uint32_t Index)
+{
+    uint32_t i = (Index > CONTEXT) ? Index - CONTEXT : 0;
+
+    for (; (i <= Index + CONTEXT) && (i < pRecording->NumRecords); i++) {
+        PrintRecord(pRecording, i);
+    }
+}
+
+/* the posts to RobotSensors due this ms, with the samples and
+ * bumper masks it read; the port only changes at the start of a ms, so every
+ * mask read in the ms can be put on it now */
+static void Play(uint32_t Now)
+{
+    const Record_t *pRecord;
+    ES_Event ThisEvent;
+
+    for (; Next < Recorded.NumRecords; Next++) {
+        pRecord = &Recorded.Records[Next];
+        if (pRecord->Time > Now) {
+            return;
+        }
+        if (pRecord->Type == REC_AD) {
+            ADReplay_Push(1 << pRecord->Arg, pRecord->Value);
+        } else if (pRecord->Type == REC_BUMPERS) {
+            Sim_SetBumpers(pRecord->Value);
+        } else if ((pRecord->Type == REC_EVENT) && (pRecord->Arg == ROBOT_SENSORS_SERVICE)
+                && ((pRecord->Value == NewADSamples) || (pRecord->Value == BumperEdge))) {
+            ThisEvent.EventType = pRecord->Value;
+            ThisEvent.EventParam = pRecord->Param;
+            if (ThisEvent.EventType == NewADSamples) {
+                ADReplay_Post(ThisEvent);
+            } else {
+                ES_ISR_Enter();
+                ES_PostToService(ROBOT_SENSORS_SERVICE, ThisEvent);
+                ES_ISR_Exit();
+            }
+        }
+    }
+}
+
+static void Collect(char ch)
+{
+    ReplayBytes[ReplaySize++] = (uint8_t) ch;
+}
+
+static uint8_t *ReadFile(const char *pPath, uint32_t *pSize)
+{
+    FILE *pFile = fopen(pPath, "rb");
+    uint8_t *pBytes;
+
+    if (pFile == NULL) {
+        return NULL;
+    }
+    pBytes = malloc(MAX_RECORDING);
+    *pSize = fread(pBytes, 1, MAX_RECORDING, pFile);
+    fclose(pFile);
+    return pBytes;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS                                                            *
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    uint8_t *pRecording;
+    uint32_t Size, End, Compared = HEADER_SIZE, i;
+    uint8_t Print = FALSE;
+
+    if ((argc > 2) && (strcmp(argv[1], "-p") == 0)) {
+        Print = TRUE;
+        argv++;
+        argc--;
+    }
+    if (argc != 2) {
+        fprintf(stderr, "usage: replay [-p] recording\n");
+        return 2;
+    }
+    pRecording = ReadFile(argv[1], &Size);
+    if ((pRecording == NULL) || (Decode(pRecording, Size, &Recorded) == FALSE)) {
+        fprintf(stderr, "replay: %s is not a version %d recording\n", argv[1], RECORDER_VERSION);
+        return 2;
+    }
+    if (Print) {
+        for (i = 0; i < Recorded.NumRecords; i++) {
+            PrintRecord(&Recorded, i);
+        }
+    }
+    End = Recorded.NumRecords ? Recorded.Records[Recorded.NumRecords - 1].Time : 0;
+    printf("replay: %s, %u records in %u ms\n", argv[1], Recorded.NumRecords, End);
+    if (Recorded.Gaps) {
+        printf("  the recording has %u gaps, the replay will part from it at the first\n",
+                Recorded.Gaps);
+    }
+
+    // as the robot was: recording from before the services start
+    ReplayBytes = malloc(MAX_RECORDING);
+    ReplaySize = 0;
+    Next = 0;
+    ADReplay_Clear();
+    Recorder_Start();
+    if (Sim_Init() != SUCCESS) {
+        fprintf(stderr, "replay: Sim_Init failed\n");
+        return 2;
+    }
+    // the bumper edges come from the recording, not the port
+    Sim_SetBumperHook((SimBumperHook_t) 0);
+    Sim_SetSerialSink(Collect);
+    Sim_SetTickHook(Play);
+    while (ES_Timer_GetTime() < End) {
+        Sim_Tick();
+        Sim_Drain();
+    }
+    Recorder_Stop();
+    ReplaySize += Recorder_Read(&ReplayBytes[ReplaySize], MAX_RECORDING - ReplaySize);
+    Decode(ReplayBytes, ReplaySize, &Replayed);
+
+    for (i = 0; (i < Recorded.NumRecords) && (i < Replayed.NumRecords); i++) {
+        const Record_t *pA = &Recorded.Records[i], *pB = &Replayed.Records[i];
+        uint32_t Length = ((i + 1 < Recorded.NumRecords) ? Recorded.Records[i + 1].Offset
+                : Recorded.Size) - pA->Offset;
+
+        if ((pA->Offset != pB->Offset) || (pB->Offset + Length > Replayed.Size)
+                || memcmp(&Recorded.pBytes[pA->Offset], &Replayed.pBytes[pB->Offset], Length)) {
+            printf("  FAILED: record %u differs\n  recorded:\n", i);
+            PrintAround(&Recorded, i);
+            printf("  replayed:\n");
+            PrintAround(&Replayed, i);
+            return 1;
+        }
+        Compared = pA->Offset + Length;
+    }
+    if (Replayed.NumRecords < Recorded.NumRecords) {
+        printf("  FAILED: the replay stopped after %u records\n", Replayed.NumRecords);
+        return 1;
+    }
+    printf("  replayed %u bytes the same as recorded\n", Compared);
+    return 0;
+}
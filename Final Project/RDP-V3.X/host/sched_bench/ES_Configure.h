@@ -0,0 +1,214 @@
+/*
+ * File: ES_Configure.h
+ *
+ * Framework configuration for bench_sched only. Every service slot runs the
+ * same do-nothing service so the ES_Framework scheduler can be built and
+ * timed at any size; BENCH_NUM_SERVICES comes from the Makefile.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef CONFIGURE_H
+#define CONFIGURE_H
+
+typedef enum {
+    ES_NO_EVENT = 0,
+    ES_ERROR,
+    ES_INIT,
+    ES_ENTRY,
+    ES_EXIT,
+    ES_KEYINPUT,
+    ES_LISTEVENTS,
+    ES_TIMEOUT,
+    ES_TIMERACTIVE,
+    ES_TIMERSTOPPED,
+    BENCH_EVENT,
+    NUMBEROFEVENTS,
+} ES_EventTyp_t;
+
+#define EVENT_CHECK_HEADER "ES_Configure.h"
+#define EVENT_CHECK_LIST
+
+#define TIMER_UNUSED ((pPostFunc)0)
+#define TIMER0_RESP_FUNC TIMER_UNUSED
+#define TIMER1_RESP_FUNC TIMER_UNUSED
+#define TIMER2_RESP_FUNC TIMER_UNUSED
+#define TIMER3_RESP_FUNC TIMER_UNUSED
+#define TIMER4_RESP_FUNC TIMER_UNUSED
+#define TIMER5_RESP_FUNC TIMER_UNUSED
+#define TIMER6_RESP_FUNC TIMER_UNUSED
+#define TIMER7_RESP_FUNC TIMER_UNUSED
+#define TIMER8_RESP_FUNC TIMER_UNUSED
+#define TIMER9_RESP_FUNC TIMER_UNUSED
+#define TIMER10_RESP_FUNC TIMER_UNUSED
+#define TIMER11_RESP_FUNC TIMER_UNUSED
+#define TIMER12_RESP_FUNC TIMER_UNUSED
+#define TIMER13_RESP_FUNC TIMER_UNUSED
+#define TIMER14_RESP_FUNC TIMER_UNUSED
+#define TIMER15_RESP_FUNC TIMER_UNUSED
+
+#define MAX_NUM_SERVICES 32
+#define NUM_SERVICES BENCH_NUM_SERVICES
+#define ES_ISR_RING_SIZE 16
+
+#define SERV_0_HEADER "SchedBench.h"
+#define SERV_0_INIT InitSchedBench
+#define SERV_0_RUN RunSchedBench
+#define SERV_0_QUEUE_SIZE 3
+
+#define SERV_1_HEADER "SchedBench.h"
+#define SERV_1_INIT InitSchedBench
+#define SERV_1_RUN RunSchedBench
+#define SERV_1_QUEUE_SIZE 3
+
+#define SERV_2_HEADER "SchedBench.h"
+#define SERV_2_INIT InitSchedBench
+#define SERV_2_RUN RunSchedBench
+#define SERV_2_QUEUE_SIZE 3
+
+#define SERV_3_HEADER "SchedBench.h"
+#define SERV_3_INIT InitSchedBench
+#define SERV_3_RUN RunSchedBench
+#define SERV_3_QUEUE_SIZE 3
+
+#define SERV_4_HEADER "SchedBench.h"
+#define SERV_4_INIT InitSchedBench
+#define SERV_4_RUN RunSchedBench
+#define SERV_4_QUEUE_SIZE 3
+
+#define SERV_5_HEADER "SchedBench.h"
+#define SERV_5_INIT InitSchedBench
+#define SERV_5_RUN RunSchedBench
+#define SERV_5_QUEUE_SIZE 3
+
+#define SERV_6_HEADER "SchedBench.h"
+#define SERV_6_INIT InitSchedBench
+#define SERV_6_RUN RunSchedBench
+#define SERV_6_QUEUE_SIZE 3
+
+#define SERV_7_HEADER "SchedBench.h"
+#define SERV_7_INIT InitSchedBench
+#define SERV_7_RUN RunSchedBench
+#define SERV_7_QUEUE_SIZE 3
+
+#define SERV_8_HEADER "SchedBench.h"
+#define SERV_8_INIT InitSchedBench
+#define SERV_8_RUN RunSchedBench
+#define SERV_8_QUEUE_SIZE 3
+
+#define SERV_9_HEADER "SchedBench.h"
+#define SERV_9_INIT InitSchedBench
+#define SERV_9_RUN RunSchedBench
+#define SERV_9_QUEUE_SIZE 3
+
+#define SERV_10_HEADER "SchedBench.h"
+#define SERV_10_INIT InitSchedBench
+#define SERV_10_RUN RunSchedBench
+#define SERV_10_QUEUE_SIZE 3
+
+#define SERV_11_HEADER "SchedBench.h"
+#define SERV_11_INIT InitSchedBench
+#define SERV_11_RUN RunSchedBench
+#define SERV_11_QUEUE_SIZE 3
+
+#define SERV_12_HEADER "SchedBench.h"
+#define SERV_12_INIT InitSchedBench
+#define SERV_12_RUN RunSchedBench
+#define SERV_12_QUEUE_SIZE 3
+
+#define SERV_13_HEADER "SchedBench.h"
+#define SERV_13_INIT InitSchedBench
+#define SERV_13_RUN RunSchedBench
+#define SERV_13_QUEUE_SIZE 3
+
+#define SERV_14_HEADER "SchedBench.h"
+#define SERV_14_INIT InitSchedBench
+#define SERV_14_RUN RunSchedBench
+#define SERV_14_QUEUE_SIZE 3
+
+#define SERV_15_HEADER "SchedBench.h"
+#define SERV_15_INIT InitSchedBench
+#define SERV_15_RUN RunSchedBench
+#define SERV_15_QUEUE_SIZE 3
+
+#define SERV_16_HEADER "SchedBench.h"
+#define SERV_16_INIT InitSchedBench
+#define SERV_16_RUN RunSchedBench
+#define SERV_16_QUEUE_SIZE 3
+
+#define SERV_17_HEADER "SchedBench.h"
+#define SERV_17_INIT InitSchedBench
+#define SERV_17_RUN RunSchedBench
+#define SERV_17_QUEUE_SIZE 3
+
+#define SERV_18_HEADER "SchedBench.h"
+#define SERV_18_INIT InitSchedBench
+#define SERV_18_RUN RunSchedBench
+#define SERV_18_QUEUE_SIZE 3
+
+#define SERV_19_HEADER "SchedBench.h"
+#define SERV_19_INIT InitSchedBench
+#define SERV_19_RUN RunSchedBench
+#define SERV_19_QUEUE_SIZE 3
+
+#define SERV_20_HEADER "SchedBench.h"
+#define SERV_20_INIT InitSchedBench
+#define SERV_20_RUN RunSchedBench
+#define SERV_20_QUEUE_SIZE 3
+
+#define SERV_21_HEADER "SchedBench.h"
+#define SERV_21_INIT InitSchedBench
+#define SERV_21_RUN RunSchedBench
+#define SERV_21_QUEUE_SIZE 3
+
+#define SERV_22_HEADER "SchedBench.h"
+#define SERV_22_INIT InitSchedBench
+#define SERV_22_RUN RunSchedBench
+#define SERV_22_QUEUE_SIZE 3
+
+#define SERV_23_HEADER "SchedBench.h"
+#define SERV_23_INIT InitSchedBench
+#define SERV_23_RUN RunSchedBench
+#define SERV_23_QUEUE_SIZE 3
+
+#define SERV_24_HEADER "SchedBench.h"
+#define SERV_24_INIT InitSchedBench
+#define SERV_24_RUN RunSchedBench
+#define SERV_24_QUEUE_SIZE 3
+
+#define SERV_25_HEADER "SchedBench.h"
+#define SERV_25_INIT InitSchedBench
+#define SERV_25_RUN RunSchedBench
+#define SERV_25_QUEUE_SIZE 3
+
+#define SERV_26_HEADER "SchedBench.h"
+#define SERV_26_INIT InitSchedBench
+#define SERV_26_RUN RunSchedBench
+#define SERV_26_QUEUE_SIZE 3
+
+#define SERV_27_HEADER "SchedBench.h"
+#define SERV_27_INIT InitSchedBench
+#define SERV_27_RUN RunSchedBench
+#define SERV_27_QUEUE_SIZE 3
+
+#define SERV_28_HEADER "SchedBench.h"
+#define SERV_28_INIT InitSchedBench
+#define SERV_28_RUN RunSchedBench
+#define SERV_28_QUEUE_SIZE 3
+
+#define SERV_29_HEADER "SchedBench.h"
+#define SERV_29_INIT InitSchedBench
+#define SERV_29_RUN RunSchedBench
+#define SERV_29_QUEUE_SIZE 3
+
+#define SERV_30_HEADER "SchedBench.h"
+#define SERV_30_INIT InitSchedBench
+#define SERV_30_RUN RunSchedBench
+#define SERV_30_QUEUE_SIZE 3
+
+#define SERV_31_HEADER "SchedBench.h"
+#define SERV_31_INIT InitSchedBench
+#define SERV_31_RUN RunSchedBench
+#define SERV_31_QUEUE_SIZE 3
+
+#endif /* CONFIGURE_H */
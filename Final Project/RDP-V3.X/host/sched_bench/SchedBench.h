@@ -0,0 +1,17 @@
+/*
+ * File: SchedBench.h
+ *
+ * Do-nothing service used in every slot of the bench_sched configuration.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SCHEDBENCH_H
+#define SCHEDBENCH_H
+
+#include "ES_Events.h"
+
+uint8_t InitSchedBench(uint8_t Priority);
+ES_Event RunSchedBench(ES_Event ThisEvent);
+
+#endif /* SCHEDBENCH_H */
@@ -0,0 +1,37 @@
+/*
+ * File: serial.c
+ *
+ * Host stand-in for the CMPE118 serial library.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#include <stdio.h>
+#include "BOARD.h"
+#include "serial.h"
+#include "Sim.h"
+
+static SimSerialSink_t Sink;
+
+void SERIAL_Init(void)
+{
+}
+
+void Sim_SetSerialSink(SimSerialSink_t NewSink)
+{
+    Sink = NewSink;
+}
+
+void PutChar(char ch)
+{
+    if (Sink) {
+        Sink(ch);
+    } else {
+        putchar(ch);
+    }
+}
+
+char IsTransmitEmpty(void)
+{
+    return TRUE;
+}
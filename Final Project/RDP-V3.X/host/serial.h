@@ -0,0 +1,37 @@
+/*
+ * File: serial.h
+ *
+ * Host stand-in for the CMPE118 serial library. On the host build stdout is
+ * the serial port, or the sink set with Sim_SetSerialSink(), so transmit is
+ * always ready.
+ *
+ * Created on 17/Oct/2026
+ */
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+/*******************************************************************************
+ * PUBLIC FUNCTION PROTOTYPES                                                  *
+ ******************************************************************************/
+
+/**
+ * @Function SERIAL_Init(void)
+ * @param None
+ * @return None
+ * @brief No-op on the host, stdout is used directly. */
+void SERIAL_Init(void);
+
+/**
+ * @Function PutChar(char ch)
+ * @param ch - byte to transmit
+ * @return None */
+void PutChar(char ch);
+
+/**
+ * @Function IsTransmitEmpty(void)
+ * @param None
+ * @return TRUE, the host never blocks on the UART */
+char IsTransmitEmpty(void);
+
+#endif /* SERIAL_H */
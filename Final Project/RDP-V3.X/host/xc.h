@@ -0,0 +1,24 @@
+/*
+ * File: xc.h
+ *
+ * Host stand-in for the XC32 device header, for the little the project
+ * sources take from it. The PIC32 core timer counts at half the system
+ * clock; here it is worked out from the virtual ms clock, so it steps 40000
+ * ticks at each ms and wraps, as the real one does, every 107 s. A test can
+ * move it on between ms with Sim_AddCoreTicks().
+ *
+ * Created on 18/Oct/2026
+ */
+
+#ifndef XC_H
+#define XC_H
+
+#include "BOARD.h"
+#include "ES_Timers.h"
+
+extern unsigned int SimCoreSkew; // ticks added by Sim_AddCoreTicks()
+
+#define _CP0_GET_COUNT() ((unsigned int) (ES_Timer_GetTime() * (BOARD_SYS_CLOCK / 2000)) \
+        + SimCoreSkew)
+
+#endif /* XC_H */